@@ -32,6 +32,7 @@
 #include "SourceGroupFactoryModuleCustom.h"
 #include "type/indexing/MessageIndexingInterrupted.h"
 #include "type/MessageLoadProject.h"
+#include "type/MessageQuitApplication.h"
 #include "type/MessageStatus.h"
 #include "utilityApp.h"
 #include "utilityQt.h"
@@ -48,6 +49,12 @@ void signalHandler(int /*signum*/) {
   MessageIndexingInterrupted().dispatch();
 }
 
+void daemonSignalHandler(int /*signum*/) {
+  std::cout << "stopping daemon\n";
+  MessageIndexingInterrupted().dispatch();
+  MessageQuitApplication().dispatch();
+}
+
 void setupLogging() {
   std::vector<spdlog::sink_ptr> sinkList;
 
@@ -125,6 +132,19 @@ int runConsole(int argc, char** argv, const Version& version, commandline::Comma
   if(commandLineParser.hasError()) {
     std::wcout << commandLineParser.getError() << std::endl;
   } else {
+    if(commandLineParser.runAsDaemon()) {
+      const QtNetworkFactory networkFactory;
+      if(commandLineParser.getDaemonSocketPath().empty() ||
+         !Application::getInstance()->startDaemon(networkFactory, commandLineParser.getDaemonSocketPath())) {
+        std::cerr << "ERROR: Unable to listen for requests, see the log for details" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // the daemon only ends on request, interrupting the indexing is done with the "interrupt" request
+      std::signal(SIGINT, daemonSignalHandler);
+      std::signal(SIGTERM, daemonSignalHandler);
+    }
+
     MessageLoadProject(commandLineParser.getProjectFilePath(),
                        false,
                        commandLineParser.getRefreshMode(),
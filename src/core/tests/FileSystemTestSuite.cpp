@@ -1,11 +1,14 @@
 #include <algorithm>
 #include <any>
+#include <filesystem>
+#include <fstream>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "FilePathPool.h"
 #include "FileSystem.h"
 #include "utility.h"
 
@@ -29,8 +32,95 @@ namespace {
                        return wPath == wFileName || wPath == wFileName2;
                      });
 }
+// creates a source tree in the temp directory and removes it again when going out of scope
+class TemporarySourceTree {
+public:
+  TemporarySourceTree() : m_root(std::filesystem::temp_directory_path() / "sourcetrail_file_system_test") {
+    std::filesystem::remove_all(m_root);
+    for(const char* file : {"main.cpp", "a/a.cpp", "a/a.h", "a/b/b.CPP", "a/b/c/c.txt", "d/d.cpp"}) {
+      std::filesystem::create_directories((m_root / file).parent_path());
+      std::ofstream(m_root / file) << "int i;";
+    }
+  }
+
+  ~TemporarySourceTree() {
+    std::error_code error;
+    std::filesystem::remove_all(m_root, error);
+  }
+
+  TemporarySourceTree(const TemporarySourceTree&) = delete;
+  TemporarySourceTree& operator=(const TemporarySourceTree&) = delete;
+
+  [[nodiscard]] FilePath getPath(const std::string& relativePath = "") const {
+    return FilePath((m_root / relativePath).wstring()).getCanonical();
+  }
+
+private:
+  const std::filesystem::path m_root;
+};
+
+std::vector<std::wstring> getFileNames(const std::vector<FileInfo>& infos) {
+  std::vector<std::wstring> names;
+  for(const FileInfo& info : infos) {
+    names.push_back(info.path.fileName());
+  }
+  return names;
+}
 }    // namespace
 
+TEST(FileSystem, findFileInfosInTemporaryTree) {
+  const TemporarySourceTree tree;
+
+  const std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths({tree.getPath()}, {L".cpp", L".h"}, false);
+
+  EXPECT_EQ(std::vector<std::wstring>({L"a.cpp", L"a.h", L"b.CPP", L"d.cpp", L"main.cpp"}), getFileNames(files));
+  for(const FileInfo& info : files) {
+    EXPECT_EQ(info.path, info.path.getCanonical());
+    EXPECT_TRUE(info.lastWriteTime.isValid());
+  }
+}
+
+TEST(FileSystem, findFileInfosDeduplicatesDirectoriesAndFiles) {
+  const TemporarySourceTree tree;
+
+  const std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths(
+      {tree.getPath("a"), tree.getPath(), tree.getPath("main.cpp")}, {L".cpp"}, false);
+
+  EXPECT_EQ(std::vector<std::wstring>({L"a.cpp", L"b.CPP", L"d.cpp", L"main.cpp"}), getFileNames(files));
+}
+
+#ifndef _WIN32
+TEST(FileSystem, findFileInfosFollowsDirectorySymlinksOnce) {
+  const TemporarySourceTree tree;
+  std::filesystem::create_directory_symlink(tree.getPath("a/b").wstr(), tree.getPath("d").wstr() + L"/linked_b");
+  std::filesystem::create_directory_symlink(tree.getPath().wstr(), tree.getPath("d").wstr() + L"/linked_root");
+
+  EXPECT_EQ(5, FileSystem::getFileInfosFromPaths({tree.getPath()}, {L".cpp", L".h"}, true).size());
+  EXPECT_EQ(1, FileSystem::getFileInfosFromPaths({tree.getPath("d")}, {L".cpp", L".h"}, false).size());
+  EXPECT_EQ(5, FileSystem::getFileInfosFromPaths({tree.getPath("d")}, {L".cpp", L".h"}, true).size());
+}
+#endif
+
+TEST(FileSystem, statusCacheKeepsResultsOfScanUntilScopeEnds) {
+  const TemporarySourceTree tree;
+  const FilePath filePath = tree.getPath("a/a.cpp");
+
+  {
+    const ScopedFileStatusCache statusCache;
+    EXPECT_TRUE(ScopedFileStatusCache::isActive());
+
+    const std::vector<FileInfo> files = FileSystem::getFileInfosFromPaths({tree.getPath("a")}, {L".cpp"}, false);
+    ASSERT_EQ(2, files.size());
+
+    std::filesystem::remove(filePath.wstr());
+    EXPECT_TRUE(FileSystem::exists(filePath));
+    EXPECT_EQ(files.front().lastWriteTime, FileSystem::getFileInfoForPath(filePath).lastWriteTime);
+  }
+
+  EXPECT_FALSE(ScopedFileStatusCache::isActive());
+  EXPECT_FALSE(FileSystem::exists(FilePath(filePath.wstr())));
+}
+
 TEST(FileSystem, findCppFiles) {
   std::vector<std::wstring> cppFiles = utility::convert<FilePath, std::wstring>(
       FileSystem::getFilePathsFromDirectory(FilePath(L"data/FileSystemTestSuite"), {L".cpp"}),
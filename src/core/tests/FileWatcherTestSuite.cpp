@@ -0,0 +1,222 @@
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "FileWatcher.h"
+
+namespace {
+constexpr std::chrono::milliseconds SettleTime(100);
+constexpr std::chrono::seconds Timeout(5);
+
+// a new temp directory with one source file, removed again when going out of scope
+class TemporaryDirectory {
+public:
+  TemporaryDirectory() : m_root(createUniqueDirectory()) {
+    write("main.cpp");
+  }
+
+  ~TemporaryDirectory() {
+    std::error_code error;
+    std::filesystem::remove_all(m_root, error);
+  }
+
+  TemporaryDirectory(const TemporaryDirectory&) = delete;
+  TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+  void write(const std::string& relativePath) const {
+    std::filesystem::create_directories((m_root / relativePath).parent_path());
+    std::ofstream(m_root / relativePath) << "int i;";
+  }
+
+  [[nodiscard]] FilePath getPath(const std::string& relativePath = "") const {
+    return FilePath((m_root / relativePath).wstring());
+  }
+
+private:
+  // tests may run in parallel, so each one gets its own directory
+  static std::filesystem::path createUniqueDirectory() {
+    std::random_device random;
+    std::mt19937 generator(random());
+
+    std::filesystem::path path;
+    do {
+      path = std::filesystem::temp_directory_path() / ("sourcetrail_file_watcher_test_" + std::to_string(generator()));
+    } while(!std::filesystem::create_directory(path));
+    return path;
+  }
+
+  const std::filesystem::path m_root;
+};
+
+// counts the notifications of a watcher and waits for them
+class ChangeCounter {
+public:
+  FileWatcher::ChangeCallback getCallback() {
+    return [this]() {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_count++;
+      m_condition.notify_all();
+    };
+  }
+
+  bool waitForCount(int count) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_condition.wait_for(lock, Timeout, [this, count]() { return m_count >= count; });
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  int m_count = 0;
+};
+}    // namespace
+
+TEST(FileWatcher, reportsModifiedAndCreatedFiles) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath()});
+  EXPECT_EQ(1, watcher.getWatchedDirectoryCount());
+
+  directory.write("main.cpp");
+  directory.write("added.h");
+  ASSERT_TRUE(counter.waitForCount(1));
+
+  EXPECT_TRUE(watcher.hasChanges());
+  const FileChanges changes = watcher.consumeChanges();
+  EXPECT_FALSE(changes.overflowed);
+  EXPECT_EQ(std::set<FilePath>({directory.getPath("added.h"), directory.getPath("main.cpp")}), changes.filePaths);
+  EXPECT_FALSE(watcher.hasChanges());
+}
+
+TEST(FileWatcher, reportsRemovedFiles) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath()});
+
+  std::filesystem::remove(directory.getPath("main.cpp").wstr());
+  ASSERT_TRUE(counter.waitForCount(1));
+
+  EXPECT_EQ(std::set<FilePath>({directory.getPath("main.cpp")}), watcher.consumeChanges().filePaths);
+}
+
+TEST(FileWatcher, watchesCreatedSubdirectories) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath()});
+
+  directory.write("sub/first.cpp");
+  ASSERT_TRUE(counter.waitForCount(1));
+  EXPECT_EQ(2, watcher.getWatchedDirectoryCount());
+  EXPECT_EQ(1, watcher.consumeChanges().filePaths.count(directory.getPath("sub/first.cpp")));
+
+  directory.write("sub/second.cpp");
+  ASSERT_TRUE(counter.waitForCount(2));
+  EXPECT_EQ(std::set<FilePath>({directory.getPath("sub/second.cpp")}), watcher.consumeChanges().filePaths);
+}
+
+TEST(FileWatcher, followsRenamedSubdirectories) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  directory.write("sub/first.cpp");
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath(), directory.getPath("sub")});
+
+  std::filesystem::rename(directory.getPath("sub").wstr(), directory.getPath("renamed").wstr());
+  ASSERT_TRUE(counter.waitForCount(1));
+  EXPECT_TRUE(watcher.consumeChanges().overflowed);
+  EXPECT_EQ(2, watcher.getWatchedDirectoryCount());
+
+  directory.write("renamed/second.cpp");
+  ASSERT_TRUE(counter.waitForCount(2));
+  EXPECT_EQ(std::set<FilePath>({directory.getPath("renamed/second.cpp")}), watcher.consumeChanges().filePaths);
+}
+
+TEST(FileWatcher, stopsWatchingMovedDirectories) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  const TemporaryDirectory otherDirectory;
+  directory.write("sub/first.cpp");
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath("sub")});
+
+  std::filesystem::rename(directory.getPath("sub").wstr(), otherDirectory.getPath("sub").wstr());
+  ASSERT_TRUE(counter.waitForCount(1));
+  EXPECT_TRUE(watcher.consumeChanges().overflowed);
+  EXPECT_EQ(0, watcher.getWatchedDirectoryCount());
+}
+
+TEST(FileWatcher, changesInQuickSuccessionAreAllReported) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  ChangeCounter counter;
+  FileWatcher watcher(counter.getCallback(), SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath()});
+
+  std::set<FilePath> expectedFilePaths;
+  for(int i = 0; i < 20; i++) {
+    const std::string fileName = "file" + std::to_string(i) + ".cpp";
+    directory.write(fileName);
+    expectedFilePaths.insert(directory.getPath(fileName));
+  }
+
+  // the writes may be split over several notifications on a busy machine
+  std::set<FilePath> filePaths;
+  for(int count = 1; filePaths.size() < expectedFilePaths.size() && counter.waitForCount(count); count++) {
+    filePaths.merge(watcher.consumeChanges().filePaths);
+  }
+
+  EXPECT_EQ(expectedFilePaths, filePaths);
+}
+
+TEST(FileWatcher, doesNotWatchMissingDirectories) {
+  if(!FileWatcher::isSupported()) {
+    GTEST_SKIP();
+  }
+
+  const TemporaryDirectory directory;
+  FileWatcher watcher(nullptr, SettleTime);
+  ASSERT_TRUE(watcher.start());
+  watcher.addDirectories({directory.getPath("missing")});
+
+  EXPECT_EQ(0, watcher.getWatchedDirectoryCount());
+  EXPECT_FALSE(watcher.hasChanges());
+}
@@ -77,6 +77,16 @@ TEST(TextAccess, textAccessStringLinesContentErrorHandling) {
   EXPECT_TRUE(lines.empty());
 }
 
+TEST(TextAccess, textAccessStringLineRangeText) {
+  const auto text = getTestText();
+
+  const auto textAccess = TextAccess::createFromString(text);
+
+  EXPECT_THAT(textAccess->getText(3, 4), testing::StrEq("\"That's the display department.\"\n\"With a torch.\"\n"));
+  EXPECT_TRUE(textAccess->getText(4, 3).empty());
+  EXPECT_TRUE(textAccess->getText(1, 10).empty());
+}
+
 TEST(TextAccess, TextAccessStringSingleLineContent) {
   const auto text = getTestText();
 
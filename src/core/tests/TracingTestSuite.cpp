@@ -0,0 +1,81 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "tracing.h"
+
+namespace {
+size_t countOccurrences(const std::string& text, const std::string& pattern) {
+  size_t count = 0;
+  for(size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+}    // namespace
+
+TEST(Tracing, nestedScopesAreRecordedWithDepth) {
+  Tracer::getInstance()->clear();
+
+  {
+    ScopedTrace outer("outer", __FILE__, __LINE__, __FUNCTION__);
+    { ScopedTrace inner("inner", __FILE__, __LINE__, __FUNCTION__); }
+  }
+
+  const auto events = Tracer::getInstance()->getEvents();
+  ASSERT_EQ(2, events.size());
+  EXPECT_STREQ("outer", events[0].second.eventName);
+  EXPECT_EQ(0, events[0].second.depth);
+  EXPECT_STREQ("inner", events[1].second.eventName);
+  EXPECT_EQ(1, events[1].second.depth);
+
+  EXPECT_LE(events[0].second.startTime, events[1].second.startTime);
+  EXPECT_GE(events[0].second.startTime + events[0].second.duration, events[1].second.startTime + events[1].second.duration);
+}
+
+TEST(Tracing, ringBufferKeepsLatestEvents) {
+  Tracer::getInstance()->clear();
+
+  for(size_t i = 0; i < Tracer::EventsPerThread + 10; i++) {
+    ScopedTrace trace(i < 10 ? "old" : "new", __FILE__, __LINE__, __FUNCTION__);
+  }
+
+  const auto events = Tracer::getInstance()->getEvents();
+  ASSERT_EQ(Tracer::EventsPerThread - 1, events.size());
+  for(const auto& [threadIndex, event] : events) {
+    EXPECT_STREQ("new", event.eventName);
+  }
+}
+
+TEST(Tracing, chromeTraceContainsEventsOfAllThreads) {
+  Tracer::getInstance()->clear();
+
+  { ScopedTrace trace("main \"thread\"", __FILE__, __LINE__, __FUNCTION__); }
+  std::thread([]() { ScopedTrace trace("worker", __FILE__, __LINE__, __FUNCTION__); }).join();
+
+  std::stringstream stream;
+  Tracer::getInstance()->writeChromeTrace(stream);
+  const std::string trace = stream.str();
+
+  EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_EQ(2, countOccurrences(trace, "\"ph\":\"X\""));
+  EXPECT_EQ(1, countOccurrences(trace, "\"name\":\"main \\\"thread\\\"\""));
+  EXPECT_EQ(1, countOccurrences(trace, "\"name\":\"worker\""));
+  EXPECT_EQ(2, countOccurrences(trace, "TracingTestSuite.cpp:"));
+  EXPECT_NE(std::string::npos, trace.find("\n]}"));
+}
+
+TEST(Tracing, buffersOfExitedThreadsAreReused) {
+  Tracer::getInstance()->clear();
+
+  for(int i = 0; i < 3; i++) {
+    std::thread([]() { ScopedTrace trace("worker", __FILE__, __LINE__, __FUNCTION__); }).join();
+  }
+
+  const auto events = Tracer::getInstance()->getEvents();
+  ASSERT_EQ(3, events.size());
+  EXPECT_EQ(events[0].first, events[1].first);
+  EXPECT_EQ(events[0].first, events[2].first);
+}
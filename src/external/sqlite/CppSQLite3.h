@@ -267,6 +267,8 @@ public:
 
   void open(const char* szFile);
 
+  void open(const char* szFile, int nFlags);
+
   void close();
 
   bool tableExists(const char* szTable);
@@ -79,7 +79,7 @@ int main(int argc, char* argv[]) {
   LanguagePackageManager::getInstance()->addPackage(std::make_shared<LanguagePackageCxx>());
 #endif    // BUILD_CXX_LANGUAGE_PACKAGE
 
-  InterprocessIndexer indexer(instanceUuid, Id(processId));
+  InterprocessIndexer indexer(instanceUuid, Id(processId), true);
   indexer.work();
 
   return 0;
@@ -11,9 +11,13 @@
 #include "../../scheduling/ITaskManager.hpp"
 #include "ColorScheme.h"
 #include "CppSQLite3.h"
+#include "DaemonController.h"
 #include "DialogView.h"
 #include "filter_types/MessageFilterErrorCountUpdate.h"
 #include "filter_types/MessageFilterFocusInOut.h"
+#include "filter_types/MessageFilterIndexingStatus.h"
+#include "filter_types/MessageFilterLatestActivation.h"
+#include "filter_types/MessageFilterScroll.h"
 #include "filter_types/MessageFilterSearchAutocomplete.h"
 #include "GraphViewStyle.h"
 #include "IApplicationSettings.hpp"
@@ -104,6 +108,7 @@ void Application::createInstance(const Version& version,
   scheduling::ITaskManager::setInstance(factory->createTaskManager());
   scheduling::ITaskManager::getInstanceRaw()->createScheduler(TabId::app());
   scheduling::ITaskManager::getInstanceRaw()->createScheduler(TabId::background());
+  scheduling::ITaskManager::getInstanceRaw()->createScheduler(TabId::prefetch());
   IMessageQueue::setInstance(factory->createMessageQueue());
 
   loadSettings();    // Must be called after creating IMessageQueue
@@ -127,6 +132,7 @@ void Application::createInstance(const Version& version,
 void Application::destroyInstance() {
   LOG_INFO("destroyInstance");
   IMessageQueue::getInstance()->stopMessageLoop();
+  scheduling::ITaskManager::getInstanceRaw()->destroyScheduler(TabId::prefetch());
   scheduling::ITaskManager::getInstanceRaw()->destroyScheduler(TabId::background());
   scheduling::ITaskManager::getInstanceRaw()->destroyScheduler(TabId::app());
 
@@ -189,6 +195,16 @@ Application::~Application() {
   }
 }
 
+bool Application::startDaemon(const NetworkFactory& networkFactory, const FilePath& socketPath) {
+  auto daemonController = networkFactory.createDaemonController(mStorageCache.get());
+  if(!daemonController->startListening(socketPath)) {
+    return false;
+  }
+
+  mDaemonController = std::move(daemonController);
+  return true;
+}
+
 int Application::handleDialog(const std::wstring& message) {
   return getDialogView(DialogView::UseCase::GENERAL)->confirm(message);
 }
@@ -236,7 +252,7 @@ void Application::handleMessage(MessageIndexingFinished* /*pMessage*/) {
 
   if(mHasGui) {
     MessageRefreshUI().afterIndexing().dispatch();
-  } else {
+  } else if(!isDaemon()) {
     MessageQuitApplication().dispatch();
   }
 }
@@ -318,7 +334,21 @@ void Application::handleMessage(MessageLoadProject* message) {
 void Application::handleMessage(MessageRefresh* pMessage) {
   TRACE("app refresh");
 
-  refreshProject(pMessage->all ? REFRESH_ALL_FILES : REFRESH_UPDATED_FILES, false);
+  if(pMessage->changedFiles) {
+    if(mProject && checkSharedMemory()) {
+      // re-indexing in the background, without the indexing dialogs of the main view
+      mProject->refreshChangedFiles(std::make_shared<DialogView>(DialogView::UseCase::INDEXING, nullptr));
+    }
+    return;
+  }
+
+  RefreshMode refreshMode = REFRESH_UPDATED_FILES;
+  if(pMessage->all) {
+    refreshMode = REFRESH_ALL_FILES;
+  } else if(pMessage->incompleteFiles) {
+    refreshMode = REFRESH_UPDATED_AND_INCOMPLETE_FILES;
+  }
+  refreshProject(refreshMode, false);
 }
 
 void Application::handleMessage(MessageRefreshUI* pMessage) {
@@ -356,10 +386,14 @@ void Application::handleMessage(MessageBookmarkUpdate* message) {
 void Application::startMessagingAndScheduling() {
   scheduling::ITaskManager::getInstanceRaw()->getScheduler(TabId::app())->startSchedulerLoopThreaded();
   scheduling::ITaskManager::getInstanceRaw()->getScheduler(TabId::background())->startSchedulerLoopThreaded();
+  scheduling::ITaskManager::getInstanceRaw()->getScheduler(TabId::prefetch())->startSchedulerLoopThreaded();
 
   IMessageQueue* queue = IMessageQueue::getInstance().get();
   queue->addMessageFilter(std::make_shared<MessageFilterErrorCountUpdate>());
   queue->addMessageFilter(std::make_shared<MessageFilterFocusInOut>());
+  queue->addMessageFilter(std::make_shared<MessageFilterIndexingStatus>());
+  queue->addMessageFilter(std::make_shared<MessageFilterLatestActivation>());
+  queue->addMessageFilter(std::make_shared<MessageFilterScroll>());
   queue->addMessageFilter(std::make_shared<MessageFilterSearchAutocomplete>());
 
   queue->setSendMessagesAsTasks(true);
@@ -387,7 +421,7 @@ void Application::refreshProject(RefreshMode refreshMode, bool shallowIndexingRe
   if(mProject && checkSharedMemory()) {
     mProject->refresh(getDialogView(DialogView::UseCase::INDEXING), refreshMode, shallowIndexingRequested);
 
-    if(!mHasGui && !mProject->isIndexing()) {
+    if(!mHasGui && !isDaemon() && !mProject->isIndexing()) {
       MessageQuitApplication().dispatch();
     }
   }
@@ -18,6 +18,7 @@
 #include "type/MessageSwitchColorScheme.h"
 
 class Bookmark;
+class DaemonController;
 class IDECommunicationController;
 class MainView;
 class NetworkFactory;
@@ -127,6 +128,22 @@ public:
     return mHasGui;
   }
 
+  /**
+   * @brief Keeps the application running after indexing and answers requests on a local socket.
+   * @param networkFactory Creates the daemon controller.
+   * @param socketPath The path of the socket to listen on.
+   * @return True if the socket is listening, false otherwise.
+   */
+  bool startDaemon(const NetworkFactory& networkFactory, const FilePath& socketPath);
+
+  /**
+   * @brief Checks if the application runs as a headless daemon.
+   * @return True if startDaemon succeeded, false otherwise.
+   */
+  [[nodiscard]] bool isDaemon() const noexcept {
+    return mDaemonController != nullptr;
+  }
+
   /**
    * @brief Handles a dialog with a message.
    * @param message The message to display in the dialog.
@@ -203,4 +220,5 @@ private:
   std::shared_ptr<MainView> mMainView;
 
   std::shared_ptr<IDECommunicationController> mIdeCommunicationController;
+  std::shared_ptr<DaemonController> mDaemonController;
 };
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+class DaemonController;
 class IDECommunicationController;
 class StorageAccess;
 
@@ -10,4 +11,6 @@ public:
   virtual ~NetworkFactory();
 
   virtual std::shared_ptr<IDECommunicationController> createIDECommunicationController(StorageAccess* storageAccess) const = 0;
+
+  virtual std::shared_ptr<DaemonController> createDaemonController(StorageAccess* storageAccess) const = 0;
 };
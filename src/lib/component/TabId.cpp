@@ -3,6 +3,7 @@
 constexpr Id AppId = 1;
 constexpr Id BackgroundId = 2;
 constexpr Id IgnoreId = 3;
+constexpr Id PrefetchId = 4;
 constexpr Id StartingTabId = 10;
 
 Id TabId::s_nextTabId = StartingTabId;
@@ -16,6 +17,10 @@ Id TabId::background() {
   return BackgroundId;
 }
 
+Id TabId::prefetch() {
+  return PrefetchId;
+}
+
 Id TabId::ignore() {
   return IgnoreId;
 }
@@ -6,6 +6,7 @@ class TabId final {
 public:
   static Id app();
   static Id background();
+  static Id prefetch();
   static Id ignore();
 
   static Id nextTab();
@@ -1,5 +1,6 @@
 #include "CodeController.h"
 
+#include <limits>
 #include <memory>
 
 #include "Application.h"
@@ -19,6 +20,13 @@
 #include "utility.h"
 #include "utilityString.h"
 
+namespace {
+// the list view builds a text document per snippet, files beyond this budget stay minimized until they are expanded
+constexpr size_t MAX_SNIPPET_COUNT_TO_EXPAND = 50;
+// snippets of a file in the list are loaded in pages of this size when the view scrolls towards their end
+constexpr size_t SNIPPET_PAGE_SIZE = 20;
+}    // namespace
+
 CodeController::CodeController(StorageAccess* storageAccess) : m_storageAccess(storageAccess) {}
 
 Id CodeController::getSchedulerId() const {
@@ -389,6 +397,33 @@ void CodeController::handleMessage(MessageFocusOut* /*message*/) {
   getView()->deCoFocusTokenIds();
 }
 
+void CodeController::handleMessage(MessageLoadCodeSnippets* message) {
+  TRACE("code load snippets");
+
+  for(CodeFileParams& file : m_files) {
+    if(file.locationFile->getFilePath() == message->filePath) {
+      if(!file.isMinimized && file.unloadedSnippetCount) {
+        loadSnippets(file, 0);
+
+        // local references are collected from the loaded snippets, the current one stays selected
+        if(!m_codeParams.activeLocalSymbolIds.empty()) {
+          const Id currentLocationId = m_localReferenceIndex >= 0 ? m_localReferences[m_localReferenceIndex].locationId : 0;
+          createLocalReferences(utility::toSet(m_codeParams.activeLocalSymbolIds));
+
+          for(size_t i = 0; i < m_localReferences.size() && currentLocationId; i++) {
+            if(m_localReferences[i].locationId == currentLocationId) {
+              m_localReferenceIndex = static_cast<int>(i);
+              break;
+            }
+          }
+        }
+        showFiles(m_codeParams, CodeScrollParams(), !message->isReplayed());
+      }
+      return;
+    }
+  }
+}
+
 void CodeController::handleMessage(MessageScrollToLine* message) {
   getView()->scrollTo(CodeScrollParams::toLine(message->filePath, message->line, CodeScrollParams::Target::TOP), false);
 
@@ -419,6 +454,7 @@ void CodeController::handleMessage(MessageShowReference* message) {
     setFileState(ref.filePath,
                  getView()->isInListMode() ? MessageChangeFileView::FILE_SNIPPETS : MessageChangeFileView::FILE_MAXIMIZED,
                  m_codeParams.useSingleFileCache);
+    loadSnippetsUntilLine(ref.filePath, ref.lineNumber);
 
     showFiles(m_codeParams, toReferenceScrollParams(ref), !message->isReplayed());
 
@@ -608,6 +644,14 @@ CodeSnippetParams CodeController::getSnippetParamsForWholeFile(std::shared_ptr<S
 }
 
 std::vector<CodeSnippetParams> CodeController::getSnippetsForFile(std::shared_ptr<SourceLocationFile> activeSourceLocations) const {
+  return getSnippetsForFile(std::move(activeSourceLocations), 0, std::numeric_limits<size_t>::max(), 0, nullptr);
+}
+
+std::vector<CodeSnippetParams> CodeController::getSnippetsForFile(std::shared_ptr<SourceLocationFile> activeSourceLocations,
+                                                                  size_t afterLineNumber,
+                                                                  size_t snippetCount,
+                                                                  size_t untilLineNumber,
+                                                                  size_t* unloadedSnippetCount) const {
   bool showsErrors = false;
   if(activeSourceLocations->getSourceLocations().size()) {
     showsErrors = (*activeSourceLocations->getSourceLocations().begin())->getType() == LOCATION_ERROR;
@@ -638,12 +682,21 @@ std::vector<CodeSnippetParams> CodeController::getSnippetsForFile(std::shared_pt
 
   const int snippetExpandRange = IApplicationSettings::getInstanceRaw()->getCodeSnippetExpandRange();
   std::vector<CodeSnippetParams> snippets;
+  size_t skippedSnippetCount = 0;
 
   for(const SnippetMerger::Range& range : ranges) {
     CodeSnippetParams params;
     params.startLineNumber = std::max<int>(1, range.start.row - (range.start.strong ? 0 : snippetExpandRange));
     params.endLineNumber = std::min<int>(static_cast<int>(lineCount), range.end.row + (range.end.strong ? 0 : snippetExpandRange));
 
+    // only the snippets of the requested page get their names and code
+    if(params.startLineNumber <= afterLineNumber) {
+      continue;
+    } else if(snippets.size() >= snippetCount && params.startLineNumber > untilLineNumber) {
+      skippedSnippetCount++;
+      continue;
+    }
+
     params.locationFile = activeSourceLocations->getFilteredByLines(params.startLineNumber, params.endLineNumber);
 
     if(params.startLineNumber > 1) {
@@ -668,14 +721,15 @@ std::vector<CodeSnippetParams> CodeController::getSnippetsForFile(std::shared_pt
       params.footer = activeSourceLocations->getFilePath().wstr();
     }
 
-    for(const std::string& line :
-        textAccess->getLines(static_cast<unsigned int>(params.startLineNumber), static_cast<unsigned int>(params.endLineNumber))) {
-      params.code += line;
-    }
+    params.code =
+        textAccess->getText(static_cast<unsigned int>(params.startLineNumber), static_cast<unsigned int>(params.endLineNumber));
 
     snippets.push_back(params);
   }
 
+  if(unloadedSnippetCount) {
+    *unloadedSnippetCount = skippedSnippetCount;
+  }
   return snippets;
 }
 
@@ -996,8 +1050,14 @@ void CodeController::expandVisibleFiles(bool useSingleFileCache) {
   MessageChangeFileView::FileState state = inListMode ? MessageChangeFileView::FILE_SNIPPETS :
                                                         MessageChangeFileView::FILE_MAXIMIZED;
 
+  size_t expandedSnippetCount = 0;
   for(size_t i = 0; i < filesToExpand; i++) {
+    if(i > 0 && expandedSnippetCount >= MAX_SNIPPET_COUNT_TO_EXPAND) {
+      break;
+    }
+
     setFileState(m_files[i], state, useSingleFileCache);
+    expandedSnippetCount += m_files[i].snippetParams.size();
   }
 }
 
@@ -1029,6 +1089,9 @@ CodeFileParams* CodeController::addSourceLocations(std::shared_ptr<SourceLocatio
       return nullptr;
     }
 
+    // the new snippet is merged with the loaded ones, so none may be missing before it
+    loadSnippetsUntilLine(*file, snippets[0].endLineNumber);
+
     CodeSnippetParams newSnippet = snippets[0];
 
     size_t i = 0;
@@ -1090,7 +1153,7 @@ void CodeController::setFileState(CodeFileParams& file, MessageChangeFileView::F
       if(file.locationFile->isWhole()) {
         file.snippetParams = {getSnippetParamsForWholeFile(file.locationFile, useSingleFileCache)};
       } else {
-        file.snippetParams = getSnippetsForFile(file.locationFile);
+        loadSnippets(file, 0);
       }
     }
     break;
@@ -1107,6 +1170,28 @@ void CodeController::setFileState(CodeFileParams& file, MessageChangeFileView::F
   }
 }
 
+void CodeController::loadSnippets(CodeFileParams& file, size_t untilLineNumber) const {
+  const size_t afterLineNumber = file.snippetParams.size() ? file.snippetParams.back().startLineNumber : 0;
+  utility::append(
+      file.snippetParams,
+      getSnippetsForFile(file.locationFile, afterLineNumber, SNIPPET_PAGE_SIZE, untilLineNumber, &file.unloadedSnippetCount));
+}
+
+void CodeController::loadSnippetsUntilLine(const FilePath& filePath, size_t lineNumber) {
+  for(CodeFileParams& file : m_files) {
+    if(file.locationFile->getFilePath() == filePath) {
+      loadSnippetsUntilLine(file, lineNumber);
+      return;
+    }
+  }
+}
+
+void CodeController::loadSnippetsUntilLine(CodeFileParams& file, size_t lineNumber) const {
+  if(file.unloadedSnippetCount && file.snippetParams.size() && file.snippetParams.back().endLineNumber < lineNumber) {
+    loadSnippets(file, lineNumber);
+  }
+}
+
 bool CodeController::addAllSourceLocations() {
   bool addedNewLocations = false;
 
@@ -1224,13 +1309,15 @@ void CodeController::showFirstActiveReference(Id tokenId, bool updateView) {
   int referenceIndex = -1;
   Reference firstReference;
 
-  std::set<FilePath> filePathsToExpand;
+  // files to expand and the last line with a location of the token in them
+  std::map<FilePath, size_t> filePathsToExpand;
   std::map<FilePath, size_t> filePathOrder;
 
   for(size_t i = 0; i < m_references.size(); i++) {
     const Reference& ref = m_references[i];
     if(ref.tokenId == tokenId) {
-      filePathsToExpand.insert(ref.filePath);
+      size_t& lineNumber = filePathsToExpand[ref.filePath];
+      lineNumber = std::max(lineNumber, ref.lineNumber);
       locationIds.push_back(ref.locationId);
 
       if(!firstReference.tokenId) {
@@ -1252,7 +1339,8 @@ void CodeController::showFirstActiveReference(Id tokenId, bool updateView) {
       for(Id i : location->getTokenIds()) {
         if(i == tokenId) {
           locationIds.push_back(location->getLocationId());
-          filePathsToExpand.insert(location->getFilePath());
+          size_t& lineNumber = filePathsToExpand[location->getFilePath()];
+          lineNumber = std::max(lineNumber, location->getLineNumber());
 
           if(!firstReference.tokenId || filePathOrder[location->getFilePath()] < filePathOrder[firstReference.filePath]) {
             firstReference.tokenId = tokenId;
@@ -1266,8 +1354,10 @@ void CodeController::showFirstActiveReference(Id tokenId, bool updateView) {
   }
 
   if(getView()->isInListMode()) {
-    for(const FilePath& filePath : filePathsToExpand) {
+    for(const auto& [filePath, lineNumber] : filePathsToExpand) {
       setFileState(filePath, MessageChangeFileView::FILE_SNIPPETS, m_codeParams.useSingleFileCache);
+      // local references are only created for loaded snippets
+      loadSnippetsUntilLine(filePath, lineNumber);
     }
   } else if(firstReference.tokenId) {
     setFileState(firstReference.filePath, MessageChangeFileView::FILE_MAXIMIZED, m_codeParams.useSingleFileCache);
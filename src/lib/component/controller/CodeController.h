@@ -20,6 +20,7 @@
 #include "type/code/MessageChangeFileView.h"
 #include "type/code/MessageCodeReference.h"
 #include "type/code/MessageCodeShowDefinition.h"
+#include "type/code/MessageLoadCodeSnippets.h"
 #include "type/code/MessageScrollCode.h"
 #include "type/code/MessageScrollToLine.h"
 #include "type/code/MessageShowReference.h"
@@ -59,6 +60,7 @@ class CodeController
     , public MessageListener<MessageFlushUpdates>
     , public MessageListener<MessageFocusIn>
     , public MessageListener<MessageFocusOut>
+    , public MessageListener<MessageLoadCodeSnippets>
     , public MessageListener<MessageScrollCode>
     , public MessageListener<MessageScrollToLine>
     , public MessageListener<MessageShowError>
@@ -99,6 +101,7 @@ private:
   void handleMessage(MessageFlushUpdates* message) override;
   void handleMessage(MessageFocusIn* message) override;
   void handleMessage(MessageFocusOut* message) override;
+  void handleMessage(MessageLoadCodeSnippets* message) override;
   void handleMessage(MessageScrollCode* message) override;
   void handleMessage(MessageScrollToLine* message) override;
   void handleMessage(MessageShowError* message) override;
@@ -114,6 +117,13 @@ private:
   std::vector<CodeFileParams> getFilesForCollection(std::shared_ptr<SourceLocationCollection> collection) const;
   CodeSnippetParams getSnippetParamsForWholeFile(std::shared_ptr<SourceLocationFile> locationFile, bool useSingleFileCache) const;
   std::vector<CodeSnippetParams> getSnippetsForFile(std::shared_ptr<SourceLocationFile> activeSourceLocations) const;
+  // a page of the snippets starting after afterLineNumber, with at least snippetCount snippets and all snippets starting
+  // up to untilLineNumber, the number of snippets after the page is written to unloadedSnippetCount
+  std::vector<CodeSnippetParams> getSnippetsForFile(std::shared_ptr<SourceLocationFile> activeSourceLocations,
+                                                    size_t afterLineNumber,
+                                                    size_t snippetCount,
+                                                    size_t untilLineNumber,
+                                                    size_t* unloadedSnippetCount) const;
 
   std::shared_ptr<SnippetMerger> buildMergerHierarchy(const SourceLocation* location,
                                                       const SourceLocationFile* scopeLocations,
@@ -145,6 +155,10 @@ private:
   CodeFileParams* addSourceLocations(std::shared_ptr<SourceLocationFile> locationFile);
   void setFileState(const FilePath& filePath, MessageChangeFileView::FileState state, bool useSingleFileCache);
   void setFileState(CodeFileParams& file, MessageChangeFileView::FileState state, bool useSingleFileCache);
+  // appends the next page of snippets to a file in the list, and further ones up to untilLineNumber
+  void loadSnippets(CodeFileParams& file, size_t untilLineNumber) const;
+  void loadSnippetsUntilLine(const FilePath& filePath, size_t lineNumber);
+  void loadSnippetsUntilLine(CodeFileParams& file, size_t lineNumber) const;
   bool addAllSourceLocations();
   void addModificationTimes();
 
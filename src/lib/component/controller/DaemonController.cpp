@@ -0,0 +1,200 @@
+#include "DaemonController.h"
+// Qt5
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+// internal
+#include "Application.h"
+#include "ErrorCountInfo.h"
+#include "IProject.hpp"
+#include "logging.h"
+#include "NodeTypeSet.h"
+#include "SearchMatch.h"
+#include "StorageAccess.h"
+#include "StorageStats.h"
+#include "type/indexing/MessageIndexingInterrupted.h"
+#include "type/MessageQuitApplication.h"
+#include "type/MessageRefresh.h"
+
+namespace {
+constexpr int DefaultSearchLimit = 20;
+
+QJsonObject createResult(const QJsonObject& result = QJsonObject()) {
+  return QJsonObject {{"result", result}};
+}
+
+QJsonObject createError(const QString& error) {
+  return QJsonObject {{"error", error}};
+}
+
+std::string toLine(const QJsonObject& object) {
+  return QJsonDocument(object).toJson(QJsonDocument::Compact).toStdString() + '\n';
+}
+
+std::shared_ptr<IProject> getCurrentProject() {
+  const Application::Ptr application = Application::getInstance();
+  return application ? application->getCurrentProject() : nullptr;
+}
+}    // namespace
+
+DaemonController::DaemonController(StorageAccess* storageAccess) : m_storageAccess(storageAccess) {}
+
+DaemonController::~DaemonController() = default;
+
+void DaemonController::handleRequest(ClientId clientId, const std::string& request) {
+  QJsonParseError parseError {};
+  const QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromStdString(request), &parseError);
+  if(parseError.error != QJsonParseError::NoError || !document.isObject()) {
+    LOG_WARNING("Received invalid daemon request: " + request);
+    sendResponse(clientId, toLine(createError("Invalid request: " + parseError.errorString())));
+    return;
+  }
+
+  const QJsonObject requestObject = document.object();
+  const QString method = requestObject.value("method").toString();
+  const QJsonObject params = requestObject.value("params").toObject();
+
+  QJsonObject response;
+  if(method == "status") {
+    response = handleStatus();
+  } else if(method == "index") {
+    response = handleIndex(params);
+  } else if(method == "interrupt") {
+    response = handleInterrupt();
+  } else if(method == "search") {
+    response = handleSearch(params);
+  } else if(method == "shutdown") {
+    response = handleShutdown();
+  } else {
+    response = createError("Unknown method: \"" + method + "\"");
+  }
+
+  if(requestObject.contains("id")) {
+    response.insert("id", requestObject.value("id"));
+  }
+  sendResponse(clientId, toLine(response));
+}
+
+QJsonObject DaemonController::handleStatus() const {
+  QJsonObject result;
+
+  const std::shared_ptr<IProject> project = getCurrentProject();
+  result.insert("project", project ? QString::fromStdWString(project->getProjectSettingsFilePath().wstr()) : QString());
+  result.insert("loaded", project && project->isLoaded());
+  result.insert("indexing", project && project->isIndexing());
+
+  if(project && project->isLoaded()) {
+    const StorageStats stats = m_storageAccess->getStorageStats();
+    const ErrorCountInfo errorCount = m_storageAccess->getErrorCount();
+    result.insert("files", static_cast<qint64>(stats.fileCount));
+    result.insert("completed_files", static_cast<qint64>(stats.completedFileCount));
+    result.insert("symbols", static_cast<qint64>(stats.nodeCount));
+    result.insert("references", static_cast<qint64>(stats.edgeCount));
+    result.insert("errors", static_cast<qint64>(errorCount.total));
+    result.insert("fatal_errors", static_cast<qint64>(errorCount.fatal));
+  }
+
+  return createResult(result);
+}
+
+QJsonObject DaemonController::handleIndex(const QJsonObject& params) {
+  const std::shared_ptr<IProject> project = getCurrentProject();
+  if(!project) {
+    return createError("No project loaded");
+  }
+  if(project->isIndexing()) {
+    return createError("Project is already indexing");
+  }
+
+  const QString mode = params.value("mode").toString("updated");
+  if(mode == "updated") {
+    MessageRefresh().dispatch();
+  } else if(mode == "incomplete") {
+    MessageRefresh().refreshIncompleteFiles().dispatch();
+  } else if(mode == "all") {
+    MessageRefresh().refreshAll().dispatch();
+  } else {
+    return createError("Unknown index mode: \"" + mode + "\"");
+  }
+
+  // progress and the end of indexing are sent as events
+  return createResult({{"started", true}});
+}
+
+QJsonObject DaemonController::handleInterrupt() {
+  const std::shared_ptr<IProject> project = getCurrentProject();
+  if(!project || !project->isIndexing()) {
+    return createError("Project is not indexing");
+  }
+
+  MessageIndexingInterrupted().dispatch();
+  return createResult();
+}
+
+QJsonObject DaemonController::handleSearch(const QJsonObject& params) const {
+  const std::shared_ptr<IProject> project = getCurrentProject();
+  if(!project || !project->isLoaded()) {
+    return createError("No project loaded");
+  }
+
+  const QString query = params.value("query").toString();
+  if(query.isEmpty()) {
+    return createError("Missing search query");
+  }
+  const int limit = params.value("limit").toInt(DefaultSearchLimit);
+
+  QJsonArray matches;
+  for(const SearchMatch& match : m_storageAccess->getAutocompletionMatches(query.toStdWString(), NodeTypeSet::all(), false)) {
+    if(limit > 0 && matches.size() >= limit) {
+      break;
+    }
+
+    QJsonArray ids;
+    for(Id tokenId : match.tokenIds) {
+      ids.append(static_cast<qint64>(tokenId));
+    }
+
+    matches.append(QJsonObject {{"name", QString::fromStdWString(match.getFullName())},
+                                {"type", QString::fromStdWString(match.typeName)},
+                                {"ids", ids}});
+  }
+
+  return createResult({{"matches", matches}});
+}
+
+QJsonObject DaemonController::handleShutdown() {
+  const std::shared_ptr<IProject> project = getCurrentProject();
+  if(project && project->isIndexing()) {
+    // quitting right away would leave the temporary index behind
+    m_quitAfterIndexing = true;
+    MessageIndexingInterrupted().dispatch();
+  } else {
+    MessageQuitApplication().dispatch();
+  }
+
+  return createResult();
+}
+
+void DaemonController::handleMessage(MessageIndexingFinished* /*message*/) {
+  sendEvent(toLine({{"event", "finished"}}));
+
+  if(m_quitAfterIndexing) {
+    MessageQuitApplication().dispatch();
+  }
+}
+
+void DaemonController::handleMessage(MessageIndexingStarted* /*message*/) {
+  sendEvent(toLine({{"event", "started"}}));
+}
+
+void DaemonController::handleMessage(MessageIndexingStatus* message) {
+  if(message->showProgress) {
+    sendEvent(toLine({{"event", "progress"}, {"percent", static_cast<qint64>(message->progressPercent)}}));
+  }
+}
+
+void DaemonController::handleMessage(MessageStatus* message) {
+  for(const std::wstring& status : message->stati()) {
+    sendEvent(toLine({{"event", "status"}, {"message", QString::fromStdWString(status)}, {"error", message->isError}}));
+  }
+}
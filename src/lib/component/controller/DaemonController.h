@@ -0,0 +1,71 @@
+#pragma once
+// STL
+#include <atomic>
+#include <string>
+// internal
+#include "FilePath.h"
+#include "MessageListener.h"
+#include "type/indexing/MessageIndexingFinished.h"
+#include "type/indexing/MessageIndexingStarted.h"
+#include "type/indexing/MessageIndexingStatus.h"
+#include "type/MessageStatus.h"
+
+class QJsonObject;
+class StorageAccess;
+
+/**
+ * Answers the requests of clients connected to Sourcetrail running as a headless daemon (`Sourcetrail serve`). The
+ * project, the storage and its caches stay loaded between requests, so an incremental refresh after a commit only costs
+ * the indexing of the changed files.
+ *
+ * Requests and responses are JSON objects, one per line:
+ *   {"id": 1, "method": "index", "params": {"mode": "updated"}}
+ *   {"id": 1, "result": {"started": true}}
+ *   {"id": 2, "method": "search", "params": {"query": "main", "limit": 10}}
+ *   {"id": 2, "error": "No project loaded"}
+ *
+ * Methods are "status", "index" (mode "updated", "incomplete" or "all"), "interrupt", "search" and "shutdown". Indexing
+ * progress is streamed to all clients as events, e.g. {"event": "progress", "percent": 42} and {"event": "finished"}.
+ */
+class DaemonController
+    : public MessageListener<MessageIndexingFinished>
+    , public MessageListener<MessageIndexingStarted>
+    , public MessageListener<MessageIndexingStatus>
+    , public MessageListener<MessageStatus> {
+public:
+  using ClientId = size_t;
+
+  explicit DaemonController(StorageAccess* storageAccess);
+  ~DaemonController() override;
+
+  DaemonController(const DaemonController&) = delete;
+  DaemonController& operator=(const DaemonController&) = delete;
+
+  virtual bool startListening(const FilePath& socketPath) = 0;
+  virtual void stopListening() = 0;
+  [[nodiscard]] virtual bool isListening() const = 0;
+
+  void handleRequest(ClientId clientId, const std::string& request);
+
+protected:
+  virtual void sendResponse(ClientId clientId, const std::string& response) = 0;
+  // sent to all connected clients
+  virtual void sendEvent(const std::string& event) = 0;
+
+private:
+  QJsonObject handleStatus() const;
+  QJsonObject handleIndex(const QJsonObject& params);
+  QJsonObject handleInterrupt();
+  QJsonObject handleSearch(const QJsonObject& params) const;
+  QJsonObject handleShutdown();
+
+  void handleMessage(MessageIndexingFinished* message) override;
+  void handleMessage(MessageIndexingStarted* message) override;
+  void handleMessage(MessageIndexingStatus* message) override;
+  void handleMessage(MessageStatus* message) override;
+
+  StorageAccess* m_storageAccess;
+
+  // set on the Qt thread, read when the indexing finished message arrives
+  std::atomic<bool> m_quitAfterIndexing = false;
+};
@@ -1,16 +1,21 @@
 #include "GraphController.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <set>
 
 #include "AccessKind.h"
 #include "Application.h"
 #include "BucketLayouter.h"
+#include "filter_types/MessageFilterLatestActivation.h"
 #include "Graph.h"
 #include "GraphView.h"
 #include "GraphViewStyle.h"
 #include "IApplicationSettings.hpp"
 #include "ListLayouter.h"
 #include "logging.h"
+#include "ScopedSwitcher.h"
 #include "StorageAccess.h"
 #include "TokenComponentAccess.h"
 #include "TokenComponentFilePath.h"
@@ -22,7 +27,36 @@
 #include "utility.h"
 #include "utilityString.h"
 
-GraphController::GraphController(StorageAccess* storageAccess) : m_storageAccess(storageAccess), m_useBezierEdges(false) {}
+namespace {
+// graphs with more visible top level nodes are first shown with their groups collapsed to bundles
+constexpr size_t MAX_NODE_COUNT_FOR_SINGLE_PASS_LAYOUT = 50;
+
+std::shared_ptr<DummyNode> copyDummyNodeRecursive(const std::shared_ptr<DummyNode>& node) {
+  std::shared_ptr<DummyNode> copy = std::make_shared<DummyNode>(*node);
+  for(std::shared_ptr<DummyNode>& subNode : copy->subNodes) {
+    subNode = copyDummyNodeRecursive(subNode);
+  }
+  return copy;
+}
+
+// bundle standing in for the given graph nodes, the nodes themselves are not part of it
+std::shared_ptr<DummyNode> createCollapsedBundle(const std::wstring& name, const std::vector<std::shared_ptr<DummyNode>>& nodes) {
+  std::shared_ptr<DummyNode> bundleNode = std::make_shared<DummyNode>(DummyNode::DUMMY_BUNDLE);
+  bundleNode->name = name;
+  bundleNode->visible = true;
+  bundleNode->bundledNodeCount = nodes.size();
+  if(nodes.front()->isGraphNode()) {
+    bundleNode->bundledNodeType = nodes.front()->data->getType();
+  }
+
+  // Use token Id of first node and make first bit 1
+  bundleNode->tokenId = ~(~Id(0) >> 1) + nodes.front()->tokenId;
+  return bundleNode;
+}
+}    // namespace
+
+GraphController::GraphController(StorageAccess* storageAccess)
+    : m_storageAccess(storageAccess), m_prefetcher(storageAccess), m_useBezierEdges(false) {}
 
 GraphController::~GraphController() = default;
 
@@ -58,14 +92,34 @@ void GraphController::handleMessage(MessageActivateOverview* message) {
   clear();
 
   if(message->acceptedNodeTypes != NodeTypeSet::all()) {
-    createDummyGraphAndSetActiveAndVisibility(
-        std::vector<Id>(), m_storageAccess->getGraphForNodeTypes(message->acceptedNodeTypes), false);
+    std::shared_ptr<Graph> graph = m_storageAccess->getGraphForNodeTypes(message->acceptedNodeTypes);
+    if(MessageFilterLatestActivation::isOutdated(message)) {
+      return;
+    }
+
+    createDummyGraphAndSetActiveAndVisibility(std::vector<Id>(), graph, false);
+
+    if(!message->isReplayed() && getVisibleTopLevelNodeCount() > MAX_NODE_COUNT_FOR_SINGLE_PASS_LAYOUT) {
+      GraphView::GraphParams params;
+      params.scrollToTop = true;
+      showCollapsedList(message, params);
+
+      if(MessageFilterLatestActivation::isOutdated(message)) {
+        return;
+      }
+    }
 
     addCharacterIndex();
     layoutNesting();
     layoutList();
   } else {
-    createDummyGraphAndSetActiveAndVisibility(std::vector<Id>(), m_storageAccess->getGraphForAll(), false);
+    // the overview of all nodes is bundled by type, so it is laid out collapsed already
+    std::shared_ptr<Graph> graph = m_storageAccess->getGraphForAll();
+    if(MessageFilterLatestActivation::isOutdated(message)) {
+      return;
+    }
+
+    createDummyGraphAndSetActiveAndVisibility(std::vector<Id>(), graph, false);
 
     bundleNodesByType();
 
@@ -82,6 +136,8 @@ void GraphController::handleMessage(MessageActivateOverview* message) {
 void GraphController::handleMessage(MessageActivateTokens* message) {
   TRACE("graph activate");
 
+  m_prefetcher.cancel();
+
   if(message->isEdge || message->keepContent()) {
     m_activeEdgeIds = message->tokenIds;
     if(message->isBundledEdges)    // only on redo
@@ -119,9 +175,16 @@ void GraphController::handleMessage(MessageActivateTokens* message) {
 
   bool isNamespace = false;
   std::shared_ptr<Graph> graph = m_storageAccess->getGraphForActiveTokenIds(tokenIds, getExpandedNodeIds(), &isNamespace);
+  if(MessageFilterLatestActivation::isOutdated(message)) {
+    return;
+  }
 
   createDummyGraphAndSetActiveAndVisibility(tokenIds, graph, !message->isFromSearch);
 
+  GraphView::GraphParams params;
+  params.centerActiveNode = !isNamespace;
+  params.scrollToTop = isNamespace;
+
   if(isNamespace) {
     addCharacterIndex();
 
@@ -136,41 +199,38 @@ void GraphController::handleMessage(MessageActivateTokens* message) {
     layoutNesting();
     layoutList();
   } else {
-    if(m_activeNodeIds.size() == 1) {
-      bundleNodes();
-    } else if(message->isBundledEdges) {
-      bool isInheritanceChain = true;
-      for(const auto& edge : m_dummyEdges) {
-        if(!edge->data->isType(Edge::EDGE_INHERITANCE)) {
-          isInheritanceChain = false;
-          break;
-        }
-      }
+    bundleActivatedNodes(message);
 
-      if(isInheritanceChain) {
-        for(auto& node : m_dummyNodes) {
-          node->bundleInfo.layoutVertical = true;
-        }
-      }
+    const bool showCollapsedFirst = !message->isReplayed() &&
+        getVisibleTopLevelNodeCount() > MAX_NODE_COUNT_FOR_SINGLE_PASS_LAYOUT;
 
-      m_useBezierEdges = !isInheritanceChain;
+    groupNodesByParents(getView()->getGrouping());
+    if(MessageFilterLatestActivation::isOutdated(message)) {
+      return;
+    }
 
-      for(const std::shared_ptr<DummyEdge>& edge : m_dummyEdges) {
-        edge->active = false;
+    if(showCollapsedFirst) {
+      showCollapsedGraph(message, params);
+
+      if(MessageFilterLatestActivation::isOutdated(message)) {
+        return;
       }
     }
 
-    groupNodesByParents(getView()->getGrouping());
-
     layoutNesting();
     layoutGraph(true);
     assignBundleIds();
   }
 
-  GraphView::GraphParams params;
-  params.centerActiveNode = !isNamespace;
-  params.scrollToTop = isNamespace;
+  if(MessageFilterLatestActivation::isOutdated(message)) {
+    return;
+  }
+
   buildGraph(message, params);
+
+  if(!message->isReplayed()) {
+    prefetchNeighbors();
+  }
 }
 
 void GraphController::handleMessage(MessageActivateTrail* message) {
@@ -189,6 +249,10 @@ void GraphController::handleMessage(MessageActivateTrail* message) {
       message->depth,
       true /* !message->custom || (message->originId && message->targetId) */);
 
+  if(MessageFilterLatestActivation::isOutdated(message)) {
+    return;
+  }
+
   // remove non-indexed files from include graph if indexed file is origin
   if(!message->custom && message->edgeTypes & Edge::EDGE_INCLUDE) {
     Node* fileNode = graph->getNodeById(message->originId ? message->originId : message->targetId);
@@ -246,6 +310,10 @@ void GraphController::handleMessage(MessageActivateTrail* message) {
   layoutNesting();
   layoutTrail(message->horizontalLayout, message->originId);
 
+  if(MessageFilterLatestActivation::isOutdated(message)) {
+    return;
+  }
+
   if(message->originId && message->targetId) {
     DummyNode* targetNode = getDummyGraphNodeById(message->targetId).get();
     if(targetNode) {
@@ -432,7 +500,7 @@ void GraphController::handleMessage(MessageGraphNodeExpand* message) {
 
     setActiveAndVisibility(utility::concat(m_activeNodeIds, m_activeEdgeIds));
 
-    layoutNesting();
+    layoutNesting(true);
     layoutGraph();
 
     buildGraph(message, GraphView::GraphParams());
@@ -519,6 +587,8 @@ GraphView* GraphController::getView() const {
 }
 
 void GraphController::clear() {
+  m_prefetcher.cancel();
+
   m_dummyNodes.clear();
   m_dummyEdges.clear();
 
@@ -687,6 +757,30 @@ std::vector<Id> GraphController::getExpandedNodeIds() const {
   return nodeIds;
 }
 
+void GraphController::prefetchNeighbors() {
+  std::vector<Id> nodeIds;
+  std::set<Id> addedNodeIds(m_activeNodeIds.begin(), m_activeNodeIds.end());
+  const auto addNodeId = [this, &nodeIds, &addedNodeIds](Id nodeId) {
+    auto it = m_dummyGraphNodes.find(nodeId);
+    if(it != m_dummyGraphNodes.end() && it->second->visible && !it->second->active && addedNodeIds.insert(nodeId).second) {
+      nodeIds.push_back(nodeId);
+    }
+  };
+
+  // nodes connected to the active ones first, the remaining visible nodes afterwards
+  for(const std::shared_ptr<DummyEdge>& edge : m_dummyEdges) {
+    if(edge->visible) {
+      addNodeId(edge->ownerId);
+      addNodeId(edge->targetId);
+    }
+  }
+  for(const auto& [id, node] : m_dummyGraphNodes) {
+    addNodeId(id);
+  }
+
+  m_prefetcher.prefetch(nodeIds, getExpandedNodeIds());
+}
+
 void GraphController::setExpandedNodeIds(const std::vector<Id>& nodeIds) {
   for(Id id : nodeIds) {
     DummyNode* node = getDummyGraphNodeById(id).get();
@@ -1491,9 +1585,19 @@ void GraphController::groupTrailNodes(GroupType groupType) {
   }
 }
 
-void GraphController::layoutNesting() {
+void GraphController::layoutNesting(bool reuseUnchangedLayouts) {
+  TRACE("graph layout nesting");
+
+  ScopedSwitcher<bool> switcher(m_reuseUnchangedLayouts, reuseUnchangedLayouts);
+
   extendEqualFunctionNames(m_dummyNodes);
 
+  // computed once per graph, before the layout changes any of its inputs
+  m_layoutSignatures.clear();
+  for(const std::shared_ptr<DummyNode>& node : m_dummyNodes) {
+    addLayoutSignatures(node.get(), true);
+  }
+
   for(const std::shared_ptr<DummyNode>& node : m_dummyNodes) {
     layoutNestingRecursive(node.get());
   }
@@ -1501,6 +1605,8 @@ void GraphController::layoutNesting() {
   for(const std::shared_ptr<DummyNode>& node : m_dummyNodes) {
     layoutToGrid(node.get());
   }
+
+  m_layoutSignatures.clear();
 }
 
 void GraphController::extendEqualFunctionNames(const std::vector<std::shared_ptr<DummyNode>>& nodes) const {
@@ -1534,6 +1640,20 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
     return Vec4i(0, 0, 0, 0);
   }
 
+  size_t layoutSignature = 0;
+  if(node->isGraphNode() && relayoutAccessMaxWidth == -1) {
+    auto it = m_layoutSignatures.find(node);
+    if(it != m_layoutSignatures.end()) {
+      layoutSignature = it->second;
+    }
+
+    // the size check catches nodes resized since their last layout
+    if(m_reuseUnchangedLayouts && layoutSignature != 0 && layoutSignature == node->layoutSignature &&
+       node->size == node->layoutSize) {
+      return node->layoutRect;
+    }
+  }
+
   GraphViewStyle::NodeMargins margins;
 
   if(node->isGraphNode()) {
@@ -1666,7 +1786,50 @@ Vec4i GraphController::layoutNestingRecursive(DummyNode* node, int relayoutAcces
     }
   }
 
-  return ListLayouter::boundingRect(node->subNodes);
+  node->layoutSignature = layoutSignature;
+  node->layoutSize = node->size;
+  node->layoutRect = ListLayouter::boundingRect(node->subNodes);
+  return node->layoutRect;
+}
+
+size_t GraphController::addLayoutSignatures(const DummyNode* node, bool isTopLevel) {
+  size_t signature = 0;
+  const auto combine = [&signature](size_t value) { signature ^= value + 0x9e3779b9 + (signature << 6) + (signature >> 2); };
+
+  combine(static_cast<size_t>(node->type));
+  combine(node->tokenId);
+  combine(isTopLevel);
+  combine(node->visible);
+  combine(node->hidden);
+  combine(node->childVisible);
+  combine(node->active);
+  combine(node->connected);
+  combine(node->expanded);
+  combine(static_cast<size_t>(node->accessKind));
+  combine(static_cast<size_t>(node->bundledNodeType.getKind()));
+  combine(static_cast<size_t>(node->fontSizeDiff));
+  combine(static_cast<size_t>(node->groupType));
+  combine(static_cast<size_t>(node->groupLayout));
+
+  if(node->isGraphNode()) {
+    // the name is elided during layout, so the elided name is used to match the state after the last layout
+    combine(std::hash<std::wstring>()(utility::elide(node->name, utility::ElideMode::RIGHT, node->active ? 100 : 50)));
+    combine(node->data->getChildCount() > 0);
+  } else {
+    combine(std::hash<std::wstring>()(node->name));
+  }
+
+  // expand toggle nodes are recreated by each layout
+  for(const std::shared_ptr<DummyNode>& subNode : node->subNodes) {
+    if(!subNode->isExpandToggleNode()) {
+      combine(addLayoutSignatures(subNode.get(), false));
+    }
+  }
+
+  if(node->isGraphNode()) {
+    m_layoutSignatures[node] = signature;
+  }
+  return signature;
 }
 
 void GraphController::addExpandToggleNode(DummyNode* node) const {
@@ -1740,10 +1903,13 @@ void GraphController::layoutToGrid(DummyNode* node) const {
 
     node->size.x = static_cast<int>(width);
     node->size.y = static_cast<int>(height);
+    node->layoutSize = node->size;
   }
 }
 
 void GraphController::layoutGraph(bool getSortedNodes) {
+  TRACE("graph layout");
+
   std::vector<std::shared_ptr<DummyNode>> visibleNodes;
   for(auto node : m_dummyNodes) {
     if(node->visible) {
@@ -1765,6 +1931,8 @@ void GraphController::layoutList() {
 }
 
 void GraphController::layoutTrail(bool horizontal, bool hasOrigin) {
+  TRACE("trail layout");
+
   TrailLayouter::LayoutDirection direction;
   if(horizontal) {
     if(hasOrigin) {
@@ -1844,14 +2012,14 @@ void GraphController::relayoutGraph(MessageBase* message,
       group->name = groupName;
     }
 
-    layoutNesting();
+    layoutNesting(true);
     layoutList();
   } else {
     if(!showsTrail) {
       groupNodesByParents(getView()->getGrouping());
     }
 
-    layoutNesting();
+    layoutNesting(true);
 
     if(showsTrail) {
       layoutTrail(m_graph->getTrailMode() == Graph::TRAIL_HORIZONTAL, m_graph->hasTrailOrigin());
@@ -1863,6 +2031,149 @@ void GraphController::relayoutGraph(MessageBase* message,
   buildGraph(message, params);
 }
 
+void GraphController::bundleActivatedNodes(const MessageActivateTokens* message) {
+  if(m_activeNodeIds.size() == 1) {
+    bundleNodes();
+  } else if(message->isBundledEdges) {
+    bool isInheritanceChain = true;
+    for(const auto& edge : m_dummyEdges) {
+      if(!edge->data->isType(Edge::EDGE_INHERITANCE)) {
+        isInheritanceChain = false;
+        break;
+      }
+    }
+
+    if(isInheritanceChain) {
+      for(auto& node : m_dummyNodes) {
+        node->bundleInfo.layoutVertical = true;
+      }
+    }
+
+    m_useBezierEdges = !isInheritanceChain;
+
+    for(const std::shared_ptr<DummyEdge>& edge : m_dummyEdges) {
+      edge->active = false;
+    }
+  }
+}
+
+size_t GraphController::getVisibleTopLevelNodeCount() const {
+  return static_cast<size_t>(std::count_if(m_dummyNodes.begin(), m_dummyNodes.end(), [](const std::shared_ptr<DummyNode>& node) {
+    return node->visible;
+  }));
+}
+
+void GraphController::showCollapsedGraph(MessageBase* message, GraphView::GraphParams params) {
+  TRACE("graph collapsed");
+
+  // the group of the active node stays expanded, all other groups are replaced by a bundle
+  std::vector<std::shared_ptr<DummyNode>> nodes;
+  std::map<Id, Id> bundleIdsOfCollapsedNodes;
+  for(const std::shared_ptr<DummyNode>& node : m_dummyNodes) {
+    if(!node->isGroupNode() || !node->visible || node->subNodes.empty() || node->hasActiveSubNode()) {
+      nodes.push_back(copyDummyNodeRecursive(node));
+      continue;
+    }
+
+    std::shared_ptr<DummyNode> bundleNode = createCollapsedBundle(node->name, node->subNodes);
+    bundleNode->bundleInfo = node->bundleInfo;
+    node->forEachDummyNodeRecursive([&bundleIdsOfCollapsedNodes, &bundleNode](DummyNode* subNode) {
+      if(subNode->isGraphNode()) {
+        bundleIdsOfCollapsedNodes.emplace(subNode->tokenId, bundleNode->tokenId);
+      }
+    });
+    nodes.push_back(bundleNode);
+  }
+
+  if(bundleIdsOfCollapsedNodes.empty()) {
+    return;
+  }
+
+  // edges of collapsed nodes are merged into one edge per pair of top level nodes
+  std::vector<std::shared_ptr<DummyEdge>> edges;
+  std::map<std::pair<Id, Id>, DummyEdge*> bundleEdges;
+  for(const std::shared_ptr<DummyEdge>& edge : m_dummyEdges) {
+    auto ownerIt = bundleIdsOfCollapsedNodes.find(edge->ownerId);
+    auto targetIt = bundleIdsOfCollapsedNodes.find(edge->targetId);
+    if(ownerIt == bundleIdsOfCollapsedNodes.end() && targetIt == bundleIdsOfCollapsedNodes.end()) {
+      edges.push_back(std::make_shared<DummyEdge>(*edge));
+      continue;
+    }
+
+    const Id ownerId = (ownerIt != bundleIdsOfCollapsedNodes.end() ? ownerIt->second : edge->ownerId);
+    const Id targetId = (targetIt != bundleIdsOfCollapsedNodes.end() ? targetIt->second : edge->targetId);
+    if(!edge->visible || ownerId == targetId) {
+      continue;
+    }
+
+    DummyEdge*& bundleEdge = bundleEdges[std::make_pair(ownerId, targetId)];
+    if(!bundleEdge) {
+      edges.push_back(std::make_shared<DummyEdge>());
+      bundleEdge = edges.back().get();
+      bundleEdge->visible = true;
+      bundleEdge->ownerId = ownerId;
+      bundleEdge->targetId = targetId;
+    }
+
+    bundleEdge->weight += edge->getWeight();
+    bundleEdge->updateDirection(edge->getDirection(), false);
+  }
+
+  showTemporaryGraph(message, params, std::move(nodes), std::move(edges), false);
+}
+
+void GraphController::showCollapsedList(MessageBase* message, GraphView::GraphParams params) {
+  TRACE("graph collapsed list");
+
+  std::vector<std::shared_ptr<DummyNode>> sortedNodes;
+  std::copy_if(
+      m_dummyNodes.begin(), m_dummyNodes.end(), std::back_inserter(sortedNodes), [](const std::shared_ptr<DummyNode>& node) {
+        return node->visible && node->isGraphNode() && node->name.size();
+      });
+  std::stable_sort(sortedNodes.begin(), sortedNodes.end(), DummyNode::DummyNodeComp());
+
+  // one bundle for each character of the index
+  std::vector<std::shared_ptr<DummyNode>> nodes;
+  std::vector<std::shared_ptr<DummyNode>> nodesOfCharacter;
+  for(size_t i = 0; i < sortedNodes.size(); i++) {
+    const wint_t character = towupper(static_cast<wint_t>(sortedNodes[i]->name[0]));
+    nodesOfCharacter.push_back(sortedNodes[i]);
+
+    if(i + 1 == sortedNodes.size() || towupper(static_cast<wint_t>(sortedNodes[i + 1]->name[0])) != character) {
+      nodes.push_back(createCollapsedBundle(std::wstring(1, static_cast<wchar_t>(character)), nodesOfCharacter));
+      nodesOfCharacter.clear();
+    }
+  }
+
+  showTemporaryGraph(message, params, std::move(nodes), {}, true);
+}
+
+void GraphController::showTemporaryGraph(MessageBase* message,
+                                         GraphView::GraphParams params,
+                                         std::vector<std::shared_ptr<DummyNode>> nodes,
+                                         std::vector<std::shared_ptr<DummyEdge>> edges,
+                                         bool asList) {
+  std::swap(m_dummyNodes, nodes);
+  std::swap(m_dummyEdges, edges);
+
+  layoutNesting();
+  if(asList) {
+    layoutList();
+  } else {
+    layoutGraph(true);
+    assignBundleIds();
+  }
+
+  // the final graph animates from this one and keeps the token to focus
+  const Id tokenIdToFocus = m_tokenIdToFocus;
+  params.animatedTransition = false;
+  buildGraph(message, params);
+  m_tokenIdToFocus = tokenIdToFocus;
+
+  std::swap(m_dummyNodes, nodes);
+  std::swap(m_dummyEdges, edges);
+}
+
 void GraphController::buildGraph(MessageBase* pMessage, GraphView::GraphParams params) {
   if(!pMessage->isReplayed()) {
     params.isIndexedList = params.scrollToTop;
@@ -28,6 +28,7 @@
 #include "DummyNode.h"
 #include "GraphView.h"
 #include "Node.h"
+#include "StoragePrefetcher.h"
 
 class Graph;
 class StorageAccess;
@@ -91,6 +92,8 @@ private:
   void updateDummyNodeNamesAndAddQualifiers(const std::vector<std::shared_ptr<DummyNode>>& dummyNodes);
 
   std::vector<Id> getExpandedNodeIds() const;
+  // warms the storage cache for the visible nodes around the active ones
+  void prefetchNeighbors();
   void setExpandedNodeIds(const std::vector<Id>& nodeIds);
   void autoExpandActiveNode(const std::vector<Id>& activeTokenIds);
 
@@ -117,6 +120,9 @@ private:
                                           const bool considerInvisibleNodes);
   void bundleNodesByType();
 
+  void bundleActivatedNodes(const MessageActivateTokens* message);
+  size_t getVisibleTopLevelNodeCount() const;
+
   void addCharacterIndex();
   bool hasCharacterIndex() const;
 
@@ -124,9 +130,12 @@ private:
   DummyNode* groupAllNodes(GroupType groupType, Id groupNodeId);
   void groupTrailNodes(GroupType groupType);
 
-  void layoutNesting();
+  // when reuseUnchangedLayouts is set, graph nodes whose layout inputs did not change keep their previous layout
+  void layoutNesting(bool reuseUnchangedLayouts = false);
   void extendEqualFunctionNames(const std::vector<std::shared_ptr<DummyNode>>& nodes) const;
   Vec4i layoutNestingRecursive(DummyNode* node, int relayoutAccessMaxWidth = -1) const;
+  // hashes the layout inputs of the node and its sub nodes, stores the ones of graph nodes in m_layoutSignatures
+  size_t addLayoutSignatures(const DummyNode* node, bool isTopLevel);
   void addExpandToggleNode(DummyNode* node) const;
   void layoutToGrid(DummyNode* node) const;
 
@@ -140,6 +149,15 @@ private:
   DummyEdge* getDummyGraphEdgeById(Id tokenId) const;
 
   void relayoutGraph(MessageBase* message, GraphView::GraphParams params, bool withCharacterIndex, const std::wstring& groupName);
+  // publish a first layout of a large graph with its groups, or the characters of a list, collapsed to bundles while the
+  // full layout is computed, the current dummy nodes and edges are left unchanged
+  void showCollapsedGraph(MessageBase* message, GraphView::GraphParams params);
+  void showCollapsedList(MessageBase* message, GraphView::GraphParams params);
+  void showTemporaryGraph(MessageBase* message,
+                          GraphView::GraphParams params,
+                          std::vector<std::shared_ptr<DummyNode>> nodes,
+                          std::vector<std::shared_ptr<DummyEdge>> edges,
+                          bool asList);
   void buildGraph(MessageBase* pMessage, GraphView::GraphParams params);
 
   void forEachDummyNodeRecursive(std::function<void(DummyNode*)> func);
@@ -148,6 +166,7 @@ private:
   void createLegendGraph();
 
   StorageAccess* m_storageAccess;
+  StoragePrefetcher m_prefetcher;
 
   std::vector<std::shared_ptr<DummyNode>> m_dummyNodes;
   std::vector<std::shared_ptr<DummyEdge>> m_dummyEdges;
@@ -163,5 +182,7 @@ private:
 
   bool m_useBezierEdges = false;
   bool m_showsLegend = false;
+  bool m_reuseUnchangedLayouts = false;
+  std::map<const DummyNode*, size_t> m_layoutSignatures;
   Id m_tokenIdToFocus = 0;
 };
\ No newline at end of file
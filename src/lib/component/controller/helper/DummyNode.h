@@ -88,6 +88,7 @@ public:
       , accessKind(ACCESS_NONE)
       , invisibleSubNodeCount(0)
       , bundleId(0)
+      , layoutSignature(0)
       , bundledNodeCount(0)
       , bundledNodeType(NODE_SYMBOL)
       , qualifierName(NAME_DELIMITER_UNKNOWN)
@@ -388,6 +389,9 @@ public:
 
   // Layout
   Vec2i columnSize;
+  size_t layoutSignature;    // layout inputs of the last nesting layout, see GraphController::addLayoutSignatures
+  Vec2i layoutSize;
+  Vec4i layoutRect;
 
   // BundleNode
   BundledNodesSet bundledNodes;
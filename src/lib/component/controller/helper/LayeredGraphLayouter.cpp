@@ -0,0 +1,439 @@
+#include "LayeredGraphLayouter.h"
+// STL
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <utility>
+
+namespace {
+constexpr size_t MAX_ORDER_ITERATIONS = 8;
+
+enum class VisitState : char { NEW, ACTIVE, DONE };
+}    // namespace
+
+LayeredGraphLayouter::LayeredGraphLayouter(int layerGap, int nodeGap, int virtualNodeHeight, bool invertedLayers)
+    : m_layerGap(layerGap), m_nodeGap(nodeGap), m_virtualNodeHeight(virtualNodeHeight), m_invertedLayers(invertedLayers) {}
+
+size_t LayeredGraphLayouter::addNode(int width, int height) {
+  m_widths.push_back(width);
+  m_heights.push_back(height);
+  m_levels.push_back(-1);
+  m_xs.push_back(0);
+  m_ys.push_back(0);
+  m_indexInLayer.push_back(0);
+  m_outgoing.emplace_back();
+  m_predecessors.emplace_back();
+  m_successors.emplace_back();
+  return m_widths.size() - 1;
+}
+
+size_t LayeredGraphLayouter::addEdge(size_t origin, size_t target) {
+  m_origins.push_back(origin);
+  m_targets.push_back(target);
+  m_reversed.push_back(false);
+  m_virtualNodes.emplace_back();
+
+  const size_t edge = m_origins.size() - 1;
+  m_outgoing[origin].push_back(edge);
+  return edge;
+}
+
+void LayeredGraphLayouter::layout(size_t rootNode) {
+  if(rootNode >= m_widths.size()) {
+    return;
+  }
+
+  m_inputNodeCount = m_widths.size();
+
+  removeCycles(rootNode);
+  assignLevels();
+  addVirtualNodes();
+  orderLayers(rootNode);
+  assignCoordinates();
+}
+
+size_t LayeredGraphLayouter::getNodeCount() const {
+  return m_widths.size();
+}
+
+int LayeredGraphLayouter::getLevel(size_t node) const {
+  return m_levels[node];
+}
+
+int LayeredGraphLayouter::getX(size_t node) const {
+  return m_xs[node];
+}
+
+int LayeredGraphLayouter::getY(size_t node) const {
+  return m_ys[node];
+}
+
+int LayeredGraphLayouter::getWidth(size_t node) const {
+  return m_widths[node];
+}
+
+int LayeredGraphLayouter::getHeight(size_t node) const {
+  return m_heights[node];
+}
+
+const std::vector<size_t>& LayeredGraphLayouter::getVirtualNodes(size_t edge) const {
+  return m_virtualNodes[edge];
+}
+
+size_t LayeredGraphLayouter::getCrossingCount() const {
+  return m_crossingCount;
+}
+
+void LayeredGraphLayouter::removeCycles(size_t rootNode) {
+  std::vector<VisitState> states(m_widths.size(), VisitState::NEW);
+
+  // pairs of node and index of the next outgoing edge to visit
+  std::vector<std::pair<size_t, size_t>> stack;
+
+  // the root first, then the nodes it does not reach, e.g. callers that are only connected by their outgoing edges
+  for(size_t startNode = 0; startNode <= m_widths.size(); startNode++) {
+    const size_t node = startNode == 0 ? rootNode : startNode - 1;
+    if(states[node] != VisitState::NEW) {
+      continue;
+    }
+
+    stack.emplace_back(node, 0);
+    states[node] = VisitState::ACTIVE;
+
+    while(!stack.empty()) {
+      auto& [current, nextEdgeIndex] = stack.back();
+
+      if(nextEdgeIndex == m_outgoing[current].size()) {
+        states[current] = VisitState::DONE;
+        stack.pop_back();
+        continue;
+      }
+
+      const size_t edge = m_outgoing[current][nextEdgeIndex++];
+      const size_t target = m_targets[edge];
+
+      if(states[target] == VisitState::ACTIVE) {
+        m_reversed[edge] = true;
+      } else if(states[target] == VisitState::NEW) {
+        states[target] = VisitState::ACTIVE;
+        stack.emplace_back(target, 0);
+      }
+    }
+  }
+
+  std::fill(m_levels.begin(), m_levels.end(), 0);
+}
+
+void LayeredGraphLayouter::assignLevels() {
+  std::vector<std::vector<size_t>> successors(m_widths.size());
+  std::vector<size_t> inDegrees(m_widths.size(), 0);
+
+  for(size_t edge = 0; edge < m_origins.size(); edge++) {
+    size_t origin = m_origins[edge];
+    size_t target = m_targets[edge];
+    if(origin == target) {
+      continue;
+    }
+
+    if(m_reversed[edge]) {
+      std::swap(origin, target);
+    }
+
+    successors[origin].push_back(target);
+    inDegrees[target]++;
+  }
+
+  // longest path layering in topological order, starting at all sources so no node is left without level
+  std::deque<size_t> nodes;
+  for(size_t node = 0; node < m_widths.size(); node++) {
+    if(inDegrees[node] == 0) {
+      nodes.push_back(node);
+    }
+  }
+
+  while(!nodes.empty()) {
+    const size_t node = nodes.front();
+    nodes.pop_front();
+
+    for(size_t successor : successors[node]) {
+      m_levels[successor] = std::max(m_levels[successor], m_levels[node] + 1);
+
+      if(--inDegrees[successor] == 0) {
+        nodes.push_back(successor);
+      }
+    }
+  }
+}
+
+void LayeredGraphLayouter::addVirtualNodes() {
+  for(size_t edge = 0; edge < m_origins.size(); edge++) {
+    size_t origin = m_origins[edge];
+    size_t target = m_targets[edge];
+    if(origin == target) {
+      continue;
+    }
+
+    if(m_reversed[edge]) {
+      std::swap(origin, target);
+    }
+
+    size_t previous = origin;
+    for(int level = m_levels[origin] + 1; level < m_levels[target]; level++) {
+      const size_t virtualNode = addNode(0, m_virtualNodeHeight);
+      m_levels[virtualNode] = level;
+
+      m_successors[previous].push_back(virtualNode);
+      m_predecessors[virtualNode].push_back(previous);
+
+      m_virtualNodes[edge].push_back(virtualNode);
+      previous = virtualNode;
+    }
+
+    m_successors[previous].push_back(target);
+    m_predecessors[target].push_back(previous);
+
+    if(m_reversed[edge]) {
+      std::reverse(m_virtualNodes[edge].begin(), m_virtualNodes[edge].end());
+    }
+  }
+}
+
+void LayeredGraphLayouter::orderLayers(size_t rootNode) {
+  const int maxLevel = *std::max_element(m_levels.begin(), m_levels.end());
+  m_layers.assign(static_cast<size_t>(maxLevel + 1), std::vector<size_t>());
+
+  // initial order by breadth first search from the root, followed by the nodes it does not reach
+  std::vector<bool> visited(m_widths.size(), false);
+  std::deque<size_t> nodes;
+
+  for(size_t startNode = 0; startNode <= m_widths.size(); startNode++) {
+    const size_t node = startNode == 0 ? rootNode : startNode - 1;
+    if(visited[node]) {
+      continue;
+    }
+
+    nodes.push_back(node);
+    visited[node] = true;
+
+    while(!nodes.empty()) {
+      const size_t current = nodes.front();
+      nodes.pop_front();
+
+      m_indexInLayer[current] = m_layers[static_cast<size_t>(m_levels[current])].size();
+      m_layers[static_cast<size_t>(m_levels[current])].push_back(current);
+
+      for(size_t successor : m_successors[current]) {
+        if(!visited[successor]) {
+          visited[successor] = true;
+          nodes.push_back(successor);
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<size_t>> bestLayers = m_layers;
+  size_t bestCrossingCount = countCrossings();
+
+  for(size_t iteration = 0; iteration < MAX_ORDER_ITERATIONS && bestCrossingCount > 0; iteration++) {
+    for(size_t layer = 1; layer < m_layers.size(); layer++) {
+      sortLayerByBarycenter(layer, true);
+    }
+    for(size_t layer = m_layers.size() - 1; layer > 0; layer--) {
+      sortLayerByBarycenter(layer - 1, false);
+    }
+
+    const size_t crossingCount = countCrossings();
+    if(crossingCount >= bestCrossingCount) {
+      break;
+    }
+
+    bestCrossingCount = crossingCount;
+    bestLayers = m_layers;
+  }
+
+  m_layers = std::move(bestLayers);
+  m_crossingCount = bestCrossingCount;
+
+  for(const std::vector<size_t>& layer : m_layers) {
+    for(size_t i = 0; i < layer.size(); i++) {
+      m_indexInLayer[layer[i]] = i;
+    }
+  }
+}
+
+void LayeredGraphLayouter::assignCoordinates() {
+  std::vector<int> layerWidths(m_layers.size(), 0);
+  for(size_t layer = 0; layer < m_layers.size(); layer++) {
+    for(size_t node : m_layers[layer]) {
+      layerWidths[layer] = std::max(layerWidths[layer], m_widths[node]);
+    }
+  }
+
+  int x = 0;
+  for(size_t layer = 0; layer < m_layers.size(); layer++) {
+    int height = -m_nodeGap;
+    for(size_t node : m_layers[layer]) {
+      height += m_heights[node] + m_nodeGap;
+    }
+
+    int y = -height / 2;
+    for(size_t node : m_layers[layer]) {
+      m_xs[node] = x;
+      m_ys[node] = y;
+      y += m_heights[node] + m_nodeGap;
+
+      if(node >= m_inputNodeCount) {
+        m_widths[node] = layerWidths[layer];
+      }
+    }
+
+    if(layer + 1 < m_layers.size()) {
+      x += m_invertedLayers ? -(layerWidths[layer + 1] + m_layerGap) : layerWidths[layer] + m_layerGap;
+    }
+  }
+
+  for(size_t layer = 1; layer < m_layers.size(); layer++) {
+    placeLayer(layer, true);
+  }
+  for(size_t layer = m_layers.size() - 1; layer > 0; layer--) {
+    placeLayer(layer - 1, false);
+  }
+  for(size_t layer = 1; layer < m_layers.size(); layer++) {
+    placeLayer(layer, true);
+  }
+}
+
+void LayeredGraphLayouter::sortLayerByBarycenter(size_t layer, bool usePredecessors) {
+  std::vector<size_t>& nodes = m_layers[layer];
+  const std::vector<std::vector<size_t>>& neighbors = usePredecessors ? m_predecessors : m_successors;
+
+  std::vector<std::pair<double, size_t>> barycenters;
+  barycenters.reserve(nodes.size());
+
+  for(size_t i = 0; i < nodes.size(); i++) {
+    const std::vector<size_t>& nodeNeighbors = neighbors[nodes[i]];
+
+    // nodes without neighbors keep their position
+    double barycenter = static_cast<double>(i);
+    if(!nodeNeighbors.empty()) {
+      double sum = 0;
+      for(size_t neighbor : nodeNeighbors) {
+        sum += static_cast<double>(m_indexInLayer[neighbor]);
+      }
+      barycenter = sum / static_cast<double>(nodeNeighbors.size());
+    }
+
+    barycenters.emplace_back(barycenter, nodes[i]);
+  }
+
+  std::stable_sort(barycenters.begin(), barycenters.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  for(size_t i = 0; i < nodes.size(); i++) {
+    nodes[i] = barycenters[i].second;
+    m_indexInLayer[nodes[i]] = i;
+  }
+}
+
+void LayeredGraphLayouter::placeLayer(size_t layer, bool usePredecessors) {
+  const std::vector<size_t>& nodes = m_layers[layer];
+  const std::vector<std::vector<size_t>>& neighbors = usePredecessors ? m_predecessors : m_successors;
+
+  // consecutive nodes that are placed without gaps, at the mean of the desired positions of their nodes
+  struct Block {
+    size_t firstIndex;
+    double desiredTopSum;
+    size_t nodeCount;
+    int height;
+
+    double getTop() const {
+      return desiredTopSum / static_cast<double>(nodeCount);
+    }
+  };
+
+  std::vector<Block> blocks;
+  for(size_t i = 0; i < nodes.size(); i++) {
+    const size_t node = nodes[i];
+
+    double desiredCenter = m_ys[node] + m_heights[node] / 2.0;
+    if(!neighbors[node].empty()) {
+      double sum = 0;
+      for(size_t neighbor : neighbors[node]) {
+        sum += m_ys[neighbor] + m_heights[neighbor] / 2.0;
+      }
+      desiredCenter = sum / static_cast<double>(neighbors[node].size());
+    }
+
+    Block block{i, desiredCenter - m_heights[node] / 2.0, 1, m_heights[node]};
+
+    while(!blocks.empty() && blocks.back().getTop() + blocks.back().height + m_nodeGap > block.getTop()) {
+      const Block& previous = blocks.back();
+      const int offset = previous.height + m_nodeGap;
+
+      block.desiredTopSum = previous.desiredTopSum + block.desiredTopSum - static_cast<double>(block.nodeCount) * offset;
+      block.nodeCount += previous.nodeCount;
+      block.height += offset;
+      block.firstIndex = previous.firstIndex;
+
+      blocks.pop_back();
+    }
+
+    blocks.push_back(block);
+  }
+
+  for(const Block& block : blocks) {
+    int y = static_cast<int>(std::lround(block.getTop()));
+    for(size_t i = block.firstIndex; i < block.firstIndex + block.nodeCount; i++) {
+      m_ys[nodes[i]] = y;
+      y += m_heights[nodes[i]] + m_nodeGap;
+    }
+  }
+}
+
+size_t LayeredGraphLayouter::countCrossings() const {
+  size_t crossingCount = 0;
+  for(size_t layer = 0; layer + 1 < m_layers.size(); layer++) {
+    crossingCount += countCrossings(layer);
+  }
+  return crossingCount;
+}
+
+size_t LayeredGraphLayouter::countCrossings(size_t upperLayer) const {
+  const size_t lowerNodeCount = m_layers[upperLayer + 1].size();
+  if(lowerNodeCount < 2) {
+    return 0;
+  }
+
+  // lower indices of all edges, sorted by upper and then lower index
+  std::vector<size_t> lowerIndices;
+  for(size_t node : m_layers[upperLayer]) {
+    const size_t first = lowerIndices.size();
+    for(size_t successor : m_successors[node]) {
+      lowerIndices.push_back(m_indexInLayer[successor]);
+    }
+    std::sort(lowerIndices.begin() + static_cast<std::ptrdiff_t>(first), lowerIndices.end());
+  }
+
+  // accumulator tree counting the inserted indices right of each inserted index
+  size_t firstLeaf = 1;
+  while(firstLeaf < lowerNodeCount) {
+    firstLeaf *= 2;
+  }
+  std::vector<size_t> tree(2 * firstLeaf - 1, 0);
+  firstLeaf -= 1;
+
+  size_t crossingCount = 0;
+  for(size_t lowerIndex : lowerIndices) {
+    size_t index = lowerIndex + firstLeaf;
+    tree[index]++;
+
+    while(index > 0) {
+      if(index % 2 == 1) {
+        crossingCount += tree[index + 1];
+      }
+      index = (index - 1) / 2;
+      tree[index]++;
+    }
+  }
+
+  return crossingCount;
+}
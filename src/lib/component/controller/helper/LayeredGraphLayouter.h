@@ -0,0 +1,78 @@
+#pragma once
+// STL
+#include <cstddef>
+#include <vector>
+
+/**
+ * Layered (Sugiyama style) layout for large directed graphs, all steps are iterative and near linear:
+ *  - cycle removal by reversing the back edges of an iterative depth first search from the root
+ *  - longest path layering in topological order
+ *  - long edges are split into chains of virtual nodes
+ *  - barycenter crossing reduction sweeps, crossings are counted with an accumulator tree in O(E log V)
+ *  - coordinates within a layer are placed close to the neighbors by merging overlapping blocks of nodes
+ *
+ * Coordinates are abstract: x runs across the layers and y within a layer. Nodes that are not reachable from the
+ * root are layered from the sources of their part of the graph, so every node gets a level and a position.
+ */
+class LayeredGraphLayouter {
+public:
+  LayeredGraphLayouter(int layerGap, int nodeGap, int virtualNodeHeight, bool invertedLayers);
+
+  size_t addNode(int width, int height);
+  size_t addEdge(size_t origin, size_t target);
+
+  void layout(size_t rootNode);
+
+  // includes the virtual nodes created by layout()
+  [[nodiscard]] size_t getNodeCount() const;
+
+  [[nodiscard]] int getLevel(size_t node) const;
+  [[nodiscard]] int getX(size_t node) const;
+  [[nodiscard]] int getY(size_t node) const;
+  // virtual nodes are as wide as their layer
+  [[nodiscard]] int getWidth(size_t node) const;
+  [[nodiscard]] int getHeight(size_t node) const;
+
+  // virtual nodes of an edge, ordered from the origin to the target of the edge
+  [[nodiscard]] const std::vector<size_t>& getVirtualNodes(size_t edge) const;
+
+  [[nodiscard]] size_t getCrossingCount() const;
+
+private:
+  void removeCycles(size_t rootNode);
+  void assignLevels();
+  void addVirtualNodes();
+  void orderLayers(size_t rootNode);
+  void assignCoordinates();
+
+  void sortLayerByBarycenter(size_t layer, bool usePredecessors);
+  void placeLayer(size_t layer, bool usePredecessors);
+  size_t countCrossings() const;
+  size_t countCrossings(size_t upperLayer) const;
+
+  const int m_layerGap;
+  const int m_nodeGap;
+  const int m_virtualNodeHeight;
+  const bool m_invertedLayers;
+
+  // per node
+  std::vector<int> m_widths;
+  std::vector<int> m_heights;
+  std::vector<int> m_levels;
+  std::vector<int> m_xs;
+  std::vector<int> m_ys;
+  std::vector<size_t> m_indexInLayer;
+  std::vector<std::vector<size_t>> m_outgoing;    // edge indices of the input graph
+  std::vector<std::vector<size_t>> m_predecessors;
+  std::vector<std::vector<size_t>> m_successors;
+
+  // per edge
+  std::vector<size_t> m_origins;
+  std::vector<size_t> m_targets;
+  std::vector<bool> m_reversed;
+  std::vector<std::vector<size_t>> m_virtualNodes;
+
+  std::vector<std::vector<size_t>> m_layers;
+  size_t m_inputNodeCount = 0;
+  size_t m_crossingCount = 0;
+};
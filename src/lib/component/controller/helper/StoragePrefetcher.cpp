@@ -0,0 +1,91 @@
+#include "StoragePrefetcher.h"
+// STL
+#include <algorithm>
+#include <functional>
+// internal
+#include "FilePath.h"
+#include "SourceLocationCollection.h"
+#include "SourceLocationFile.h"
+#include "StorageAccess.h"
+#include "TabId.h"
+#include "Task.h"
+#include "TaskLambda.h"
+#include "tracing.h"
+
+namespace {
+constexpr size_t MAX_PREFETCHED_NODE_COUNT = 12;
+constexpr size_t MAX_PREFETCHED_FILE_COUNT_PER_NODE = 3;
+
+void prefetchNodes(StorageAccess* storageAccess,
+                   const std::vector<Id>& nodeIds,
+                   const std::vector<Id>& expandedNodeIds,
+                   const std::function<bool()>& isCancelled) {
+  TRACE("prefetch neighbors");
+
+  for(Id nodeId : nodeIds) {
+    if(isCancelled()) {
+      return;
+    }
+    storageAccess->getGraphForActiveTokenIds({nodeId}, expandedNodeIds);
+
+    if(isCancelled()) {
+      return;
+    }
+    // CodeController requests the locations of all active token ids of a node, e.g. including its overloads, so the
+    // cache entry is only hit with the same key
+    Id declarationId = 0;
+    std::shared_ptr<SourceLocationCollection> collection = storageAccess->getSourceLocationsForTokenIds(
+        storageAccess->getActiveTokenIdsForId(nodeId, &declarationId));
+    if(!collection) {
+      continue;
+    }
+
+    std::vector<FilePath> filePaths;
+    collection->forEachSourceLocationFile([&filePaths](const std::shared_ptr<SourceLocationFile>& file) {
+      if(filePaths.size() < MAX_PREFETCHED_FILE_COUNT_PER_NODE) {
+        filePaths.push_back(file->getFilePath());
+      }
+    });
+
+    for(const FilePath& filePath : filePaths) {
+      if(isCancelled()) {
+        return;
+      }
+      storageAccess->getFileContent(filePath, false);
+    }
+  }
+}
+}    // namespace
+
+StoragePrefetcher::StoragePrefetcher(StorageAccess* storageAccess)
+    : m_storageAccess(storageAccess), m_generation(std::make_shared<std::atomic<size_t>>(0)) {}
+
+StoragePrefetcher::~StoragePrefetcher() {
+  cancel();
+}
+
+void StoragePrefetcher::prefetch(const std::vector<Id>& nodeIds, const std::vector<Id>& expandedNodeIds) {
+  const size_t generation = ++(*m_generation);
+
+  if(m_storageAccess == nullptr || nodeIds.empty()) {
+    return;
+  }
+
+  const size_t nodeCount = std::min(nodeIds.size(), MAX_PREFETCHED_NODE_COUNT);
+  std::vector<Id> prefetchedNodeIds(nodeIds.begin(), nodeIds.begin() + static_cast<std::ptrdiff_t>(nodeCount));
+
+  Task::dispatch(TabId::prefetch(),
+                 std::make_shared<TaskLambda>([storageAccess = m_storageAccess,
+                                               currentGeneration = m_generation,
+                                               generation,
+                                               prefetchedNodeIds = std::move(prefetchedNodeIds),
+                                               expandedNodeIds]() {
+                   prefetchNodes(storageAccess, prefetchedNodeIds, expandedNodeIds, [&currentGeneration, generation]() {
+                     return *currentGeneration != generation;
+                   });
+                 }));
+}
+
+void StoragePrefetcher::cancel() {
+  ++(*m_generation);
+}
@@ -0,0 +1,30 @@
+#pragma once
+// STL
+#include <atomic>
+#include <memory>
+#include <vector>
+// internal
+#include "types.h"
+
+class StorageAccess;
+
+/**
+ * Speculatively runs the storage queries of activations the user is likely to trigger next, so their results are
+ * already cached when the user actually clicks. The queries run on the prefetch scheduler and the remaining ones are
+ * skipped as soon as a newer prefetch is requested or cancel() is called.
+ */
+class StoragePrefetcher final {
+public:
+  explicit StoragePrefetcher(StorageAccess* storageAccess);
+  ~StoragePrefetcher();
+
+  StoragePrefetcher(const StoragePrefetcher&) = delete;
+  StoragePrefetcher& operator=(const StoragePrefetcher&) = delete;
+
+  void prefetch(const std::vector<Id>& nodeIds, const std::vector<Id>& expandedNodeIds);
+  void cancel();
+
+private:
+  StorageAccess* m_storageAccess;
+  std::shared_ptr<std::atomic<size_t>> m_generation;
+};
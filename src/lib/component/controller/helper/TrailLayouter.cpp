@@ -2,6 +2,13 @@
 
 #include <iostream>
 
+#include "LayeredGraphLayouter.h"
+
+namespace {
+// the recursive cycle removal and average position layout do not scale beyond this
+constexpr size_t MAX_NODE_COUNT_FOR_SIMPLE_LAYOUT = 100;
+}    // namespace
+
 TrailLayouter::TrailLayouter(LayoutDirection dir) : m_direction(dir), m_rootNode(nullptr) {}
 
 void TrailLayouter::layoutGraph(std::vector<std::shared_ptr<DummyNode>>& dummyNodes,
@@ -14,16 +21,21 @@ void TrailLayouter::layoutGraph(std::vector<std::shared_ptr<DummyNode>>& dummyNo
   }
 
   removeDeadEnds();
-  makeAcyclicRecursive(m_rootNode, std::set<TrailNode*>());
 
-  assignLongestPathLevels();
-  assignRemainingLevels();
+  if(m_allNodes.size() > MAX_NODE_COUNT_FOR_SIMPLE_LAYOUT) {
+    layoutLayered();
+  } else {
+    makeAcyclicRecursive(m_rootNode, std::set<TrailNode*>());
 
-  addVirtualNodes();
+    assignLongestPathLevels();
+    assignRemainingLevels();
 
-  buildColumns();
-  reduceEdgeCrossings();
-  layout();
+    addVirtualNodes();
+
+    buildColumns();
+    reduceEdgeCrossings();
+    layout();
+  }
 
   retrievePositions(topLevelAncestorIds);
 
@@ -382,6 +394,50 @@ void TrailLayouter::layout() {
   // put into grid
 }
 
+void TrailLayouter::layoutLayered() {
+  const unsigned int xIdx = horizontalLayout() ? 0 : 1;
+  const unsigned int yIdx = horizontalLayout() ? 1 : 0;
+
+  // same spacing as layout() and addVirtualNodes()
+  LayeredGraphLayouter layouter(150, 30, horizontalLayout() ? 20 : 50, invertedLayout());
+
+  std::map<TrailNode*, size_t> nodeIndices;
+  for(const std::shared_ptr<TrailNode>& node : m_allNodes) {
+    nodeIndices.emplace(node.get(), layouter.addNode(node->size.getValue(xIdx), node->size.getValue(yIdx)));
+  }
+
+  for(const std::shared_ptr<TrailEdge>& edge : m_allEdges) {
+    layouter.addEdge(nodeIndices[edge->origin], nodeIndices[edge->target]);
+  }
+
+  layouter.layout(nodeIndices[m_rootNode]);
+
+  const auto applyLayout = [&](TrailNode* node, size_t index) {
+    node->level = layouter.getLevel(index);
+    node->pos.setValue(xIdx, layouter.getX(index));
+    node->pos.setValue(yIdx, layouter.getY(index));
+    node->size.setValue(xIdx, layouter.getWidth(index));
+    node->size.setValue(yIdx, layouter.getHeight(index));
+  };
+
+  for(const auto& [node, index] : nodeIndices) {
+    applyLayout(node, index);
+  }
+
+  for(size_t i = 0; i < m_allEdges.size(); i++) {
+    for(size_t index : layouter.getVirtualNodes(i)) {
+      std::shared_ptr<TrailNode> virtualNode = std::make_shared<TrailNode>();
+      virtualNode->id = 0;
+      virtualNode->name = L"<virtual>";
+      virtualNode->dummyNode = nullptr;
+      applyLayout(virtualNode.get(), index);
+
+      m_allNodes.push_back(virtualNode);
+      m_allEdges[i]->virtualNodes.push_back(virtualNode.get());
+    }
+  }
+}
+
 void TrailLayouter::moveNodesToAveragePosition(std::vector<TrailNode*> nodes, bool forward) {
   unsigned int yIdx = horizontalLayout() ? 1 : 0;
 
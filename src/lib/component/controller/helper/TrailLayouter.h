@@ -8,7 +8,7 @@
 #include "DummyEdge.h"
 #include "DummyNode.h"
 
-// based on Sugiyama dependency graph layouting
+// based on Sugiyama dependency graph layouting, large trails are handed to the LayeredGraphLayouter
 
 class TrailLayouter {
 public:
@@ -62,6 +62,7 @@ private:
   void reduceEdgeCrossings();
 
   void layout();
+  void layoutLayered();
   void moveNodesToAveragePosition(std::vector<TrailNode*> nodes, bool forward);
   void retrievePositions(const std::map<Id, Id>& topLevelAncestorIds);
 
@@ -39,6 +39,8 @@ struct CodeFileParams {
   bool isDefinition = false;
 
   std::vector<CodeSnippetParams> snippetParams;
+  // snippets after the last one in snippetParams that are not loaded yet
+  size_t unloadedSnippetCount = 0;
   std::shared_ptr<CodeSnippetParams> fileParams;    // TODO: replace with std::optional
 };
 
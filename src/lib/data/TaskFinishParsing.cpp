@@ -4,15 +4,21 @@
 
 #include "../../scheduling/Blackboard.h"
 #include "DialogView.h"
+#include "IndexingMetrics.h"
+#include "logging.h"
 #include "PersistentStorage.h"
 #include "TimeStamp.h"
 #include "type/indexing/MessageIndexingFinished.h"
 #include "type/indexing/MessageIndexingStatus.h"
 #include "type/MessageStatus.h"
+#include "UserPaths.h"
+#include "utilityApp.h"
 #include "utilityString.h"
 
-TaskFinishParsing::TaskFinishParsing(std::shared_ptr<PersistentStorage> storage, std::shared_ptr<DialogView> dialogView)
-    : m_storage(std::move(storage)), m_dialogView(std::move(dialogView)) {}
+TaskFinishParsing::TaskFinishParsing(std::shared_ptr<PersistentStorage> storage,
+                                     std::shared_ptr<DialogView> dialogView,
+                                     std::shared_ptr<IndexingMetrics> indexingMetrics)
+    : m_storage(std::move(storage)), m_dialogView(std::move(dialogView)), m_indexingMetrics(std::move(indexingMetrics)) {}
 
 void TaskFinishParsing::terminate() {
   m_dialogView->clearDialogs();
@@ -23,12 +29,14 @@ void TaskFinishParsing::terminate() {
 
 void TaskFinishParsing::doEnter(std::shared_ptr<Blackboard> /*blackboard*/) {
   m_storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+  m_storage->setProfile(SqliteStorage::STORAGE_PROFILE_DEFAULT);
 }
 
 Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboard) {
   TimeStamp start = TimeStamp::now();
 
   m_dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Optimizing database");
+  m_storage->buildFileDependencies();
   m_storage->optimizeMemory();
   m_dialogView->hideUnknownProgressDialog();
 
@@ -70,6 +78,12 @@ Task::TaskState TaskFinishParsing::doUpdate(std::shared_ptr<Blackboard> blackboa
   }
   MessageStatus(status, false, false).dispatch();
 
+  if(m_indexingMetrics && !m_indexingMetrics->getTranslationUnits().empty()) {
+    m_indexingMetrics->setPeakMemoryByteSize(utility::getPeakMemoryUsage());
+    LOG_INFO("Indexing report:\n" + m_indexingMetrics->getSummary(time));
+    m_indexingMetrics->writeReport(UserPaths::getLogDirectoryPath(), time);
+  }
+
   StorageStats stats = m_storage->getStorageStats();
   DatabasePolicy policy = m_dialogView->finishedIndexingDialog(static_cast<size_t>(indexedSourceFileCount),
                                                                static_cast<size_t>(sourceFileCount),
@@ -7,12 +7,16 @@
 
 class DialogView;
 class FileRegister;
+class IndexingMetrics;
 class PersistentStorage;
 class StorageAccess;
 
 class TaskFinishParsing : public Task {
 public:
-  TaskFinishParsing(std::shared_ptr<PersistentStorage> storage, std::shared_ptr<DialogView> dialogView);
+  // the indexing metrics are reported if set
+  TaskFinishParsing(std::shared_ptr<PersistentStorage> storage,
+                    std::shared_ptr<DialogView> dialogView,
+                    std::shared_ptr<IndexingMetrics> indexingMetrics = nullptr);
 
   void terminate() override;
 
@@ -24,6 +28,7 @@ private:
 
   std::shared_ptr<PersistentStorage> m_storage;
   std::shared_ptr<DialogView> m_dialogView;
+  std::shared_ptr<IndexingMetrics> m_indexingMetrics;
 };
 
 #endif    // TASK_FINISH_PARSING_H
@@ -4,6 +4,8 @@
 
 #include "Storage.h"
 #include "StorageProvider.h"
+#include "TimeStamp.h"
+#include "tracing.h"
 
 TaskInjectStorage::TaskInjectStorage(std::shared_ptr<StorageProvider> storageProvider, std::weak_ptr<Storage> target)
     : m_storageProvider(std::move(storageProvider)), m_target(std::move(target)) {}
@@ -15,7 +17,11 @@ Task::TaskState TaskInjectStorage::doUpdate(std::shared_ptr<Blackboard> /*blackb
     std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeLargestStorage();
     if(source) {
       if(std::shared_ptr<Storage> target = m_target.lock()) {
+        TRACE("inject storage");
+        const TimeStamp start = TimeStamp::now();
         target->inject(source.get());
+        m_storageProvider->getIndexingMetrics()->addPhaseTime(
+            IndexingMetrics::Phase::Inject, TimeStamp::durationSeconds(start), source->getSourceLocationCount());
         return STATE_SUCCESS;
       }
     }
@@ -1,6 +1,8 @@
 #include "TaskMergeStorages.h"
 
 #include "StorageProvider.h"
+#include "TimeStamp.h"
+#include "tracing.h"
 
 TaskMergeStorages::TaskMergeStorages(std::shared_ptr<StorageProvider> storageProvider) : m_storageProvider(storageProvider) {}
 
@@ -12,7 +14,11 @@ Task::TaskState TaskMergeStorages::doUpdate(std::shared_ptr<Blackboard> /*blackb
     std::shared_ptr<IntermediateStorage> target = m_storageProvider->consumeSecondLargestStorage();
     std::shared_ptr<IntermediateStorage> source = m_storageProvider->consumeSecondLargestStorage();
     if(target && source) {
+      TRACE("merge storages");
+      const TimeStamp start = TimeStamp::now();
       target->inject(source.get());
+      m_storageProvider->getIndexingMetrics()->addPhaseTime(
+          IndexingMetrics::Phase::Merge, TimeStamp::durationSeconds(start), source->getSourceLocationCount());
       m_storageProvider->insert(target);
       return STATE_SUCCESS;
     } else {
@@ -1,5 +1,7 @@
 #include "Graph.h"
 
+#include <algorithm>
+
 #include "logging.h"
 
 Graph::Graph() : m_trailMode(TRAIL_NONE) {}
@@ -15,14 +17,14 @@ void Graph::clear() {
 }
 
 void Graph::forEachNode(std::function<void(Node*)> func) const {
-  for(const auto& node : m_nodes) {
-    func(node.second.get());
+  for(Node* node : m_nodes.getTokens()) {
+    func(node);
   }
 }
 
 void Graph::forEachEdge(std::function<void(Edge*)> func) const {
-  for(const auto& edge : m_edges) {
-    func(edge.second.get());
+  for(Edge* edge : m_edges.getTokens()) {
+    func(edge);
   }
 }
 
@@ -37,9 +39,7 @@ Node* Graph::createNode(Id id, NodeType type, NameHierarchy nameHierarchy, Defin
     return n;
   }
 
-  std::shared_ptr<Node> node = std::make_shared<Node>(id, type, std::move(nameHierarchy), definitionKind);
-  m_nodes.emplace(node->getId(), node);
-  return node.get();
+  return m_nodes.emplace(id, type, std::move(nameHierarchy), definitionKind);
 }
 
 Edge* Graph::createEdge(Id id, Edge::EdgeType type, Node* from, Node* to) {
@@ -53,9 +53,7 @@ Edge* Graph::createEdge(Id id, Edge::EdgeType type, Node* from, Node* to) {
     return nullptr;
   }
 
-  std::shared_ptr<Edge> edge = std::make_shared<Edge>(id, type, from, to);
-  m_edges.emplace(edge->getId(), edge);
-  return edge.get();
+  return m_edges.emplace(id, type, from, to);
 }
 
 size_t Graph::getNodeCount() const {
@@ -66,33 +64,32 @@ size_t Graph::getEdgeCount() const {
   return m_edges.size();
 }
 
+void Graph::reserveNodes(size_t nodeCount) {
+  m_nodes.reserve(nodeCount);
+}
+
+void Graph::reserveEdges(size_t edgeCount) {
+  m_edges.reserve(edgeCount);
+}
+
 Node* Graph::getNodeById(Id id) const {
-  std::map<Id, std::shared_ptr<Node>>::const_iterator it = m_nodes.find(id);
-  if(it != m_nodes.end()) {
-    return it->second.get();
-  }
-  return nullptr;
+  return m_nodes.find(id);
 }
 
 Edge* Graph::getEdgeById(Id id) const {
-  std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(id);
-  if(it != m_edges.end()) {
-    return it->second.get();
-  }
-  return nullptr;
+  return m_edges.find(id);
 }
 
-const std::map<Id, std::shared_ptr<Node>>& Graph::getNodes() const {
-  return m_nodes;
+const std::vector<Node*>& Graph::getNodes() const {
+  return m_nodes.getTokens();
 }
 
-const std::map<Id, std::shared_ptr<Edge>>& Graph::getEdges() const {
-  return m_edges;
+const std::vector<Edge*>& Graph::getEdges() const {
+  return m_edges.getTokens();
 }
 
 void Graph::removeNode(Node* node) {
-  std::map<Id, std::shared_ptr<Node>>::const_iterator it = m_nodes.find(node->getId());
-  if(it == m_nodes.end()) {
+  if(m_nodes.find(node->getId()) != node) {
     LOG_WARNING("Node was not found in the graph.");
     return;
   }
@@ -119,13 +116,13 @@ void Graph::removeNode(Node* node) {
     LOG_ERROR("Node still has edges.");
   }
 
-  m_nodes.erase(it);
+  m_nodes.erase(node->getId());
 }
 
 void Graph::removeEdge(Edge* edge) {
-  std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(edge->getId());
-  if(it == m_edges.end()) {
+  if(m_edges.find(edge->getId()) != edge) {
     LOG_WARNING("Edge was not found in the graph.");
+    return;
   }
 
   if(edge->getType() == Edge::EDGE_MEMBER) {
@@ -133,29 +130,19 @@ void Graph::removeEdge(Edge* edge) {
     return;
   }
 
-  m_edges.erase(it);
+  m_edges.erase(edge->getId());
 }
 
 Node* Graph::findNode(std::function<bool(Node*)> func) const {
-  std::map<Id, std::shared_ptr<Node>>::const_iterator it = find_if(
-      m_nodes.begin(), m_nodes.end(), [&func](const std::pair<Id, std::shared_ptr<Node>>& n) { return func(n.second.get()); });
-
-  if(it != m_nodes.end()) {
-    return it->second.get();
-  }
-
-  return nullptr;
+  const std::vector<Node*>& nodes = m_nodes.getTokens();
+  auto it = std::find_if(nodes.begin(), nodes.end(), func);
+  return it != nodes.end() ? *it : nullptr;
 }
 
 Edge* Graph::findEdge(std::function<bool(Edge*)> func) const {
-  std::map<Id, std::shared_ptr<Edge>>::const_iterator it = find_if(
-      m_edges.begin(), m_edges.end(), [func](const std::pair<Id, std::shared_ptr<Edge>>& e) { return func(e.second.get()); });
-
-  if(it != m_edges.end()) {
-    return it->second.get();
-  }
-
-  return nullptr;
+  const std::vector<Edge*>& edges = m_edges.getTokens();
+  auto it = std::find_if(edges.begin(), edges.end(), func);
+  return it != edges.end() ? *it : nullptr;
 }
 
 Token* Graph::findToken(std::function<bool(Token*)> func) const {
@@ -178,9 +165,7 @@ Node* Graph::addNodeAsPlainCopy(Node* node) {
     return n;
   }
 
-  std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
-  m_nodes.emplace(copy->getId(), copy);
-  return copy.get();
+  return m_nodes.emplace(*node);
 }
 
 Edge* Graph::addEdgeAsPlainCopy(Edge* edge) {
@@ -192,9 +177,7 @@ Edge* Graph::addEdgeAsPlainCopy(Edge* edge) {
   Node* from = addNodeAsPlainCopy(edge->getFrom());
   Node* to = addNodeAsPlainCopy(edge->getTo());
 
-  std::shared_ptr<Edge> copy = std::make_shared<Edge>(*edge, from, to);
-  m_edges.emplace(copy->getId(), copy);
-  return copy.get();
+  return m_edges.emplace(*edge, from, to);
 }
 
 Node* Graph::addNodeAndAllChildrenAsPlainCopy(Node* node) {
@@ -265,9 +248,8 @@ void Graph::printBasic(std::wostream& ostream) const {
 }
 
 void Graph::removeEdgeInternal(Edge* edge) {
-  std::map<Id, std::shared_ptr<Edge>>::const_iterator it = m_edges.find(edge->getId());
-  if(it != m_edges.end() && it->second.get() == edge) {
-    m_edges.erase(it);
+  if(m_edges.find(edge->getId()) == edge) {
+    m_edges.erase(edge->getId());
   }
 }
 
@@ -1,12 +1,12 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
-#include <deque>
-#include <map>
-#include <memory>
+#include <functional>
+#include <vector>
 
 #include "Edge.h"
 #include "Node.h"
+#include "TokenArena.h"
 
 class Graph {
 public:
@@ -27,11 +27,16 @@ public:
   size_t getNodeCount() const;
   size_t getEdgeCount() const;
 
+  // prepares the graph for bulk insertion of tokens
+  void reserveNodes(size_t nodeCount);
+  void reserveEdges(size_t edgeCount);
+
   Node* getNodeById(Id id) const;
   Edge* getEdgeById(Id id) const;
 
-  const std::map<Id, std::shared_ptr<Node>>& getNodes() const;
-  const std::map<Id, std::shared_ptr<Edge>>& getEdges() const;
+  // ordered by id
+  const std::vector<Node*>& getNodes() const;
+  const std::vector<Edge*>& getEdges() const;
 
   void removeNode(Node* node);
   void removeEdge(Edge* edge);
@@ -65,8 +70,9 @@ private:
 
   void removeEdgeInternal(Edge* edge);
 
-  std::map<Id, std::shared_ptr<Node>> m_nodes;
-  std::map<Id, std::shared_ptr<Edge>> m_edges;
+  // edges are declared last so they are destroyed before the nodes they refer to
+  TokenArena<Node> m_nodes;
+  TokenArena<Edge> m_edges;
 
   TrailMode m_trailMode;
   bool m_hasTrailOrigin;
@@ -74,12 +74,22 @@ size_t Node::getEdgeCount() const {
 }
 
 void Node::addEdge(Edge* edge) {
-  m_edges.emplace(edge->getId(), edge);
+  if(m_edges.empty() || m_edges.back()->getId() < edge->getId()) {
+    m_edges.push_back(edge);
+    return;
+  }
+
+  auto it = std::lower_bound(
+      m_edges.begin(), m_edges.end(), edge->getId(), [](const Edge* e, Id id) { return e->getId() < id; });
+  if(it == m_edges.end() || (*it)->getId() != edge->getId()) {
+    m_edges.insert(it, edge);
+  }
 }
 
 void Node::removeEdge(Edge* edge) {
-  auto it = m_edges.find(edge->getId());
-  if(it != m_edges.end()) {
+  auto it = std::lower_bound(
+      m_edges.begin(), m_edges.end(), edge->getId(), [](const Edge* e, Id id) { return e->getId() < id; });
+  if(it != m_edges.end() && (*it)->getId() == edge->getId()) {
     m_edges.erase(it);
   }
 }
@@ -114,10 +124,10 @@ bool Node::isParentOf(const Node* node) const {
 }
 
 Edge* Node::findEdge(std::function<bool(Edge*)> func) const {
-  auto it = find_if(m_edges.begin(), m_edges.end(), [func](std::pair<Id, Edge*> p) { return func(p.second); });
+  auto it = find_if(m_edges.begin(), m_edges.end(), func);
 
   if(it != m_edges.end()) {
-    return it->second;
+    return *it;
   }
 
   return nullptr;
@@ -128,45 +138,47 @@ Edge* Node::findEdgeOfType(Edge::TypeMask mask) const {
 }
 
 Edge* Node::findEdgeOfType(Edge::TypeMask mask, std::function<bool(Edge*)> func) const {
-  auto it = find_if(m_edges.begin(), m_edges.end(), [mask, func](std::pair<Id, Edge*> p) {
-    if(p.second->isType(mask)) {
-      return func(p.second);
+  auto it = find_if(m_edges.begin(), m_edges.end(), [mask, &func](Edge* e) {
+    if(e->isType(mask)) {
+      return func(e);
     }
     return false;
   });
 
   if(it != m_edges.end()) {
-    return it->second;
+    return *it;
   }
 
   return nullptr;
 }
 
 Node* Node::findChildNode(std::function<bool(Node*)> func) const {
-  auto it = find_if(m_edges.begin(), m_edges.end(), [&func](std::pair<Id, Edge*> p) {
-    if(p.second->getType() == Edge::EDGE_MEMBER) {
-      return func(p.second->getTo());
+  auto it = find_if(m_edges.begin(), m_edges.end(), [&func](Edge* e) {
+    if(e->getType() == Edge::EDGE_MEMBER) {
+      return func(e->getTo());
     }
     return false;
   });
 
   if(it != m_edges.end()) {
-    return it->second->getTo();
+    return (*it)->getTo();
   }
 
   return nullptr;
 }
 
 void Node::forEachEdge(std::function<void(Edge*)> func) const {
-  for_each(m_edges.begin(), m_edges.end(), [func](std::pair<Id, Edge*> p) { func(p.second); });
+  for(Edge* edge : m_edges) {
+    func(edge);
+  }
 }
 
 void Node::forEachEdgeOfType(Edge::TypeMask mask, std::function<void(Edge*)> func) const {
-  for_each(m_edges.begin(), m_edges.end(), [mask, func](std::pair<Id, Edge*> p) {
-    if(p.second->isType(mask)) {
-      func(p.second);
+  for(Edge* edge : m_edges) {
+    if(edge->isType(mask)) {
+      func(edge);
     }
-  });
+  }
 }
 
 void Node::forEachChildNode(std::function<void(Node*)> func) const {
@@ -3,8 +3,8 @@
 
 #include <algorithm>
 #include <functional>
-#include <map>
 #include <string>
+#include <vector>
 
 #include "DefinitionKind.h"
 #include "Edge.h"
@@ -64,7 +64,7 @@ public:
 private:
   void operator=(const Node&);
 
-  std::map<Id, Edge*> m_edges;
+  std::vector<Edge*> m_edges;    // sorted by id
 
   NodeType m_type;
   const NameHierarchy m_nameHierarchy;
@@ -52,7 +52,8 @@ ComponentType* Token::getComponent() const {
   for(const std::shared_ptr<TokenComponent>& component : m_components) {
     TokenComponent* componentPtr = component.get();
     if(typeid(ComponentType) == typeid(*componentPtr)) {
-      return dynamic_cast<ComponentType*>(component.get());
+      // the dynamic type matches exactly, no need to search the class hierarchy
+      return static_cast<ComponentType*>(componentPtr);
     }
   }
   return nullptr;
@@ -65,7 +66,7 @@ std::shared_ptr<ComponentType> Token::removeComponent() {
     TokenComponent* componentPtr = component.get();
     if(typeid(ComponentType) == typeid(*componentPtr)) {
       m_components.erase(m_components.begin() + static_cast<int>(i));
-      return std::dynamic_pointer_cast<ComponentType>(component);
+      return std::static_pointer_cast<ComponentType>(component);
     }
   }
   return nullptr;
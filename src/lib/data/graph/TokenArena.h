@@ -0,0 +1,118 @@
+#pragma once
+// STL
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+// internal
+#include "types.h"
+
+/**
+ * Owns the tokens of a graph in chunked contiguous storage with stable addresses and keeps flat, id sorted arrays of
+ * ids and token pointers for lookup by binary search and cache friendly iteration.
+ *
+ * Tokens mostly arrive in ascending id order from the storage, so keeping the arrays sorted is an append in the common
+ * case. Erased tokens are destroyed right away, their slots are released with the arena.
+ */
+template <typename TokenType>
+class TokenArena {
+public:
+  // the token is constructed from the arguments, the caller makes sure that its id is not used yet
+  template <typename... ArgTypes>
+  TokenType* emplace(ArgTypes&&... args);
+
+  [[nodiscard]] TokenType* find(Id id) const;
+
+  // returns false if there is no token with the id
+  bool erase(Id id);
+
+  void clear();
+  void reserve(size_t count);
+
+  [[nodiscard]] size_t size() const;
+
+  // ordered by id
+  [[nodiscard]] const std::vector<TokenType*>& getTokens() const;
+
+private:
+  std::deque<std::optional<TokenType>> m_slots;
+
+  // sorted by id, index aligned
+  std::vector<Id> m_ids;
+  std::vector<TokenType*> m_tokens;
+  std::vector<size_t> m_slotIndices;
+};
+
+template <typename TokenType>
+template <typename... ArgTypes>
+TokenType* TokenArena<TokenType>::emplace(ArgTypes&&... args) {
+  const size_t slotIndex = m_slots.size();
+  TokenType* token = &m_slots.emplace_back(std::in_place, std::forward<ArgTypes>(args)...).value();
+  const Id id = token->getId();
+
+  if(m_ids.empty() || m_ids.back() < id) {
+    m_ids.push_back(id);
+    m_tokens.push_back(token);
+    m_slotIndices.push_back(slotIndex);
+  } else {
+    const auto position = static_cast<std::ptrdiff_t>(std::lower_bound(m_ids.begin(), m_ids.end(), id) - m_ids.begin());
+    m_ids.insert(m_ids.begin() + position, id);
+    m_tokens.insert(m_tokens.begin() + position, token);
+    m_slotIndices.insert(m_slotIndices.begin() + position, slotIndex);
+  }
+
+  return token;
+}
+
+template <typename TokenType>
+TokenType* TokenArena<TokenType>::find(Id id) const {
+  const auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+  if(it == m_ids.end() || *it != id) {
+    return nullptr;
+  }
+  return m_tokens[static_cast<size_t>(it - m_ids.begin())];
+}
+
+template <typename TokenType>
+bool TokenArena<TokenType>::erase(Id id) {
+  const auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id);
+  if(it == m_ids.end() || *it != id) {
+    return false;
+  }
+
+  const auto position = it - m_ids.begin();
+  const size_t slotIndex = m_slotIndices[static_cast<size_t>(position)];
+
+  m_ids.erase(it);
+  m_tokens.erase(m_tokens.begin() + position);
+  m_slotIndices.erase(m_slotIndices.begin() + position);
+
+  m_slots[slotIndex].reset();
+  return true;
+}
+
+template <typename TokenType>
+void TokenArena<TokenType>::clear() {
+  m_ids.clear();
+  m_tokens.clear();
+  m_slotIndices.clear();
+  m_slots.clear();
+}
+
+template <typename TokenType>
+void TokenArena<TokenType>::reserve(size_t count) {
+  m_ids.reserve(count);
+  m_tokens.reserve(count);
+  m_slotIndices.reserve(count);
+}
+
+template <typename TokenType>
+size_t TokenArena<TokenType>::size() const {
+  return m_tokens.size();
+}
+
+template <typename TokenType>
+const std::vector<TokenType*>& TokenArena<TokenType>::getTokens() const {
+  return m_tokens;
+}
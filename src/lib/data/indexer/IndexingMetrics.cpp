@@ -0,0 +1,186 @@
+#include "IndexingMetrics.h"
+// STL
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+// fmt
+#include <fmt/format.h>
+// internal
+#include "logging.h"
+#include "utilityString.h"
+
+namespace {
+struct PhaseRow {
+  const char* name;
+  IndexingMetrics::PhaseMetrics metrics;
+};
+
+void writeCsvString(std::ostream& stream, const std::string& text) {
+  stream << '"';
+  for(const char c : text) {
+    stream << c;
+    if(c == '"') {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
+double getThroughput(size_t count, double time) {
+  return time > 0.0 ? static_cast<double>(count) / time : 0.0;
+}
+
+void addTime(IndexingMetrics::PhaseMetrics& metrics, double time, size_t sourceLocationCount) {
+  metrics.count++;
+  metrics.time += time;
+  metrics.maxTime = std::max(metrics.maxTime, time);
+  metrics.sourceLocationCount += sourceLocationCount;
+}
+
+// the indexer phases are accumulated from the translation units, the others are recorded in the main process
+std::vector<PhaseRow> getPhaseRows(const std::vector<TranslationUnitMetrics>& translationUnits,
+                                   const std::array<IndexingMetrics::PhaseMetrics, IndexingMetrics::PhaseCount>& phases) {
+  IndexingMetrics::PhaseMetrics index;
+  IndexingMetrics::PhaseMetrics transfer;
+  for(const TranslationUnitMetrics& unit : translationUnits) {
+    addTime(index, unit.indexTime, unit.sourceLocationCount);
+    addTime(transfer, unit.transferTime, unit.sourceLocationCount);
+  }
+
+  return {{"index", index},
+          {"transfer", transfer},
+          {"queue", phases[static_cast<size_t>(IndexingMetrics::Phase::Queue)]},
+          {"merge", phases[static_cast<size_t>(IndexingMetrics::Phase::Merge)]},
+          {"inject", phases[static_cast<size_t>(IndexingMetrics::Phase::Inject)]}};
+}
+}    // namespace
+
+void IndexingMetrics::addTranslationUnit(const TranslationUnitMetrics& metrics) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_translationUnits.push_back(metrics);
+}
+
+void IndexingMetrics::addPhaseTime(Phase phase, double time, size_t sourceLocationCount) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  addTime(m_phases[static_cast<size_t>(phase)], time, sourceLocationCount);
+}
+
+void IndexingMetrics::setPeakMemoryByteSize(size_t byteSize) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_peakMemoryByteSize = byteSize;
+}
+
+void IndexingMetrics::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_translationUnits.clear();
+  m_phases = {};
+  m_peakMemoryByteSize = 0;
+}
+
+std::vector<TranslationUnitMetrics> IndexingMetrics::getTranslationUnits() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_translationUnits;
+}
+
+IndexingMetrics::PhaseMetrics IndexingMetrics::getPhase(Phase phase) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_phases[static_cast<size_t>(phase)];
+}
+
+void IndexingMetrics::writeJson(std::ostream& stream, double totalTime) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  const std::vector<PhaseRow> phases = getPhaseRows(m_translationUnits, m_phases);
+
+  stream << std::fixed << std::setprecision(6);
+  stream << "{\n\"totalTime\":" << totalTime << ",\n\"peakProcessMemoryByteSize\":" << m_peakMemoryByteSize << ",\n\"phases\":{";
+  for(size_t i = 0; i < phases.size(); i++) {
+    const PhaseMetrics& metrics = phases[i].metrics;
+    stream << (i == 0 ? "\n" : ",\n") << '"' << phases[i].name << "\":{\"count\":" << metrics.count
+           << ",\"time\":" << metrics.time << ",\"maxTime\":" << metrics.maxTime
+           << ",\"sourceLocationCount\":" << metrics.sourceLocationCount << '}';
+  }
+  stream << "\n},\n\"translationUnits\":[";
+
+  for(size_t i = 0; i < m_translationUnits.size(); i++) {
+    const TranslationUnitMetrics& unit = m_translationUnits[i];
+    stream << (i == 0 ? "\n" : ",\n") << "{\"sourceFilePath\":";
+    utility::writeJsonString(stream, unit.sourceFilePath.str());
+    stream << ",\"processId\":" << unit.processId << ",\"indexTime\":" << unit.indexTime
+           << ",\"transferTime\":" << unit.transferTime << ",\"transferByteSize\":" << unit.transferByteSize
+           << ",\"nodeCount\":" << unit.nodeCount << ",\"edgeCount\":" << unit.edgeCount
+           << ",\"sourceLocationCount\":" << unit.sourceLocationCount
+           << ",\"occurrenceCount\":" << unit.occurrenceCount << ",\"errorCount\":" << unit.errorCount
+           << ",\"peakProcessMemoryByteSize\":" << unit.peakMemoryByteSize << '}';
+  }
+  stream << "\n]\n}\n";
+}
+
+void IndexingMetrics::writeCsv(std::ostream& stream) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  stream << "source_file_path,process_id,index_time,transfer_time,transfer_byte_size,node_count,edge_count,"
+            "source_location_count,occurrence_count,error_count,peak_process_memory_byte_size\n";
+
+  stream << std::fixed << std::setprecision(6);
+  for(const TranslationUnitMetrics& unit : m_translationUnits) {
+    writeCsvString(stream, unit.sourceFilePath.str());
+    stream << ',' << unit.processId << ',' << unit.indexTime << ',' << unit.transferTime << ',' << unit.transferByteSize << ','
+           << unit.nodeCount << ',' << unit.edgeCount << ',' << unit.sourceLocationCount << ',' << unit.occurrenceCount << ','
+           << unit.errorCount << ',' << unit.peakMemoryByteSize << '\n';
+  }
+}
+
+std::string IndexingMetrics::getSummary(double totalTime) const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  size_t transferByteSize = 0;
+  size_t peakIndexerMemoryByteSize = 0;
+  for(const TranslationUnitMetrics& unit : m_translationUnits) {
+    transferByteSize += unit.transferByteSize;
+    peakIndexerMemoryByteSize = std::max(peakIndexerMemoryByteSize, unit.peakMemoryByteSize);
+  }
+
+  const std::vector<PhaseRow> phases = getPhaseRows(m_translationUnits, m_phases);
+
+  std::string summary = fmt::format("{:<10}{:>10}{:>12}{:>12}{:>16}\n", "phase", "count", "time [s]", "max [s]", "locations/s");
+  for(const PhaseRow& row : phases) {
+    summary += fmt::format("{:<10}{:>10}{:>12.3f}{:>12.3f}{:>16.0f}\n",
+                           row.name,
+                           row.metrics.count,
+                           row.metrics.time,
+                           row.metrics.maxTime,
+                           getThroughput(row.metrics.sourceLocationCount, row.metrics.time));
+  }
+
+  summary += fmt::format("translation units: {} in {:.3f} s ({:.2f}/s), transferred {} KB\n",
+                         m_translationUnits.size(),
+                         totalTime,
+                         getThroughput(m_translationUnits.size(), totalTime),
+                         transferByteSize / 1024);
+  if(peakIndexerMemoryByteSize > 0) {
+    summary += fmt::format("peak process memory: indexer {} MB, ", peakIndexerMemoryByteSize / (1024 * 1024));
+  } else {
+    summary += "peak process memory: ";
+  }
+  summary += fmt::format("application {} MB", m_peakMemoryByteSize / (1024 * 1024));
+  return summary;
+}
+
+bool IndexingMetrics::writeReport(const FilePath& directoryPath, double totalTime) const {
+  const FilePath jsonFilePath = directoryPath.getConcatenated(L"indexing_report.json");
+  const FilePath csvFilePath = directoryPath.getConcatenated(L"indexing_report.csv");
+
+  std::ofstream jsonStream(jsonFilePath.str());
+  std::ofstream csvStream(csvFilePath.str());
+  if(!jsonStream || !csvStream) {
+    LOG_WARNING(fmt::format("Unable to write indexing report to {}", directoryPath.str()));
+    return false;
+  }
+
+  writeJson(jsonStream, totalTime);
+  writeCsv(csvStream);
+
+  LOG_INFO(fmt::format("Indexing report written to {}", jsonFilePath.str()));
+  return static_cast<bool>(jsonStream) && static_cast<bool>(csvStream);
+}
@@ -0,0 +1,75 @@
+#pragma once
+// STL
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+// internal
+#include "FilePath.h"
+#include "types.h"
+
+struct TranslationUnitMetrics {
+  FilePath sourceFilePath;
+  Id processId = 0;
+
+  // seconds spent parsing and traversing the translation unit
+  double indexTime = 0.0;
+  // seconds spent copying the intermediate storage into shared memory
+  double transferTime = 0.0;
+  size_t transferByteSize = 0;
+
+  size_t nodeCount = 0;
+  size_t edgeCount = 0;
+  size_t sourceLocationCount = 0;
+  size_t occurrenceCount = 0;
+  size_t errorCount = 0;
+
+  // process-wide high-water mark of the indexer process after the translation unit was indexed, 0 for indexing in
+  // the application process
+  size_t peakMemoryByteSize = 0;
+};
+
+/**
+ * Collects the metrics of an indexing run: one record per indexed translation unit as reported by the indexers and
+ * the accumulated times of the phases the intermediate storages pass in the main process. The report is written as
+ * json and as csv with one row per translation unit. All functions are thread safe.
+ */
+class IndexingMetrics {
+public:
+  enum class Phase { Queue = 0, Merge, Inject };
+  static constexpr size_t PhaseCount = 3;
+
+  struct PhaseMetrics {
+    size_t count = 0;
+    double time = 0.0;
+    double maxTime = 0.0;
+    size_t sourceLocationCount = 0;
+  };
+
+  void addTranslationUnit(const TranslationUnitMetrics& metrics);
+  void addPhaseTime(Phase phase, double time, size_t sourceLocationCount);
+
+  // process-wide high-water mark of the application process, includes indexer threads
+  void setPeakMemoryByteSize(size_t byteSize);
+
+  void clear();
+
+  [[nodiscard]] std::vector<TranslationUnitMetrics> getTranslationUnits() const;
+  [[nodiscard]] PhaseMetrics getPhase(Phase phase) const;
+
+  void writeJson(std::ostream& stream, double totalTime) const;
+  void writeCsv(std::ostream& stream) const;
+
+  // table of the phases with their times and throughput, ready to be logged
+  [[nodiscard]] std::string getSummary(double totalTime) const;
+
+  // writes indexing_report.json and indexing_report.csv into the directory
+  bool writeReport(const FilePath& directoryPath, double totalTime) const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector<TranslationUnitMetrics> m_translationUnits;
+  std::array<PhaseMetrics, PhaseCount> m_phases;
+  size_t m_peakMemoryByteSize = 0;
+};
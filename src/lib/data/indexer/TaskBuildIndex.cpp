@@ -74,6 +74,8 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
 
   blackboard->get<bool>("indexer_command_queue_stopped", m_indexerCommandQueueStopped);
 
+  collectTranslationUnitMetrics();
+
   const std::vector<FilePath> indexingFiles = m_interprocessIndexingStatusManager.getCurrentlyIndexedSourceFilePaths();
   if(!indexingFiles.empty()) {
     updateIndexingDialog(blackboard, indexingFiles);
@@ -92,7 +94,12 @@ Task::TaskState TaskBuildIndex::doUpdate(std::shared_ptr<Blackboard> blackboard)
     updateIndexingDialog(blackboard, std::vector<FilePath>());
   }
 
-  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  {
+    // intermediate storages arrive via shared memory and still need polling, but a finishing indexer wakes us up
+    std::unique_lock<std::mutex> lock(m_runningThreadCountMutex);
+    m_runningThreadCountCondition.wait_for(
+        lock, std::chrono::milliseconds(50), [this, runningThreadCount]() { return m_runningThreadCount < runningThreadCount; });
+  }
 
   return STATE_RUNNING;
 }
@@ -108,6 +115,7 @@ void TaskBuildIndex::doExit(std::shared_ptr<Blackboard> blackboard) {
     while(fetchIntermediateStorages(blackboard))
       ;
   }
+  collectTranslationUnitMetrics();
 
   std::vector<FilePath> crashedFiles = m_interprocessIndexingStatusManager.getCrashedSourceFilePaths();
   if(!crashedFiles.empty()) {
@@ -179,11 +187,12 @@ void TaskBuildIndex::runIndexerProcess(int processId, const std::wstring& logFil
     std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
     m_runningThreadCount--;
   }
+  m_runningThreadCountCondition.notify_all();
 }
 
 void TaskBuildIndex::runIndexerThread(int processId) {
   do {
-    InterprocessIndexer indexer(m_appUUID, processId);
+    InterprocessIndexer indexer(m_appUUID, processId, false);
     indexer.work();    // this will only return if there are no indexer commands left in the queue
     if(!m_interrupted) {
       // sleeping if interrupted may result in a crash due to objects that are already
@@ -196,6 +205,7 @@ void TaskBuildIndex::runIndexerThread(int processId) {
     std::lock_guard<std::mutex> lock(m_runningThreadCountMutex);
     m_runningThreadCount--;
   }
+  m_runningThreadCountCondition.notify_all();
 }
 
 bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard) {
@@ -238,6 +248,13 @@ bool TaskBuildIndex::fetchIntermediateStorages(std::shared_ptr<Blackboard> black
   return false;
 }
 
+void TaskBuildIndex::collectTranslationUnitMetrics() {
+  std::shared_ptr<IndexingMetrics> indexingMetrics = m_storageProvider->getIndexingMetrics();
+  for(const TranslationUnitMetrics& metrics : m_interprocessIndexingStatusManager.popTranslationUnitMetrics()) {
+    indexingMetrics->addTranslationUnit(metrics);
+  }
+}
+
 void TaskBuildIndex::updateIndexingDialog(std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths) {
   // TODO: factor in unindexed files...
   int sourceFileCount = 0;
@@ -1,6 +1,7 @@
 #ifndef TASK_BUILD_INDEX_H
 #define TASK_BUILD_INDEX_H
 
+#include <condition_variable>
 #include <thread>
 
 #include "../../../scheduling/Task.h"
@@ -36,6 +37,7 @@ protected:
   void runIndexerProcess(int processId, const std::wstring& logFilePath);
   void runIndexerThread(int processId);
   bool fetchIntermediateStorages(std::shared_ptr<Blackboard> blackboard);
+  void collectTranslationUnitMetrics();
   void updateIndexingDialog(std::shared_ptr<Blackboard> blackboard, const std::vector<FilePath>& sourcePaths);
 
   static const std::wstring s_processName;
@@ -58,6 +60,7 @@ protected:
 
   size_t m_runningThreadCount;
   std::mutex m_runningThreadCountMutex;
+  std::condition_variable m_runningThreadCountCondition;
 };
 
 #endif    // TASK_PARSE_H
@@ -159,6 +159,7 @@ void TaskExecuteCustomCommands::executeParallelIndexerCommands(int threadId, std
         }
         storage = std::make_shared<PersistentStorage>(databaseFilePath, FilePath());
         storage->setup();
+        // keeps the default profile, the database is written by the custom command's process
         storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
         storage->buildCaches();
       }
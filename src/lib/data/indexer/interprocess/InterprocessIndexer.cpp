@@ -4,16 +4,21 @@
 // internal
 #include "IndexerCommand.h"
 #include "IndexerComposite.h"
+#include "IntermediateStorage.h"
 #include "LanguagePackageManager.h"
 #include "logging.h"
 #include "ScopedFunctor.h"
+#include "TimeStamp.h"
+#include "tracing.h"
+#include "utilityApp.h"
 
-InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId)
+InterprocessIndexer::InterprocessIndexer(const std::string& uuid, Id processId, bool ownProcess)
     : m_interprocessIndexerCommandManager(uuid, processId, false)
     , m_interprocessIndexingStatusManager(uuid, processId, false)
     , m_interprocessIntermediateStorageManager(uuid, processId, false)
     , m_uuid(uuid)
-    , m_processId(processId) {}
+    , m_processId(processId)
+    , m_ownProcess(ownProcess) {}
 
 void InterprocessIndexer::work() {
   bool updaterThreadRunning = true;
@@ -68,16 +73,40 @@ void InterprocessIndexer::work() {
       LOG_INFO(fmt::format("{} updating indexer status with currently indexed filepath", m_processId));
       m_interprocessIndexingStatusManager.startIndexingSourceFile(pIndexerCommand->getSourceFilePath());
 
+      TranslationUnitMetrics metrics;
+      metrics.sourceFilePath = pIndexerCommand->getSourceFilePath();
+      metrics.processId = m_processId;
+
       LOG_INFO(fmt::format("{} starting to index current file", m_processId));
-      auto pResult = pIndexer->index(pIndexerCommand);
+      std::shared_ptr<IntermediateStorage> pResult;
+      {
+        TRACE("index file");
+        const TimeStamp indexStart = TimeStamp::now();
+        pResult = pIndexer->index(pIndexerCommand);
+        metrics.indexTime = TimeStamp::durationSeconds(indexStart);
+      }
 
       if(pResult) {
+        TRACE("push intermediate storage");
         LOG_INFO(fmt::format("{} spushing index to shared memory", m_processId));
+        const TimeStamp transferStart = TimeStamp::now();
         m_interprocessIntermediateStorageManager.pushIntermediateStorage(pResult);
+        metrics.transferTime = TimeStamp::durationSeconds(transferStart);
+
+        metrics.transferByteSize = pResult->getByteSize(sizeof(SharedMemory::String));
+        metrics.nodeCount = pResult->getStorageNodes().size();
+        metrics.edgeCount = pResult->getStorageEdges().size();
+        metrics.sourceLocationCount = pResult->getStorageSourceLocations().size();
+        metrics.occurrenceCount = pResult->getStorageOccurrences().size();
+        metrics.errorCount = pResult->getErrors().size();
+      }
+      // the peak memory is process-wide, for an indexer thread it would be the one of the whole application
+      if(m_ownProcess) {
+        metrics.peakMemoryByteSize = utility::getPeakMemoryUsage();
       }
 
       LOG_INFO(fmt::format("{} sfinalizing indexer status for current file", m_processId));
-      m_interprocessIndexingStatusManager.finishIndexingSourceFile();
+      m_interprocessIndexingStatusManager.finishIndexingSourceFile(metrics);
 
       LOG_INFO(fmt::format("{} sall done", m_processId));
     }
@@ -6,7 +6,8 @@
 
 class InterprocessIndexer final {
 public:
-  InterprocessIndexer(const std::string& uuid, Id processId);
+  // ownProcess is false when the indexer runs in a thread of the application
+  InterprocessIndexer(const std::string& uuid, Id processId, bool ownProcess);
 
   void work();
 
@@ -17,4 +18,5 @@ private:
 
   const std::string m_uuid;
   const Id m_processId;
+  const bool m_ownProcess;
 };
\ No newline at end of file
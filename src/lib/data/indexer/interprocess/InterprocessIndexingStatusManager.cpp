@@ -1,6 +1,7 @@
 #include "InterprocessIndexingStatusManager.h"
 
 #include "logging.h"
+#include "SharedTranslationUnitMetrics.h"
 #include "utilityString.h"
 
 const char* InterprocessIndexingStatusManager::s_sharedMemoryNamePrefix = "ists_";
@@ -10,6 +11,7 @@ const char* InterprocessIndexingStatusManager::s_currentFilesKeyName = "current_
 const char* InterprocessIndexingStatusManager::s_crashedFilesKeyName = "crashed_files";
 const char* InterprocessIndexingStatusManager::s_finishedProcessIdsKeyName = "finished_process_ids";
 const char* InterprocessIndexingStatusManager::s_indexingInterruptedKeyName = "indexing_interrupted_flag";
+const char* InterprocessIndexingStatusManager::s_translationUnitMetricsKeyName = "translation_unit_metrics";
 
 InterprocessIndexingStatusManager::InterprocessIndexingStatusManager(const std::string& instanceUuid, Id processId, bool isOwner)
     : BaseInterprocessDataManager(s_sharedMemoryNamePrefix + instanceUuid, 1048576 /* 1 MB */, instanceUuid, processId, isOwner) {}
@@ -70,9 +72,23 @@ void InterprocessIndexingStatusManager::startIndexingSourceFile(const FilePath&
   }
 }
 
-void InterprocessIndexingStatusManager::finishIndexingSourceFile() {
+void InterprocessIndexingStatusManager::finishIndexingSourceFile(const TranslationUnitMetrics& metrics) {
   SharedMemory::ScopedAccess access(&m_sharedMemory);
 
+  const size_t overestimationMultiplier = 3;
+  const size_t estimatedSize = (sizeof(SharedTranslationUnitMetrics) + metrics.sourceFilePath.str().size()) *
+      overestimationMultiplier;
+  if(access.getFreeMemorySize() < estimatedSize) {
+    access.growMemory(access.getMemorySize());
+  }
+
+  SharedMemory::Queue<SharedTranslationUnitMetrics>* metricsPtr =
+      access.accessValueWithAllocator<SharedMemory::Queue<SharedTranslationUnitMetrics>>(s_translationUnitMetricsKeyName);
+  if(metricsPtr) {
+    metricsPtr->push_back(SharedTranslationUnitMetrics(access.getAllocator()));
+    metricsPtr->back().fromLocal(metrics);
+  }
+
   SharedMemory::Map<Id, SharedMemory::String>* currentFilesPtr =
       access.accessValueWithAllocator<SharedMemory::Map<Id, SharedMemory::String>>(s_currentFilesKeyName);
   if(currentFilesPtr) {
@@ -161,3 +177,20 @@ std::vector<FilePath> InterprocessIndexingStatusManager::getCrashedSourceFilePat
 
   return crashedFiles;
 }
+
+std::vector<TranslationUnitMetrics> InterprocessIndexingStatusManager::popTranslationUnitMetrics() {
+  std::vector<TranslationUnitMetrics> metrics;
+
+  SharedMemory::ScopedAccess access(&m_sharedMemory);
+
+  SharedMemory::Queue<SharedTranslationUnitMetrics>* metricsPtr =
+      access.accessValueWithAllocator<SharedMemory::Queue<SharedTranslationUnitMetrics>>(s_translationUnitMetricsKeyName);
+  if(metricsPtr) {
+    while(metricsPtr->size()) {
+      metrics.push_back(metricsPtr->front().toLocal());
+      metricsPtr->pop_front();
+    }
+  }
+
+  return metrics;
+}
@@ -5,6 +5,7 @@
 
 #include "BaseInterprocessDataManager.h"
 #include "FilePath.h"
+#include "IndexingMetrics.h"
 
 class InterprocessIndexingStatusManager : public BaseInterprocessDataManager {
 public:
@@ -12,7 +13,7 @@ public:
   virtual ~InterprocessIndexingStatusManager();
 
   void startIndexingSourceFile(const FilePath& filePath);
-  void finishIndexingSourceFile();
+  void finishIndexingSourceFile(const TranslationUnitMetrics& metrics);
 
   void setIndexingInterrupted(bool interrupted);
   bool getIndexingInterrupted();
@@ -22,6 +23,9 @@ public:
   std::vector<FilePath> getCurrentlyIndexedSourceFilePaths();
   std::vector<FilePath> getCrashedSourceFilePaths();
 
+  // returns and removes the metrics of the translation units finished since the last call
+  std::vector<TranslationUnitMetrics> popTranslationUnitMetrics();
+
 private:
   static const char* s_sharedMemoryNamePrefix;
 
@@ -30,6 +34,7 @@ private:
   static const char* s_crashedFilesKeyName;
   static const char* s_finishedProcessIdsKeyName;
   static const char* s_indexingInterruptedKeyName;
+  static const char* s_translationUnitMetricsKeyName;
 };
 
 #endif    // INTERPROCESS_INDEXING_STATUS_MANAGER_H
@@ -0,0 +1,46 @@
+#include "SharedTranslationUnitMetrics.h"
+
+#include "utilityString.h"
+
+SharedTranslationUnitMetrics::SharedTranslationUnitMetrics(SharedMemory::Allocator* allocator)
+    : m_sourceFilePath("", allocator)
+    , m_processId(0)
+    , m_indexTime(0.0)
+    , m_transferTime(0.0)
+    , m_transferByteSize(0)
+    , m_nodeCount(0)
+    , m_edgeCount(0)
+    , m_sourceLocationCount(0)
+    , m_occurrenceCount(0)
+    , m_errorCount(0)
+    , m_peakMemoryByteSize(0) {}
+
+void SharedTranslationUnitMetrics::fromLocal(const TranslationUnitMetrics& metrics) {
+  m_sourceFilePath = utility::encodeToUtf8(metrics.sourceFilePath.wstr()).c_str();
+  m_processId = metrics.processId;
+  m_indexTime = metrics.indexTime;
+  m_transferTime = metrics.transferTime;
+  m_transferByteSize = metrics.transferByteSize;
+  m_nodeCount = metrics.nodeCount;
+  m_edgeCount = metrics.edgeCount;
+  m_sourceLocationCount = metrics.sourceLocationCount;
+  m_occurrenceCount = metrics.occurrenceCount;
+  m_errorCount = metrics.errorCount;
+  m_peakMemoryByteSize = metrics.peakMemoryByteSize;
+}
+
+TranslationUnitMetrics SharedTranslationUnitMetrics::toLocal() const {
+  TranslationUnitMetrics metrics;
+  metrics.sourceFilePath = FilePath(utility::decodeFromUtf8(m_sourceFilePath.c_str()));
+  metrics.processId = m_processId;
+  metrics.indexTime = m_indexTime;
+  metrics.transferTime = m_transferTime;
+  metrics.transferByteSize = m_transferByteSize;
+  metrics.nodeCount = m_nodeCount;
+  metrics.edgeCount = m_edgeCount;
+  metrics.sourceLocationCount = m_sourceLocationCount;
+  metrics.occurrenceCount = m_occurrenceCount;
+  metrics.errorCount = m_errorCount;
+  metrics.peakMemoryByteSize = m_peakMemoryByteSize;
+  return metrics;
+}
@@ -0,0 +1,31 @@
+#ifndef SHARED_TRANSLATION_UNIT_METRICS_H
+#define SHARED_TRANSLATION_UNIT_METRICS_H
+
+#include "IndexingMetrics.h"
+#include "SharedMemory.h"
+
+class SharedTranslationUnitMetrics {
+public:
+  SharedTranslationUnitMetrics(SharedMemory::Allocator* allocator);
+
+  void fromLocal(const TranslationUnitMetrics& metrics);
+  TranslationUnitMetrics toLocal() const;
+
+private:
+  SharedMemory::String m_sourceFilePath;
+  Id m_processId;
+
+  double m_indexTime;
+  double m_transferTime;
+  size_t m_transferByteSize;
+
+  size_t m_nodeCount;
+  size_t m_edgeCount;
+  size_t m_sourceLocationCount;
+  size_t m_occurrenceCount;
+  size_t m_errorCount;
+
+  size_t m_peakMemoryByteSize;
+};
+
+#endif    // SHARED_TRANSLATION_UNIT_METRICS_H
@@ -2,6 +2,7 @@
 
 #include "../../../scheduling/Blackboard.h"
 #include "DialogView.h"
+#include "IApplicationSettings.hpp"
 #include "PersistentStorage.h"
 
 TaskParseWrapper::TaskParseWrapper(std::weak_ptr<PersistentStorage> storage, std::shared_ptr<DialogView> dialogView)
@@ -19,6 +20,9 @@ void TaskParseWrapper::doEnter(std::shared_ptr<Blackboard> blackboard) {
   if(sourceFileCount > 0) {
     if(std::shared_ptr<PersistentStorage> storage = m_storage.lock()) {
       storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+      // the temporary database is only written by this process, indexer processes write to their own databases
+      storage->setProfile(
+          SqliteStorage::intToStorageProfileType(IApplicationSettings::getInstanceRaw()->getIndexingStorageProfile()));
     }
   }
 }
@@ -28,6 +32,11 @@ Task::TaskState TaskParseWrapper::doUpdate(std::shared_ptr<Blackboard> blackboar
 }
 
 void TaskParseWrapper::doExit(std::shared_ptr<Blackboard> blackboard) {
+  // custom commands run next and write to the temporary database from other processes
+  if(std::shared_ptr<PersistentStorage> storage = m_storage.lock()) {
+    storage->setProfile(SqliteStorage::STORAGE_PROFILE_DEFAULT);
+  }
+
   float duration = static_cast<float>(TimeStamp::durationSeconds(m_start));
   blackboard->update<float>("index_time", [duration](float currentDuration) { return currentDuration + duration; });
 }
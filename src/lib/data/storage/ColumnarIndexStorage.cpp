@@ -0,0 +1,265 @@
+#include "ColumnarIndexStorage.h"
+
+#include <algorithm>
+
+#include "SqliteIndexStorage.h"
+#include "utilityString.h"
+
+namespace {
+template <typename T>
+void growColumn(std::vector<T>& column, size_t size, const T& value) {
+  if(column.size() < size) {
+    column.resize(size, value);
+  }
+}
+}    // namespace
+
+void ColumnarIndexStorage::load(const SqliteIndexStorage& storage) {
+  clear();
+
+  storage.scan<SqliteIndexStorage::NodeRow>(
+      [this](const SqliteIndexStorage::NodeRow& node) { addNode(node.id, node.type, node.serializedName); });
+  storage.scan<StorageEdge>([this](const StorageEdge& edge) { addEdge(edge); });
+  storage.scan<StorageOccurrence>([this](const StorageOccurrence& occurrence) { addOccurrence(occurrence); });
+  storage.scan<StorageSourceLocation>([this](const StorageSourceLocation& location) { addSourceLocation(location); });
+
+  finishSetup();
+}
+
+void ColumnarIndexStorage::clear() {
+  m_nodeTypes.clear();
+  m_nodeNameOffsets.clear();
+  m_nodeNameSizes.clear();
+  m_nodeNames.clear();
+  m_nodeCount = 0;
+
+  m_edgeTypes.clear();
+  m_edgeSourceIds.clear();
+  m_edgeTargetIds.clear();
+  m_edgeIdsBySource.clear();
+  m_edgeIdsByTarget.clear();
+
+  m_occurrencesByElement.clear();
+  m_occurrencesByLocation.clear();
+
+  m_locationFileNodeIds.clear();
+  m_locationStartLines.clear();
+  m_locationStartCols.clear();
+  m_locationEndLines.clear();
+  m_locationEndCols.clear();
+  m_locationTypes.clear();
+}
+
+void ColumnarIndexStorage::addNode(Id id, int type, std::string_view serializedNameUtf8) {
+  growColumn(m_nodeTypes, id + 1, -1);
+  growColumn(m_nodeNameOffsets, id + 1, size_t(0));
+  growColumn(m_nodeNameSizes, id + 1, uint32_t(0));
+
+  if(m_nodeTypes[id] == -1) {
+    m_nodeCount++;
+  }
+
+  m_nodeTypes[id] = type;
+  m_nodeNameOffsets[id] = m_nodeNames.size();
+  m_nodeNameSizes[id] = static_cast<uint32_t>(serializedNameUtf8.size());
+  m_nodeNames.append(serializedNameUtf8);
+}
+
+void ColumnarIndexStorage::addEdge(const StorageEdge& edge) {
+  growColumn(m_edgeTypes, edge.id + 1, -1);
+  growColumn(m_edgeSourceIds, edge.id + 1, uint32_t(0));
+  growColumn(m_edgeTargetIds, edge.id + 1, uint32_t(0));
+
+  if(m_edgeTypes[edge.id] == -1) {
+    m_edgeIdsBySource.push_back(static_cast<uint32_t>(edge.id));
+    m_edgeIdsByTarget.push_back(static_cast<uint32_t>(edge.id));
+  }
+
+  m_edgeTypes[edge.id] = edge.type;
+  m_edgeSourceIds[edge.id] = static_cast<uint32_t>(edge.sourceNodeId);
+  m_edgeTargetIds[edge.id] = static_cast<uint32_t>(edge.targetNodeId);
+}
+
+void ColumnarIndexStorage::addOccurrence(const StorageOccurrence& occurrence) {
+  m_occurrencesByElement.emplace_back(static_cast<uint32_t>(occurrence.elementId),
+                                      static_cast<uint32_t>(occurrence.sourceLocationId));
+  m_occurrencesByLocation.emplace_back(static_cast<uint32_t>(occurrence.sourceLocationId),
+                                       static_cast<uint32_t>(occurrence.elementId));
+}
+
+void ColumnarIndexStorage::addSourceLocation(const StorageSourceLocation& location) {
+  const size_t size = location.id + 1;
+  growColumn(m_locationFileNodeIds, size, uint32_t(0));
+  growColumn(m_locationStartLines, size, uint32_t(0));
+  growColumn(m_locationStartCols, size, uint32_t(0));
+  growColumn(m_locationEndLines, size, uint32_t(0));
+  growColumn(m_locationEndCols, size, uint32_t(0));
+  growColumn(m_locationTypes, size, 0);
+
+  m_locationFileNodeIds[location.id] = static_cast<uint32_t>(location.fileNodeId);
+  m_locationStartLines[location.id] = static_cast<uint32_t>(location.startLine);
+  m_locationStartCols[location.id] = static_cast<uint32_t>(location.startCol);
+  m_locationEndLines[location.id] = static_cast<uint32_t>(location.endLine);
+  m_locationEndCols[location.id] = static_cast<uint32_t>(location.endCol);
+  m_locationTypes[location.id] = location.type;
+}
+
+void ColumnarIndexStorage::finishSetup() {
+  std::sort(m_edgeIdsBySource.begin(), m_edgeIdsBySource.end(), [this](uint32_t a, uint32_t b) {
+    return std::make_pair(m_edgeSourceIds[a], a) < std::make_pair(m_edgeSourceIds[b], b);
+  });
+  std::sort(m_edgeIdsByTarget.begin(), m_edgeIdsByTarget.end(), [this](uint32_t a, uint32_t b) {
+    return std::make_pair(m_edgeTargetIds[a], a) < std::make_pair(m_edgeTargetIds[b], b);
+  });
+
+  std::sort(m_occurrencesByElement.begin(), m_occurrencesByElement.end());
+  m_occurrencesByElement.erase(std::unique(m_occurrencesByElement.begin(), m_occurrencesByElement.end()),
+                               m_occurrencesByElement.end());
+  std::sort(m_occurrencesByLocation.begin(), m_occurrencesByLocation.end());
+  m_occurrencesByLocation.erase(std::unique(m_occurrencesByLocation.begin(), m_occurrencesByLocation.end()),
+                                m_occurrencesByLocation.end());
+
+  m_nodeNames.shrink_to_fit();
+}
+
+size_t ColumnarIndexStorage::getNodeCount() const {
+  return m_nodeCount;
+}
+
+size_t ColumnarIndexStorage::getEdgeCount() const {
+  return m_edgeIdsBySource.size();
+}
+
+StorageNode ColumnarIndexStorage::getNodeById(Id id) const {
+  if(!hasNode(id)) {
+    return StorageNode();
+  }
+
+  return StorageNode(
+      id, m_nodeTypes[id], utility::decodeFromUtf8(m_nodeNames.substr(m_nodeNameOffsets[id], m_nodeNameSizes[id])));
+}
+
+std::vector<StorageNode> ColumnarIndexStorage::getNodesByIds(const std::vector<Id>& ids) const {
+  std::vector<StorageNode> nodes;
+  for(Id id : getSortedUniqueIds(ids)) {
+    if(hasNode(id)) {
+      nodes.push_back(getNodeById(id));
+    }
+  }
+  return nodes;
+}
+
+StorageEdge ColumnarIndexStorage::getEdgeById(Id id) const {
+  if(!hasEdge(id)) {
+    return StorageEdge();
+  }
+
+  return StorageEdge(id, m_edgeTypes[id], m_edgeSourceIds[id], m_edgeTargetIds[id]);
+}
+
+std::vector<StorageEdge> ColumnarIndexStorage::getEdgesByIds(const std::vector<Id>& ids) const {
+  std::vector<StorageEdge> edges;
+  for(Id id : getSortedUniqueIds(ids)) {
+    if(hasEdge(id)) {
+      edges.push_back(getEdgeById(id));
+    }
+  }
+  return edges;
+}
+
+std::vector<StorageEdge> ColumnarIndexStorage::getEdgesBySourceIds(const std::vector<Id>& sourceIds) const {
+  return getEdgesByNodeIds(sourceIds, m_edgeIdsBySource, m_edgeSourceIds);
+}
+
+std::vector<StorageEdge> ColumnarIndexStorage::getEdgesByTargetIds(const std::vector<Id>& targetIds) const {
+  return getEdgesByNodeIds(targetIds, m_edgeIdsByTarget, m_edgeTargetIds);
+}
+
+std::vector<StorageOccurrence> ColumnarIndexStorage::getOccurrencesForElementIds(const std::vector<Id>& elementIds) const {
+  std::vector<StorageOccurrence> occurrences;
+  for(const auto& [elementId, locationId] : getOccurrencePairs(elementIds, m_occurrencesByElement)) {
+    occurrences.emplace_back(elementId, locationId);
+  }
+  return occurrences;
+}
+
+std::vector<StorageOccurrence> ColumnarIndexStorage::getOccurrencesForLocationIds(const std::vector<Id>& locationIds) const {
+  std::vector<StorageOccurrence> occurrences;
+  for(const auto& [locationId, elementId] : getOccurrencePairs(locationIds, m_occurrencesByLocation)) {
+    occurrences.emplace_back(elementId, locationId);
+  }
+  return occurrences;
+}
+
+StorageSourceLocation ColumnarIndexStorage::getSourceLocationById(Id id) const {
+  if(!hasSourceLocation(id)) {
+    return StorageSourceLocation();
+  }
+
+  return StorageSourceLocation(id,
+                               m_locationFileNodeIds[id],
+                               m_locationStartLines[id],
+                               m_locationStartCols[id],
+                               m_locationEndLines[id],
+                               m_locationEndCols[id],
+                               m_locationTypes[id]);
+}
+
+std::vector<StorageSourceLocation> ColumnarIndexStorage::getSourceLocationsByIds(const std::vector<Id>& ids) const {
+  std::vector<StorageSourceLocation> locations;
+  for(Id id : getSortedUniqueIds(ids)) {
+    if(hasSourceLocation(id)) {
+      locations.push_back(getSourceLocationById(id));
+    }
+  }
+  return locations;
+}
+
+std::vector<Id> ColumnarIndexStorage::getSortedUniqueIds(std::vector<Id> ids) {
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+bool ColumnarIndexStorage::hasNode(Id id) const {
+  return id != 0 && id < m_nodeTypes.size() && m_nodeTypes[id] != -1;
+}
+
+bool ColumnarIndexStorage::hasEdge(Id id) const {
+  return id != 0 && id < m_edgeTypes.size() && m_edgeTypes[id] != -1;
+}
+
+bool ColumnarIndexStorage::hasSourceLocation(Id id) const {
+  return id != 0 && id < m_locationFileNodeIds.size() && m_locationFileNodeIds[id] != 0;
+}
+
+std::vector<StorageEdge> ColumnarIndexStorage::getEdgesByNodeIds(const std::vector<Id>& nodeIds,
+                                                                 const std::vector<uint32_t>& sortedEdgeIds,
+                                                                 const std::vector<uint32_t>& nodeIdColumn) const {
+  std::vector<StorageEdge> edges;
+  for(Id nodeId : getSortedUniqueIds(nodeIds)) {
+    auto it = std::lower_bound(sortedEdgeIds.begin(), sortedEdgeIds.end(), nodeId, [&nodeIdColumn](uint32_t edgeId, Id id) {
+      return nodeIdColumn[edgeId] < id;
+    });
+
+    for(; it != sortedEdgeIds.end() && nodeIdColumn[*it] == nodeId; it++) {
+      edges.push_back(getEdgeById(*it));
+    }
+  }
+  return edges;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> ColumnarIndexStorage::getOccurrencePairs(
+    const std::vector<Id>& ids, const std::vector<std::pair<uint32_t, uint32_t>>& sortedPairs) {
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  for(Id id : getSortedUniqueIds(ids)) {
+    auto it = std::lower_bound(sortedPairs.begin(), sortedPairs.end(), id, [](const std::pair<uint32_t, uint32_t>& pair, Id key) {
+      return pair.first < key;
+    });
+
+    for(; it != sortedPairs.end() && it->first == id; it++) {
+      pairs.push_back(*it);
+    }
+  }
+  return pairs;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "StorageEdge.h"
+#include "StorageNode.h"
+#include "StorageOccurrence.h"
+#include "StorageSourceLocation.h"
+#include "types.h"
+
+class SqliteIndexStorage;
+
+/**
+ * Read-only in-memory copy of the nodes, edges, occurrences and source locations of an index database.
+ *
+ * Each table is kept as a set of columns indexed by element or source location id. Edges are additionally sorted by
+ * source and by target node and occurrences by element and by location, so every lookup is a binary search instead of
+ * a SQLite query. The database stays the source of truth, this storage has to be reloaded whenever it changes.
+ */
+class ColumnarIndexStorage {
+public:
+  void load(const SqliteIndexStorage& storage);
+  void clear();
+
+  void addNode(Id id, int type, std::string_view serializedNameUtf8);
+  void addEdge(const StorageEdge& edge);
+  void addOccurrence(const StorageOccurrence& occurrence);
+  void addSourceLocation(const StorageSourceLocation& location);
+
+  // sorts the secondary indices, needs to be called after adding and before querying
+  void finishSetup();
+
+  size_t getNodeCount() const;
+  size_t getEdgeCount() const;
+
+  StorageNode getNodeById(Id id) const;
+  std::vector<StorageNode> getNodesByIds(const std::vector<Id>& ids) const;
+
+  StorageEdge getEdgeById(Id id) const;
+  std::vector<StorageEdge> getEdgesByIds(const std::vector<Id>& ids) const;
+  std::vector<StorageEdge> getEdgesBySourceIds(const std::vector<Id>& sourceIds) const;
+  std::vector<StorageEdge> getEdgesByTargetIds(const std::vector<Id>& targetIds) const;
+
+  std::vector<StorageOccurrence> getOccurrencesForElementIds(const std::vector<Id>& elementIds) const;
+  std::vector<StorageOccurrence> getOccurrencesForLocationIds(const std::vector<Id>& locationIds) const;
+
+  StorageSourceLocation getSourceLocationById(Id id) const;
+  std::vector<StorageSourceLocation> getSourceLocationsByIds(const std::vector<Id>& ids) const;
+
+private:
+  static std::vector<Id> getSortedUniqueIds(std::vector<Id> ids);
+
+  bool hasNode(Id id) const;
+  bool hasEdge(Id id) const;
+  bool hasSourceLocation(Id id) const;
+
+  std::vector<StorageEdge> getEdgesByNodeIds(const std::vector<Id>& nodeIds,
+                                             const std::vector<uint32_t>& sortedEdgeIds,
+                                             const std::vector<uint32_t>& nodeIdColumn) const;
+  static std::vector<std::pair<uint32_t, uint32_t>> getOccurrencePairs(
+      const std::vector<Id>& ids, const std::vector<std::pair<uint32_t, uint32_t>>& sortedPairs);
+
+  // node columns, the type is -1 for element ids that are no node
+  std::vector<int> m_nodeTypes;
+  std::vector<size_t> m_nodeNameOffsets;
+  std::vector<uint32_t> m_nodeNameSizes;
+  std::string m_nodeNames;    // UTF-8, decoded on access
+  size_t m_nodeCount = 0;
+
+  // edge columns, the type is -1 for element ids that are no edge
+  std::vector<int> m_edgeTypes;
+  std::vector<uint32_t> m_edgeSourceIds;
+  std::vector<uint32_t> m_edgeTargetIds;
+  std::vector<uint32_t> m_edgeIdsBySource;
+  std::vector<uint32_t> m_edgeIdsByTarget;
+
+  // (element id, location id) and (location id, element id)
+  std::vector<std::pair<uint32_t, uint32_t>> m_occurrencesByElement;
+  std::vector<std::pair<uint32_t, uint32_t>> m_occurrencesByLocation;
+
+  // source location columns, the file node id is 0 for unused location ids
+  std::vector<uint32_t> m_locationFileNodeIds;
+  std::vector<uint32_t> m_locationStartLines;
+  std::vector<uint32_t> m_locationStartCols;
+  std::vector<uint32_t> m_locationEndLines;
+  std::vector<uint32_t> m_locationEndCols;
+  std::vector<int> m_locationTypes;
+};
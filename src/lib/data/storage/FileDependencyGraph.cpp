@@ -0,0 +1,143 @@
+#include "FileDependencyGraph.h"
+
+#include <algorithm>
+
+namespace {
+class IndexBitset {
+public:
+  explicit IndexBitset(size_t size) : m_words((size + 63) / 64, 0) {}
+
+  // returns false if the index was set already
+  bool insert(uint32_t index) {
+    uint64_t& word = m_words[index / 64];
+    const uint64_t bit = uint64_t(1) << (index % 64);
+    if((word & bit) != 0) {
+      return false;
+    }
+    word |= bit;
+    return true;
+  }
+
+private:
+  std::vector<uint64_t> m_words;
+};
+}    // namespace
+
+FileDependencyGraph::FileDependencyGraph(const std::vector<std::pair<Id, Id>>& dependencies) {
+  auto getIndex = [this](Id fileId) {
+    auto it = m_fileIndices.find(fileId);
+    if(it != m_fileIndices.end()) {
+      return it->second;
+    }
+
+    const auto index = static_cast<uint32_t>(m_fileIds.size());
+    m_fileIds.push_back(fileId);
+    m_fileIndices.emplace(fileId, index);
+    return index;
+  };
+
+  std::vector<std::pair<uint32_t, uint32_t>> referencingEdges;
+  std::vector<std::pair<uint32_t, uint32_t>> referencedEdges;
+  referencingEdges.reserve(dependencies.size());
+  referencedEdges.reserve(dependencies.size());
+  for(const auto& [fileId, referencingFileId] : dependencies) {
+    const uint32_t fileIndex = getIndex(fileId);
+    const uint32_t referencingFileIndex = getIndex(referencingFileId);
+    referencingEdges.emplace_back(fileIndex, referencingFileIndex);
+    referencedEdges.emplace_back(referencingFileIndex, fileIndex);
+  }
+
+  setupAdjacency(m_referencing, m_fileIds.size(), std::move(referencingEdges));
+  setupAdjacency(m_referenced, m_fileIds.size(), std::move(referencedEdges));
+}
+
+size_t FileDependencyGraph::getFileCount() const {
+  return m_fileIds.size();
+}
+
+size_t FileDependencyGraph::getDependencyCount() const {
+  return m_referencing.targets.size();
+}
+
+std::vector<Id> FileDependencyGraph::getReferencing(const std::vector<Id>& fileIds) const {
+  return getClosure(fileIds, m_referencing);
+}
+
+std::vector<Id> FileDependencyGraph::getReferenced(const std::vector<Id>& fileIds) const {
+  return getClosure(fileIds, m_referenced);
+}
+
+void FileDependencyGraph::setupAdjacency(Adjacency& adjacency,
+                                         size_t fileCount,
+                                         std::vector<std::pair<uint32_t, uint32_t>> edges) {
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  adjacency.offsets.assign(fileCount + 1, 0);
+  adjacency.targets.reserve(edges.size());
+  for(const auto& [source, target] : edges) {
+    adjacency.offsets[source + 1]++;
+    adjacency.targets.push_back(target);
+  }
+  for(size_t i = 1; i < adjacency.offsets.size(); i++) {
+    adjacency.offsets[i] += adjacency.offsets[i - 1];
+  }
+
+  adjacency.closures.resize(fileCount);
+}
+
+std::vector<Id> FileDependencyGraph::getClosure(const std::vector<Id>& fileIds, const Adjacency& adjacency) const {
+  std::lock_guard<std::mutex> lock(m_closureMutex);
+
+  IndexBitset visited(m_fileIds.size());
+  std::vector<Id> result;
+  for(Id fileId : fileIds) {
+    auto it = m_fileIndices.find(fileId);
+    if(it == m_fileIndices.end()) {
+      continue;
+    }
+
+    for(uint32_t index : getClosure(it->second, adjacency)) {
+      if(visited.insert(index)) {
+        result.push_back(m_fileIds[index]);
+      }
+    }
+  }
+  return result;
+}
+
+const std::vector<uint32_t>& FileDependencyGraph::getClosure(uint32_t index, const Adjacency& adjacency) const {
+  if(const auto& closure = adjacency.closures[index]) {
+    return *closure;
+  }
+
+  IndexBitset visited(m_fileIds.size());
+  std::vector<uint32_t> closure;
+  std::vector<uint32_t> indicesToProcess = {index};
+  while(!indicesToProcess.empty()) {
+    const uint32_t processedIndex = indicesToProcess.back();
+    indicesToProcess.pop_back();
+
+    for(uint32_t i = adjacency.offsets[processedIndex]; i < adjacency.offsets[processedIndex + 1]; i++) {
+      const uint32_t neighbourIndex = adjacency.targets[i];
+      if(!visited.insert(neighbourIndex)) {
+        continue;
+      }
+      closure.push_back(neighbourIndex);
+
+      // a known closure already contains everything reachable from the neighbour
+      if(const auto& neighbourClosure = adjacency.closures[neighbourIndex]) {
+        for(uint32_t reachableIndex : *neighbourClosure) {
+          if(visited.insert(reachableIndex)) {
+            closure.push_back(reachableIndex);
+          }
+        }
+      } else {
+        indicesToProcess.push_back(neighbourIndex);
+      }
+    }
+  }
+
+  adjacency.closures[index] = std::make_unique<const std::vector<uint32_t>>(std::move(closure));
+  return *adjacency.closures[index];
+}
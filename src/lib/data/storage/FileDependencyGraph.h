@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+
+/**
+ * Dependencies of one kind between files, e.g. includes, stored as adjacency arrays over dense file indices in both
+ * directions.
+ *
+ * The transitive closure of a file is computed when it is first requested and kept, so asking again which files need
+ * to be re-indexed after a frequently included header changed only costs the size of the result. The closures of
+ * several files are merged with a bitset over the dense indices.
+ */
+class FileDependencyGraph {
+public:
+  // pairs of a file id and the id of a file referencing it
+  explicit FileDependencyGraph(const std::vector<std::pair<Id, Id>>& dependencies);
+
+  FileDependencyGraph(const FileDependencyGraph&) = delete;
+  FileDependencyGraph& operator=(const FileDependencyGraph&) = delete;
+
+  size_t getFileCount() const;
+  size_t getDependencyCount() const;
+
+  // files referencing one of the given files directly or indirectly, a given file is only part of the result if it is
+  // referenced by one of the files itself
+  std::vector<Id> getReferencing(const std::vector<Id>& fileIds) const;
+  // files directly or indirectly referenced by one of the given files
+  std::vector<Id> getReferenced(const std::vector<Id>& fileIds) const;
+
+private:
+  struct Adjacency {
+    // the neighbours of file index i are targets[offsets[i]] to targets[offsets[i + 1]]
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    // closures that have been requested already, empty pointers for all others
+    mutable std::vector<std::unique_ptr<const std::vector<uint32_t>>> closures;
+  };
+
+  static void setupAdjacency(Adjacency& adjacency, size_t fileCount, std::vector<std::pair<uint32_t, uint32_t>> edges);
+
+  std::vector<Id> getClosure(const std::vector<Id>& fileIds, const Adjacency& adjacency) const;
+  const std::vector<uint32_t>& getClosure(uint32_t index, const Adjacency& adjacency) const;
+
+  std::vector<Id> m_fileIds;
+  std::unordered_map<Id, uint32_t> m_fileIndices;
+
+  Adjacency m_referencing;
+  Adjacency m_referenced;
+
+  mutable std::mutex m_closureMutex;
+};
@@ -28,8 +28,13 @@
 #include "utility.h"
 #include "utilityApp.h"
 
+namespace {
+// summed size of the cached file contents in bytes
+constexpr size_t MAX_FILE_CONTENT_CACHE_COST = 32 * 1024 * 1024;
+}    // namespace
+
 PersistentStorage::PersistentStorage(const FilePath& dbPath, const FilePath& bookmarkPath)
-    : m_sqliteIndexStorage(dbPath), m_sqliteBookmarkStorage(bookmarkPath) {
+    : m_sqliteIndexStorage(dbPath), m_sqliteBookmarkStorage(bookmarkPath), m_fileContents(MAX_FILE_CONTENT_CACHE_COST) {
   m_commandIndex.addNode(0, SearchMatch::getCommandName(SearchMatch::COMMAND_ALL));
   m_commandIndex.addNode(0, SearchMatch::getCommandName(SearchMatch::COMMAND_ERROR));
   m_commandIndex.addNode(0, SearchMatch::getCommandName(SearchMatch::COMMAND_LEGEND));
@@ -234,6 +239,20 @@ void PersistentStorage::afterErrorRecording() {
 
 void PersistentStorage::setMode(const SqliteIndexStorage::StorageModeType mode) {
   m_sqliteIndexStorage.setMode(mode);
+
+  if(mode != SqliteIndexStorage::STORAGE_MODE_READ) {
+    // the stored dependencies are outdated until buildFileDependencies() runs again
+    m_sqliteIndexStorage.setFileDependenciesComplete(false);
+    clearFileDependencyGraphs();
+  }
+}
+
+void PersistentStorage::setProfile(const SqliteStorage::StorageProfileType profile) {
+  m_sqliteIndexStorage.setProfile(profile);
+}
+
+void PersistentStorage::setReadConnectionPoolEnabled(bool enabled) {
+  m_sqliteIndexStorage.setReadConnectionPoolEnabled(enabled);
 }
 
 FilePath PersistentStorage::getIndexDbFilePath() const {
@@ -290,11 +309,20 @@ void PersistentStorage::clearCaches() {
   m_fileNodeComplete.clear();
   m_fileNodeIndexed.clear();
   m_fileNodeLanguage.clear();
+
   m_symbolDefinitionKinds.clear();
 
   m_hierarchyCache.clear();
   m_fullTextSearchIndex.clear();
   m_fullTextSearchCodec = "";
+
+  m_columnarIndexStorage.clear();
+  m_columnarIndexBuilt = false;
+
+  clearFileDependencyGraphs();
+
+  std::lock_guard<std::mutex> lock(m_fileContentsMutex);
+  m_fileContents.clear();
 }
 
 std::set<FilePath> PersistentStorage::getReferenced(const std::set<FilePath>& filePaths) const {
@@ -331,7 +359,12 @@ void PersistentStorage::clearFileElements(const std::vector<FilePath>& filePaths
     m_sqliteIndexStorage.removeElements(fileNodeIds);
     m_sqliteIndexStorage.commitTransaction();
     updateStatusCallback(100);
+
+    clearFileDependencyGraphs();
   }
+
+  std::lock_guard<std::mutex> lock(m_fileContentsMutex);
+  m_fileContents.clear();
 }
 
 std::vector<FileInfo> PersistentStorage::getFileInfoForAllFiles() const {
@@ -370,6 +403,8 @@ bool PersistentStorage::getFilePathIndexed(const FilePath& path) const {
 }
 
 void PersistentStorage::buildCaches() {
+  TRACE("storage build caches");
+
   clearCaches();
 
   buildFilePathMaps();
@@ -378,9 +413,44 @@ void PersistentStorage::buildCaches() {
   buildHierarchyCache();
 }
 
+void PersistentStorage::buildColumnarIndex() {
+  TimeStamp timeStamp = TimeStamp::now();
+
+  m_columnarIndexStorage.load(m_sqliteIndexStorage);
+  m_columnarIndexBuilt = true;
+
+  LOG_INFO("Built columnar index with " + std::to_string(m_columnarIndexStorage.getNodeCount()) + " nodes and " +
+           std::to_string(m_columnarIndexStorage.getEdgeCount()) + " edges in " +
+           std::to_string(TimeStamp::durationSeconds(timeStamp)) + " s");
+}
+
+void PersistentStorage::buildFileDependencies() {
+  TRACE();
+
+  std::vector<StorageFileDependency> dependencies;
+  for(const auto& [fileId, includingFileIds] : getFileIdToIncludingFileIdMap()) {
+    for(Id includingFileId : includingFileIds) {
+      dependencies.emplace_back(fileId, includingFileId, Edge::typeToInt(Edge::EDGE_INCLUDE));
+    }
+  }
+  for(const auto& [fileId, importingFileIds] : getFileIdToImportingFileIdMap()) {
+    for(Id importingFileId : importingFileIds) {
+      dependencies.emplace_back(fileId, importingFileId, Edge::typeToInt(Edge::EDGE_IMPORT));
+    }
+  }
+
+  m_sqliteIndexStorage.beginTransaction();
+  m_sqliteIndexStorage.setFileDependencies(dependencies);
+  m_sqliteIndexStorage.setFileDependenciesComplete(true);
+  m_sqliteIndexStorage.commitTransaction();
+
+  clearFileDependencyGraphs();
+}
+
 void PersistentStorage::optimizeMemory() {
   m_sqliteIndexStorage.setTime();
   m_sqliteIndexStorage.optimizeMemory();
+  m_sqliteIndexStorage.analyze();
 
   m_sqliteBookmarkStorage.optimizeMemory();
 }
@@ -405,12 +475,12 @@ std::vector<Id> PersistentStorage::getNodeIdsForNameHierarchies(const std::vecto
 }
 
 NameHierarchy PersistentStorage::getNameHierarchyForNodeId(Id nodeId) const {
-  return NameHierarchy::deserialize(m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId).serializedName);
+  return NameHierarchy::deserialize(getStorageNodeById(nodeId).serializedName);
 }
 
 std::vector<NameHierarchy> PersistentStorage::getNameHierarchiesForNodeIds(const std::vector<Id>& nodeIds) const {
   std::vector<NameHierarchy> nameHierarchies;
-  for(const StorageNode& storageNode : m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds)) {
+  for(const StorageNode& storageNode : getStorageNodesByIds(nodeIds)) {
     nameHierarchies.push_back(NameHierarchy::deserialize(storageNode.serializedName));
   }
   return nameHierarchies;
@@ -451,15 +521,17 @@ std::map<Id, std::pair<Id, NameHierarchy>> PersistentStorage::getNodeIdToParentF
 }
 
 NodeType PersistentStorage::getNodeTypeForNodeWithId(Id nodeId) const {
-  return NodeType(intToNodeKind(m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId).type));
+  return NodeType(intToNodeKind(getStorageNodeById(nodeId).type));
 }
 
 StorageEdge PersistentStorage::getEdgeById(Id edgeId) const {
-  return m_sqliteIndexStorage.getEdgeById(edgeId);
+  return getStorageEdgeById(edgeId);
 }
 
 std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLocations(const std::wstring& searchTerm,
                                                                                         bool caseSensitive) const {
+  TRACE("storage fulltext search");
+
   std::shared_ptr<SourceLocationCollection> collection = std::make_shared<SourceLocationCollection>();
   if(searchTerm.empty()) {
     return collection;
@@ -562,6 +634,8 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getFullTextSearchLo
 std::vector<SearchMatch> PersistentStorage::getAutocompletionMatches(const std::wstring& query,
                                                                      NodeTypeSet acceptedNodeTypes,
                                                                      bool acceptCommands) const {
+  TRACE("storage autocompletion");
+
   // search in indices
   const size_t maxResultsCount = static_cast<size_t>(std::pow(3, query.size() + 3));
   const size_t maxBestScoredResultsLength = 100;
@@ -651,7 +725,7 @@ std::vector<SearchMatch> PersistentStorage::getAutocompletionSymbolMatches(const
       elementIds.insert(elementIds.end(), result.elementIds.begin(), result.elementIds.end());
     }
 
-    for(const StorageNode& node : m_sqliteIndexStorage.getAllByIds<StorageNode>(elementIds)) {
+    for(const StorageNode& node : getStorageNodesByIds(elementIds)) {
       storageNodeMap.emplace(node.id, node);
     }
   }
@@ -789,7 +863,7 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(const st
 
   // fetch StorageNodes for node ids
   std::map<Id, StorageNode> storageNodeMap;
-  for(StorageNode& node : m_sqliteIndexStorage.getAllByIds<StorageNode>(elementIds)) {
+  for(StorageNode& node : getStorageNodesByIds(elementIds)) {
     storageNodeMap.emplace(node.id, node);
   }
 
@@ -821,6 +895,8 @@ std::vector<SearchMatch> PersistentStorage::getSearchMatchesForTokenIds(const st
 }
 
 std::shared_ptr<Graph> PersistentStorage::getGraphForAll() const {
+  TRACE("storage graph all");
+
   std::shared_ptr<Graph> graph = std::make_shared<Graph>();
   const size_t sdk_size = m_symbolDefinitionKinds.size();
   m_sqliteIndexStorage.forEach<StorageNode>([&, sdk_size](StorageNode&& storageNode) {
@@ -847,7 +923,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForAll() const {
 std::shared_ptr<Graph> PersistentStorage::getGraphForNodeTypes(NodeTypeSet nodeTypes) const {
   std::vector<Id> tokenIds;
 
-  m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
+  m_sqliteIndexStorage.scan<SqliteIndexStorage::NodeRow>([&](const SqliteIndexStorage::NodeRow& node) {
     if(nodeTypes.contains(NodeType(intToNodeKind(node.type)))) {
       auto iterator = m_symbolDefinitionKinds.find(node.id);
       if(iterator != m_symbolDefinitionKinds.end() && iterator->second == DEFINITION_EXPLICIT) {
@@ -871,6 +947,8 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForNodeTypes(NodeTypeSet nodeT
 std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(const std::vector<Id>& tokenIds,
                                                                     const std::vector<Id>& expandedNodeIds,
                                                                     bool* isActiveNamespace) const {
+  TRACE("storage graph active tokens");
+
   std::vector<Id> ids(tokenIds);
   bool isPackage = false;
 
@@ -884,7 +962,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(const std::v
 
   if(tokenIds.size() == 1) {
     const Id elementId = tokenIds[0];
-    const StorageNode node = m_sqliteIndexStorage.getFirstById<StorageNode>(elementId);
+    const StorageNode node = getStorageNodeById(elementId);
 
     if(node.id > 0) {
       const NodeType nodeType(intToNodeKind(node.type));
@@ -940,7 +1018,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(const std::v
       }
       symbolIds.insert(symbol.id);
     }
-    for(const StorageNode& node : m_sqliteIndexStorage.getAllByIds<StorageNode>(ids)) {
+    for(const StorageNode& node : getStorageNodesByIds(ids)) {
       if(symbolIds.find(node.id) == symbolIds.end()) {
         nodeIds.push_back(node.id);
       }
@@ -948,7 +1026,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForActiveTokenIds(const std::v
 
     if(!isPackage) {
       if(nodeIds.size() != ids.size()) {
-        for(const StorageEdge& edge : m_sqliteIndexStorage.getAllByIds<StorageEdge>(ids)) {
+        for(const StorageEdge& edge : getStorageEdgesByIds(ids)) {
           if(edge.id > 0) {
             edgeIds.push_back(edge.id);
           }
@@ -1028,6 +1106,8 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(Id originId,
                                                            bool nodeNonIndexed,
                                                            size_t depth,
                                                            bool directed) const {
+  TRACE("storage graph trail");
+
   std::set<Id> nodeIds;
   std::set<Id> edgeIds;
 
@@ -1047,13 +1127,13 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(Id originId,
   }
 
   while(nodeIdsToProcess.size() && (!depth || currentDepth < depth)) {
-    std::vector<StorageEdge> edges = forward ? m_sqliteIndexStorage.getEdgesBySourceIds(nodeIdsToProcess) :
-                                               m_sqliteIndexStorage.getEdgesByTargetIds(nodeIdsToProcess);
+    std::vector<StorageEdge> edges = forward ? getStorageEdgesBySourceIds(nodeIdsToProcess) :
+                                               getStorageEdgesByTargetIds(nodeIdsToProcess);
 
     if(!directed || trailTypes & Edge::LAYOUT_VERTICAL) {
       utility::append(edges,
-                      forward ? m_sqliteIndexStorage.getEdgesByTargetIds(nodeIdsToProcess) :
-                                m_sqliteIndexStorage.getEdgesBySourceIds(nodeIdsToProcess));
+                      forward ? getStorageEdgesByTargetIds(nodeIdsToProcess) :
+                                getStorageEdgesBySourceIds(nodeIdsToProcess));
     }
 
     std::vector<Id> nodeIdsToCheck;
@@ -1092,7 +1172,7 @@ std::shared_ptr<Graph> PersistentStorage::getGraphForTrail(Id originId,
     nodeIdsToProcess.clear();
 
     if(nodeTypes != 0) {
-      for(const StorageNode& node : m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIdsToCheck)) {
+      for(const StorageNode& node : getStorageNodesByIds(nodeIdsToCheck)) {
         NodeKind kind = intToNodeKind(node.type);
         if(kind & nodeTypes || (kind == NODE_SYMBOL && nodeNonIndexed)) {
           if(!nodeNonIndexed) {
@@ -1220,7 +1300,7 @@ std::vector<Id> PersistentStorage::getActiveTokenIdsForId(Id tokenId, Id* declar
   if(isNode) {
     *declarationId = tokenId;
 
-    for(const StorageEdge& edge : m_sqliteIndexStorage.getEdgesByTargetId(tokenId)) {
+    for(const StorageEdge& edge : getStorageEdgesByTargetIds({tokenId})) {
       activeTokenIds.push_back(edge.id);
     }
   }
@@ -1232,10 +1312,10 @@ std::vector<Id> PersistentStorage::getNodeIdsForLocationIds(const std::vector<Id
   std::set<Id> nodeIds;
   std::set<Id> implicitNodeIds;
 
-  for(const StorageOccurrence& occurrence : m_sqliteIndexStorage.getOccurrencesForLocationIds(locationIds)) {
+  for(const StorageOccurrence& occurrence : getStorageOccurrencesForLocationIds(locationIds)) {
     Id elementId = occurrence.elementId;
 
-    const StorageEdge edge = m_sqliteIndexStorage.getFirstById<StorageEdge>(elementId);
+    const StorageEdge edge = getStorageEdgeById(elementId);
     if(edge.id != 0) {
       elementId = edge.targetNodeId;
     }
@@ -1257,6 +1337,8 @@ std::vector<Id> PersistentStorage::getNodeIdsForLocationIds(const std::vector<Id
 }
 
 std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsForTokenIds(const std::vector<Id>& tokenIds) const {
+  TRACE("storage locations for tokens");
+
   std::map<Id, FilePath> filePaths;
   std::vector<Id> nonFileIds;
 
@@ -1265,7 +1347,7 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
 
     // check for non-indexed file
     if(path.empty() && m_symbolDefinitionKinds.find(tokenId) == m_symbolDefinitionKinds.end()) {
-      const StorageNode fileNode = m_sqliteIndexStorage.getNodeById(tokenId);
+      const StorageNode fileNode = getStorageNodeById(tokenId);
       if(NodeType(intToNodeKind(fileNode.type)).isFile()) {
         path = FilePath(NameHierarchy::deserialize(fileNode.serializedName).getQualifiedName());
       }
@@ -1287,12 +1369,12 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
     // FIXME: can we use get SqliteIndexStorage::getSourceLocationsForElementIds() here instead?
     std::vector<Id> locationIds;
     std::unordered_map<Id, Id> locationIdToElementIdMap;
-    for(const StorageOccurrence& occurrence : m_sqliteIndexStorage.getOccurrencesForElementIds(nonFileIds)) {
+    for(const StorageOccurrence& occurrence : getStorageOccurrencesForElementIds(nonFileIds)) {
       locationIds.push_back(occurrence.sourceLocationId);
       locationIdToElementIdMap[occurrence.sourceLocationId] = occurrence.elementId;
     }
 
-    for(const StorageSourceLocation& sourceLocation : m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(locationIds)) {
+    for(const StorageSourceLocation& sourceLocation : getStorageSourceLocationsByIds(locationIds)) {
       const LocationType type = intToLocationType(sourceLocation.type);
       if(type != LOCATION_TOKEN && type != LOCATION_SCOPE && type != LOCATION_LOCAL_SYMBOL && type != LOCATION_UNSOLVED) {
         continue;
@@ -1306,7 +1388,7 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
       FilePath path = getFileNodePath(sourceLocation.fileNodeId);
       // FIXME: This shouldn't be necessary since all files are stored, even non-indexed
       if(path.empty()) {
-        const StorageNode fileNode = m_sqliteIndexStorage.getNodeById(sourceLocation.fileNodeId);
+        const StorageNode fileNode = getStorageNodeById(sourceLocation.fileNodeId);
         if(fileNode.id) {
           const FilePath path2 = FilePath(NameHierarchy::deserialize(fileNode.serializedName).getQualifiedName());
           if(path2.exists()) {
@@ -1337,11 +1419,11 @@ std::shared_ptr<SourceLocationCollection> PersistentStorage::getSourceLocationsF
   std::shared_ptr<SourceLocationCollection> collection = std::make_shared<SourceLocationCollection>();
 
   std::map<Id, std::vector<Id>> m_locationIdToElementIds;
-  for(const StorageOccurrence& occurrence : m_sqliteIndexStorage.getOccurrencesForLocationIds(locationIds)) {
+  for(const StorageOccurrence& occurrence : getStorageOccurrencesForLocationIds(locationIds)) {
     m_locationIdToElementIds[occurrence.sourceLocationId].push_back(occurrence.elementId);
   }
 
-  for(StorageSourceLocation location : m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(locationIds)) {
+  for(StorageSourceLocation location : getStorageSourceLocationsByIds(locationIds)) {
     const LocationType type = intToLocationType(location.type);
     if(type != LOCATION_TOKEN && type != LOCATION_SCOPE && type != LOCATION_LOCAL_SYMBOL && type != LOCATION_UNSOLVED) {
       continue;
@@ -1381,11 +1463,28 @@ std::shared_ptr<SourceLocationFile> PersistentStorage::getSourceLocationsOfTypeI
 }
 
 std::shared_ptr<TextAccess> PersistentStorage::getFileContent(const FilePath& filePath, bool /*showsErrors*/) const {
+  {
+    std::lock_guard<std::mutex> lock(m_fileContentsMutex);
+    std::shared_ptr<TextAccess> cached;
+    if(m_fileContents.getValue(filePath.wstr(), cached)) {
+      return cached;
+    }
+  }
+
   std::shared_ptr<TextAccess> fileContent = m_sqliteIndexStorage.getFileContentByPath(filePath.wstr());
-  if(fileContent->getLineCount() > 0) {
-    return fileContent;
+  if(fileContent->getLineCount() == 0) {
+    // files without indexed content are read from disk every time, they may change without the index noticing
+    return TextAccess::createFromFile(FilePath(filePath));
   }
-  return TextAccess::createFromFile(FilePath(filePath));
+
+  size_t cost = 0;
+  for(const std::string& line : fileContent->getAllLines()) {
+    cost += line.size();
+  }
+
+  std::lock_guard<std::mutex> lock(m_fileContentsMutex);
+  m_fileContents.insert(filePath.wstr(), fileContent, cost);
+  return fileContent;
 }
 
 bool PersistentStorage::hasContentForFile(const FilePath& filePath) const {
@@ -1441,20 +1540,7 @@ std::vector<ErrorInfo> PersistentStorage::getErrorsLimited(const ErrorFilter& fi
 std::vector<ErrorInfo> PersistentStorage::getErrorsForFileLimited(const ErrorFilter& filter, const FilePath& filePath) const {
   Id fileId = getFileNodeId(filePath);
   std::set<Id> fileIds = {fileId};
-
-  std::unordered_map<Id, std::set<Id>> includedMap = getFileIdToIncludedFileIdMap();
-  std::set<Id> fileIdsToProcess = includedMap[getFileNodeId(filePath)];
-  std::set<Id> processedFileIds;
-
-  while(fileIdsToProcess.size()) {
-    std::set<Id> nextFileIdsToProcess;
-    for(Id id : fileIdsToProcess) {
-      if(fileIds.insert(id).second) {
-        utility::append(nextFileIdsToProcess, includedMap[id]);
-      }
-    }
-    fileIdsToProcess = nextFileIdsToProcess;
-  }
+  utility::append(fileIds, utility::toSet(getFileDependencyGraph(Edge::EDGE_INCLUDE)->getReferenced({fileId})));
 
   std::vector<ErrorInfo> res;
 
@@ -1466,19 +1552,7 @@ std::vector<ErrorInfo> PersistentStorage::getErrorsForFileLimited(const ErrorFil
   }
 
   if(res.empty()) {
-    std::unordered_map<Id, std::set<Id>> includingMap = getFileIdToIncludingFileIdMap();
-    fileIds.clear();
-
-    fileIdsToProcess = includingMap[fileId];
-    while(fileIdsToProcess.size()) {
-      std::set<Id> nextFileIdsToProcess;
-      for(Id id : fileIdsToProcess) {
-        if(fileIds.insert(id).second) {
-          utility::append(nextFileIdsToProcess, includingMap[id]);
-        }
-      }
-      fileIdsToProcess = nextFileIdsToProcess;
-    }
+    fileIds = utility::toSet(getFileDependencyGraph(Edge::EDGE_INCLUDE)->getReferencing({fileId}));
 
     for(const ErrorInfo& error : errors) {
       if(error.fatal && filter.filter(error) && fileIds.find(getFileNodeId(FilePath(error.filePath))) != fileIds.end()) {
@@ -1521,7 +1595,7 @@ Id PersistentStorage::addNodeBookmark(const NodeBookmark& bookmark) {
 
   for(const Id& nodeId : bookmark.getNodeIds()) {
     m_sqliteBookmarkStorage.addBookmarkedNode(
-        StorageBookmarkedNodeData(id, m_sqliteIndexStorage.getNodeById(nodeId).serializedName));
+        StorageBookmarkedNodeData(id, getStorageNodeById(nodeId).serializedName));
   }
 
   return id;
@@ -1534,14 +1608,14 @@ Id PersistentStorage::addEdgeBookmark(const EdgeBookmark& bookmark) {
                         bookmark.getName(), bookmark.getComment(), bookmark.getTimeStamp().toString(), categoryId))
                     .id;
   for(const Id& edgeId : bookmark.getEdgeIds()) {
-    const StorageEdge storageEdge = m_sqliteIndexStorage.getEdgeById(edgeId);
+    const StorageEdge storageEdge = getStorageEdgeById(edgeId);
 
     bool sourceNodeActive = storageEdge.sourceNodeId == bookmark.getActiveNodeId();
     m_sqliteBookmarkStorage.addBookmarkedEdge(
         StorageBookmarkedEdgeData(id,
                                   // todo: optimization for multiple edges in same bookmark: use a local cache here
-                                  m_sqliteIndexStorage.getNodeById(storageEdge.sourceNodeId).serializedName,
-                                  m_sqliteIndexStorage.getNodeById(storageEdge.targetNodeId).serializedName,
+                                  getStorageNodeById(storageEdge.sourceNodeId).serializedName,
+                                  getStorageNodeById(storageEdge.targetNodeId).serializedName,
                                   storageEdge.type,
                                   sourceNodeActive));
   }
@@ -1670,12 +1744,12 @@ TooltipInfo PersistentStorage::getTooltipInfoForTokenIds(const std::vector<Id>&
     return info;
   }
 
-  StorageNode node = m_sqliteIndexStorage.getFirstById<StorageNode>(tokenIds[0]);
+  StorageNode node = getStorageNodeById(tokenIds[0]);
   if(node.id == 0 && origin == TOOLTIP_ORIGIN_CODE) {
-    const StorageEdge edge = m_sqliteIndexStorage.getFirstById<StorageEdge>(tokenIds[0]);
+    const StorageEdge edge = getStorageEdgeById(tokenIds[0]);
 
     if(edge.id > 0) {
-      node = m_sqliteIndexStorage.getFirstById<StorageNode>(edge.targetNodeId);
+      node = getStorageNodeById(edge.targetNodeId);
     }
   }
 
@@ -1713,13 +1787,8 @@ TooltipInfo PersistentStorage::getTooltipInfoForTokenIds(const std::vector<Id>&
     info.title = L"implicit " + info.title;
   }
 
-  info.count = 0;
+  info.count = m_sqliteIndexStorage.getEdgeCountByTargetIdWithoutType(node.id, Edge::EDGE_MEMBER);
   info.countText = "reference";
-  for(const auto& edge : m_sqliteIndexStorage.getEdgesByTargetId(node.id)) {
-    if(Edge::intToType(edge.type) != Edge::EDGE_MEMBER) {
-      info.count++;
-    }
-  }
 
   info.snippets.push_back(getTooltipSnippetForNode(node));
 
@@ -1739,10 +1808,9 @@ TooltipSnippet PersistentStorage::getTooltipSnippetForNode(const StorageNode& no
   snippet.locationFile = std::make_shared<SourceLocationFile>(FilePath(L"main.txt"), L"", true, true, true);
 
   // set file language
-  std::vector<StorageOccurrence> occurrences = m_sqliteIndexStorage.getOccurrencesForElementIds({node.id});
-  if(occurrences.size()) {
-    const Id locationId = occurrences.front().sourceLocationId;
-    const Id fileId = m_sqliteIndexStorage.getFirstById<StorageSourceLocation>(locationId).fileNodeId;
+  const StorageOccurrence occurrence = m_sqliteIndexStorage.getFirstOccurrenceForElementId(node.id);
+  if(occurrence.elementId != 0) {
+    const Id fileId = getStorageSourceLocationById(occurrence.sourceLocationId).fileNodeId;
     snippet.locationFile->setLanguage(getFileNodeLanguage(fileId));
   }
 
@@ -1862,7 +1930,7 @@ TooltipSnippet PersistentStorage::getTooltipSnippetForNode(const StorageNode& no
                                            IApplicationSettings::getInstanceRaw()->getCodeTabWidth());
 
     std::vector<Id> typeNodeIds;
-    for(const auto& edge : m_sqliteIndexStorage.getEdgesBySourceId(node.id)) {
+    for(const auto& edge : getStorageEdgesBySourceIds({node.id})) {
       if(Edge::intToType(edge.type) == Edge::EDGE_TYPE_USAGE) {
         typeNodeIds.push_back(edge.targetNodeId);
       }
@@ -1878,7 +1946,7 @@ TooltipSnippet PersistentStorage::getTooltipSnippetForNode(const StorageNode& no
         });
 
     typeNames.insert(std::make_pair(nameHierarchy.getQualifiedName(), node.id));
-    for(const auto& typeNode : m_sqliteIndexStorage.getAllByIds<StorageNode>(typeNodeIds)) {
+    for(const auto& typeNode : getStorageNodesByIds(typeNodeIds)) {
       typeNames.insert(std::make_pair(NameHierarchy::deserialize(typeNode.serializedName).getQualifiedName(), typeNode.id));
     }
 
@@ -1928,11 +1996,11 @@ TooltipInfo PersistentStorage::getTooltipInfoForSourceLocationIdsAndLocalSymbolI
 
   if(!locationIds.empty()) {
     std::wstring fileLanguage = getFileNodeLanguage(
-        m_sqliteIndexStorage.getFirstById<StorageSourceLocation>(locationIds.front()).fileNodeId);
+        getStorageSourceLocationById(locationIds.front()).fileNodeId);
 
     const std::vector<Id> nodeIds = getNodeIdsForLocationIds(locationIds);
 
-    for(const StorageNode& node : m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds)) {
+    for(const StorageNode& node : getStorageNodesByIds(nodeIds)) {
       TooltipSnippet snippet;
 
       const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
@@ -1970,14 +2038,16 @@ Id PersistentStorage::getFileNodeId(const FilePath& filePath) const {
     return 0;
   }
 
+  FilePathPool* pathPool = FilePathPool::getInstance();
+  const PathId pathId = pathPool->getId(filePath);
   {
-    std::map<FilePath, Id>::const_iterator it = m_fileNodeIds.find(filePath);
+    auto it = m_fileNodeIds.find(pathId);
     if(it != m_fileNodeIds.end()) {
       return it->second;
     }
   }
   {
-    std::map<FilePath, Id>::const_iterator it = m_lowerCasefileNodeIds.find(filePath.getLowerCase());
+    auto it = m_lowerCasefileNodeIds.find(pathPool->getLowerCaseId(pathId));
     if(it != m_lowerCasefileNodeIds.end()) {
       return it->second;
     }
@@ -2047,33 +2117,22 @@ std::wstring PersistentStorage::getFileNodeLanguage(Id fileId) const {
 std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludingFileIdMap() const {
   std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
 
-  m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-      Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
+  m_sqliteIndexStorage.scanOfType<StorageEdge>(
+      Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](const StorageEdge& edge) {
         fileIdToIncludingFileIdMap[edge.targetNodeId].insert(edge.sourceNodeId);
       });
 
   return fileIdToIncludingFileIdMap;
 }
 
-std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToIncludedFileIdMap() const {
-  std::unordered_map<Id, std::set<Id>> fileIdToIncludingFileIdMap;
-
-  m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-      Edge::typeToInt(Edge::EDGE_INCLUDE), [&fileIdToIncludingFileIdMap](StorageEdge&& edge) {
-        fileIdToIncludingFileIdMap[edge.sourceNodeId].insert(edge.targetNodeId);
-      });
-
-  return fileIdToIncludingFileIdMap;
-}
-
 std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFileIdMap() const {
   std::unordered_map<Id, std::set<Id>> fileIdToImportingFileIdMap;
   {
     std::vector<Id> importedElementIds;
     std::map<Id, std::set<Id>> elementIdToImportingFileIds;
 
-    m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-        Edge::typeToInt(Edge::EDGE_IMPORT), [&importedElementIds, &elementIdToImportingFileIds](StorageEdge&& edge) {
+    m_sqliteIndexStorage.scanOfType<StorageEdge>(
+        Edge::typeToInt(Edge::EDGE_IMPORT), [&importedElementIds, &elementIdToImportingFileIds](const StorageEdge& edge) {
           importedElementIds.push_back(edge.targetNodeId);
           elementIdToImportingFileIds[edge.targetNodeId].insert(edge.sourceNodeId);
         });
@@ -2082,13 +2141,13 @@ std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFile
     {
       std::vector<Id> importedSourceLocationIds;
       std::unordered_map<Id, Id> importedSourceLocationToElementIds;
-      for(const StorageOccurrence& occurrence : m_sqliteIndexStorage.getOccurrencesForElementIds(importedElementIds)) {
+      for(const StorageOccurrence& occurrence : getStorageOccurrencesForElementIds(importedElementIds)) {
         importedSourceLocationIds.push_back(occurrence.sourceLocationId);
         importedSourceLocationToElementIds[occurrence.sourceLocationId] = occurrence.elementId;
       }
 
       for(const StorageSourceLocation& sourceLocation :
-          m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(importedSourceLocationIds)) {
+          getStorageSourceLocationsByIds(importedSourceLocationIds)) {
         auto it = importedSourceLocationToElementIds.find(sourceLocation.id);
         if(it != importedSourceLocationToElementIds.end()) {
           importedElementIdToFileNodeId[it->second] = sourceLocation.fileNodeId;
@@ -2106,85 +2165,75 @@ std::unordered_map<Id, std::set<Id>> PersistentStorage::getFileIdToImportingFile
   return fileIdToImportingFileIdMap;
 }
 
-std::set<Id> PersistentStorage::getReferenced(const std::set<Id>& ids,
-                                              std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const {
-  std::unordered_map<Id, std::set<Id>> idToReferencedIdMap;
-  for(const auto& it : idToReferencingIdMap) {
-    for(Id referencingId : it.second) {
-      idToReferencedIdMap[referencingId].insert(it.first);
-    }
-  }
-
-  return getReferencing(ids, idToReferencedIdMap);
-}
-
-std::set<Id> PersistentStorage::getReferencing(const std::set<Id>& ids,
-                                               std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const {
-  std::set<Id> referencingIds;
-
-  std::set<Id> processingIds = ids;
-  std::set<Id> processedIds;
+std::shared_ptr<const FileDependencyGraph> PersistentStorage::getFileDependencyGraph(Edge::EdgeType type) const {
+  std::lock_guard<std::mutex> lock(m_fileDependencyMutex);
 
-  while(!processingIds.empty()) {
-    std::set<Id> tempIds = processingIds;
-    utility::append(processedIds, processingIds);
-    processingIds.clear();
+  if(!m_includeDependencyGraph || !m_importDependencyGraph) {
+    TRACE("storage load file dependencies");
 
-    for(Id id : tempIds) {
-      utility::append(referencingIds, idToReferencingIdMap[id]);
-      for(Id referencingId : idToReferencingIdMap[id]) {
-        if(processedIds.find(referencingId) == processedIds.end()) {
-          processingIds.insert(referencingId);
+    std::vector<std::pair<Id, Id>> includeDependencies;
+    std::vector<std::pair<Id, Id>> importDependencies;
+    if(m_sqliteIndexStorage.getFileDependenciesComplete()) {
+      m_sqliteIndexStorage.forEach<StorageFileDependency>(
+          [&includeDependencies, &importDependencies](StorageFileDependency&& dependency) {
+            if(dependency.type == Edge::typeToInt(Edge::EDGE_INCLUDE)) {
+              includeDependencies.emplace_back(dependency.fileId, dependency.referencingFileId);
+            } else if(dependency.type == Edge::typeToInt(Edge::EDGE_IMPORT)) {
+              importDependencies.emplace_back(dependency.fileId, dependency.referencingFileId);
+            }
+          });
+    } else {
+      // the database was written by an older version or by an indexing that did not finish
+      for(const auto& [fileId, includingFileIds] : getFileIdToIncludingFileIdMap()) {
+        for(Id includingFileId : includingFileIds) {
+          includeDependencies.emplace_back(fileId, includingFileId);
+        }
+      }
+      for(const auto& [fileId, importingFileIds] : getFileIdToImportingFileIdMap()) {
+        for(Id importingFileId : importingFileIds) {
+          importDependencies.emplace_back(fileId, importingFileId);
         }
       }
     }
+
+    m_includeDependencyGraph = std::make_shared<const FileDependencyGraph>(includeDependencies);
+    m_importDependencyGraph = std::make_shared<const FileDependencyGraph>(importDependencies);
   }
 
-  return referencingIds;
+  return type == Edge::EDGE_IMPORT ? m_importDependencyGraph : m_includeDependencyGraph;
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const {
-  const std::set<Id> ids = getReferenced(getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
+void PersistentStorage::clearFileDependencyGraphs() {
+  std::lock_guard<std::mutex> lock(m_fileDependencyMutex);
+  m_includeDependencyGraph.reset();
+  m_importDependencyGraph.reset();
+}
 
+std::set<FilePath> PersistentStorage::getFileNodePaths(const std::vector<Id>& fileIds) const {
   std::set<FilePath> paths;
-  for(Id id : ids) {    // TODO: performance optimize: use just one request for all ids!
+  for(Id id : fileIds) {
     paths.insert(getFileNodePath(id));
   }
-
   return paths;
 }
 
-std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const {
-  const std::set<Id> ids = getReferenced(getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-  std::set<FilePath> paths;
-  for(Id id : ids) {
-    paths.insert(getFileNodePath(id));
-  }
+std::set<FilePath> PersistentStorage::getReferencedByIncludes(const std::set<FilePath>& filePaths) const {
+  return getFileNodePaths(
+      getFileDependencyGraph(Edge::EDGE_INCLUDE)->getReferenced(utility::toVector(getFileNodeIds(filePaths))));
+}
 
-  return paths;
+std::set<FilePath> PersistentStorage::getReferencedByImports(const std::set<FilePath>& filePaths) const {
+  return getFileNodePaths(getFileDependencyGraph(Edge::EDGE_IMPORT)->getReferenced(utility::toVector(getFileNodeIds(filePaths))));
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByIncludes(const std::set<FilePath>& filePaths) const {
-  const std::set<Id> ids = getReferencing(getFileNodeIds(filePaths), getFileIdToIncludingFileIdMap());
-
-  std::set<FilePath> paths;
-  for(Id id : ids) {
-    paths.insert(getFileNodePath(id));
-  }
-
-  return paths;
+  return getFileNodePaths(
+      getFileDependencyGraph(Edge::EDGE_INCLUDE)->getReferencing(utility::toVector(getFileNodeIds(filePaths))));
 }
 
 std::set<FilePath> PersistentStorage::getReferencingByImports(const std::set<FilePath>& filePaths) const {
-  const std::set<Id> ids = getReferencing(getFileNodeIds(filePaths), getFileIdToImportingFileIdMap());
-
-  std::set<FilePath> paths;
-  for(Id id : ids) {
-    paths.insert(getFileNodePath(id));
-  }
-
-  return paths;
+  return getFileNodePaths(
+      getFileDependencyGraph(Edge::EDGE_IMPORT)->getReferencing(utility::toVector(getFileNodeIds(filePaths))));
 }
 
 void PersistentStorage::addNodesToGraph(const std::vector<Id>& newNodeIds, Graph* graph, bool addChildCount) const {
@@ -2203,7 +2252,9 @@ void PersistentStorage::addNodesToGraph(const std::vector<Id>& newNodeIds, Graph
     return;
   }
 
-  for(const StorageNode& storageNode : m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds)) {
+  graph->reserveNodes(graph->getNodeCount() + nodeIds.size());
+
+  for(const StorageNode& storageNode : getStorageNodesByIds(nodeIds)) {
     const NodeType type(intToNodeKind(storageNode.type));
     if(type.isFile()) {
       addFileNodeToGraph(storageNode, graph);
@@ -2254,7 +2305,9 @@ void PersistentStorage::addEdgesToGraph(const std::vector<Id>& newEdgeIds, Graph
     return;
   }
 
-  for(const StorageEdge& storageEdge : m_sqliteIndexStorage.getAllByIds<StorageEdge>(edgeIds)) {
+  graph->reserveEdges(graph->getEdgeCount() + edgeIds.size());
+
+  for(const StorageEdge& storageEdge : getStorageEdgesByIds(edgeIds)) {
     Node* sourceNode = graph->getNodeById(storageEdge.sourceNodeId);
     Node* targetNode = graph->getNodeById(storageEdge.targetNodeId);
 
@@ -2283,7 +2336,7 @@ void PersistentStorage::addNodesWithParentsAndEdgesToGraph(const std::vector<Id>
   std::set<Id> allEdgeIds(edgeIds.begin(), edgeIds.end());
 
   if(edgeIds.size() > 0) {
-    for(const StorageEdge& storageEdge : m_sqliteIndexStorage.getAllByIds<StorageEdge>(edgeIds)) {
+    for(const StorageEdge& storageEdge : getStorageEdgesByIds(edgeIds)) {
       allNodeIds.insert(storageEdge.sourceNodeId);
       allNodeIds.insert(storageEdge.targetNodeId);
     }
@@ -2325,7 +2378,7 @@ void PersistentStorage::addBundledEdgesToGraph(Id nodeId, const std::vector<Stor
     connectedNodeIds[isSource ? edge.targetNodeId : edge.sourceNodeId].push_back(edgeInfo);
   }
 
-  const std::vector<StorageEdge> outgoingEdges = m_sqliteIndexStorage.getEdgesBySourceIds(childNodeIds);
+  const std::vector<StorageEdge> outgoingEdges = getStorageEdgesBySourceIds(childNodeIds);
   for(const StorageEdge& outEdge : outgoingEdges) {
     EdgeInfo edgeInfo;
     edgeInfo.edgeId = outEdge.id;
@@ -2333,7 +2386,7 @@ void PersistentStorage::addBundledEdgesToGraph(Id nodeId, const std::vector<Stor
     connectedNodeIds[outEdge.targetNodeId].push_back(edgeInfo);
   }
 
-  const std::vector<StorageEdge> incomingEdges = m_sqliteIndexStorage.getEdgesByTargetIds(childNodeIds);
+  const std::vector<StorageEdge> incomingEdges = getStorageEdgesByTargetIds(childNodeIds);
   for(const StorageEdge& inEdge : incomingEdges) {
     EdgeInfo edgeInfo;
     edgeInfo.edgeId = inEdge.id;
@@ -2510,25 +2563,28 @@ void PersistentStorage::addInheritanceChainsToGraph(const std::vector<Id>& activ
 }
 
 void PersistentStorage::buildFilePathMaps() {
+  FilePathPool* pathPool = FilePathPool::getInstance();
   m_sqliteIndexStorage.forEach<StorageFile>([&](StorageFile&& file) {
     const FilePath path(file.filePath);
+    const PathId pathId = pathPool->getId(path);
 
-    m_fileNodeIds.emplace(path, file.id);
-    m_lowerCasefileNodeIds.emplace(path.getLowerCase(), file.id);
+    m_fileNodeIds.emplace(pathId, file.id);
+    m_lowerCasefileNodeIds.emplace(pathPool->getLowerCaseId(pathId), file.id);
     m_fileNodePaths.emplace(file.id, path);
     m_fileNodeComplete.emplace(file.id, file.complete);
     m_fileNodeIndexed.emplace(file.id, file.indexed);
     m_fileNodeLanguage.emplace(file.id, file.languageIdentifier);
   });
 
-  m_sqliteIndexStorage.forEach<StorageSymbol>(
-      [&](StorageSymbol&& symbol) { m_symbolDefinitionKinds.emplace(symbol.id, intToDefinitionKind(symbol.definitionKind)); });
+  m_sqliteIndexStorage.scan<StorageSymbol>([&](const StorageSymbol& symbol) {
+    m_symbolDefinitionKinds.emplace(symbol.id, intToDefinitionKind(symbol.definitionKind));
+  });
 }
 
 void PersistentStorage::buildSearchIndex() {
   const FilePath dbPath = getIndexDbFilePath();
 
-  m_sqliteIndexStorage.forEach<StorageNode>([&](StorageNode&& node) {
+  m_sqliteIndexStorage.scan<SqliteIndexStorage::NodeRow>([&](const SqliteIndexStorage::NodeRow& node) {
     const NodeType type(intToNodeKind(node.type));
     if(type.isFile()) {
       bool indexed = getFileNodeIndexed(node.id);
@@ -2550,7 +2606,8 @@ void PersistentStorage::buildSearchIndex() {
       auto it = m_symbolDefinitionKinds.find(node.id);
       const DefinitionKind defKind = (it != m_symbolDefinitionKinds.end() ? it->second : DEFINITION_NONE);
       if(defKind != DEFINITION_IMPLICIT) {
-        const NameHierarchy nameHierarchy = NameHierarchy::deserialize(node.serializedName);
+        const NameHierarchy nameHierarchy = NameHierarchy::deserialize(
+            utility::decodeFromUtf8(std::string(node.serializedName)));
 
         // we don't use the signature here, so elements with the same signature share the
         // same node.
@@ -2606,21 +2663,21 @@ void PersistentStorage::buildMemberEdgeIdOrderMap() {
   std::vector<Id> childNodeIds;
   std::unordered_map<Id, Id> childIdToMemberEdgeIdMap;
 
-  m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-      Edge::typeToInt(Edge::EDGE_MEMBER), [&childNodeIds, &childIdToMemberEdgeIdMap](StorageEdge&& edge) {
+  m_sqliteIndexStorage.scanOfType<StorageEdge>(
+      Edge::typeToInt(Edge::EDGE_MEMBER), [&childNodeIds, &childIdToMemberEdgeIdMap](const StorageEdge& edge) {
         childNodeIds.push_back(edge.targetNodeId);
         childIdToMemberEdgeIdMap.emplace(edge.targetNodeId, edge.id);
       });
 
   std::vector<Id> locationIds;
   std::unordered_map<Id, Id> locationIdToElementIdMap;
-  for(const StorageOccurrence& occurrence : m_sqliteIndexStorage.getOccurrencesForElementIds(childNodeIds)) {
+  for(const StorageOccurrence& occurrence : getStorageOccurrencesForElementIds(childNodeIds)) {
     locationIds.push_back(occurrence.sourceLocationId);
     locationIdToElementIdMap.emplace(occurrence.sourceLocationId, occurrence.elementId);
   }
 
   SourceLocationCollection collection;
-  for(const StorageSourceLocation& location : m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(locationIds)) {
+  for(const StorageSourceLocation& location : getStorageSourceLocationsByIds(locationIds)) {
     const LocationType locType = intToLocationType(location.type);
     if(locType != LOCATION_TOKEN) {
       continue;
@@ -2647,8 +2704,8 @@ void PersistentStorage::buildHierarchyCache() {
   std::vector<Id> sourceNodeIds;
   std::vector<StorageEdge> memberEdges;
 
-  m_sqliteIndexStorage.forEachOfType<StorageEdge>(
-      Edge::typeToInt(Edge::EDGE_MEMBER), [&sourceNodeIds, &memberEdges](StorageEdge&& edge) {
+  m_sqliteIndexStorage.scanOfType<StorageEdge>(
+      Edge::typeToInt(Edge::EDGE_MEMBER), [&sourceNodeIds, &memberEdges](const StorageEdge& edge) {
         sourceNodeIds.push_back(edge.sourceNodeId);
         memberEdges.emplace_back(edge);
       });
@@ -2683,7 +2740,77 @@ void PersistentStorage::buildHierarchyCache() {
         edge.id, edge.sourceNodeId, edge.targetNodeId, sourceIsVisible, sourceIsImplicit, targetIsImplicit);
   }
 
-  m_sqliteIndexStorage.forEachOfType<StorageEdge>(Edge::typeToInt(Edge::EDGE_INHERITANCE), [this](StorageEdge&& edge) {
+  m_sqliteIndexStorage.scanOfType<StorageEdge>(Edge::typeToInt(Edge::EDGE_INHERITANCE), [this](const StorageEdge& edge) {
     m_hierarchyCache.createInheritance(edge.id, edge.sourceNodeId, edge.targetNodeId);
   });
 }
+
+StorageNode PersistentStorage::getStorageNodeById(Id nodeId) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getNodeById(nodeId);
+  }
+  return m_sqliteIndexStorage.getFirstById<StorageNode>(nodeId);
+}
+
+std::vector<StorageNode> PersistentStorage::getStorageNodesByIds(const std::vector<Id>& nodeIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getNodesByIds(nodeIds);
+  }
+  return m_sqliteIndexStorage.getAllByIds<StorageNode>(nodeIds);
+}
+
+StorageEdge PersistentStorage::getStorageEdgeById(Id edgeId) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getEdgeById(edgeId);
+  }
+  return m_sqliteIndexStorage.getEdgeById(edgeId);
+}
+
+std::vector<StorageEdge> PersistentStorage::getStorageEdgesByIds(const std::vector<Id>& edgeIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getEdgesByIds(edgeIds);
+  }
+  return m_sqliteIndexStorage.getAllByIds<StorageEdge>(edgeIds);
+}
+
+std::vector<StorageEdge> PersistentStorage::getStorageEdgesBySourceIds(const std::vector<Id>& sourceIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getEdgesBySourceIds(sourceIds);
+  }
+  return m_sqliteIndexStorage.getEdgesBySourceIds(sourceIds);
+}
+
+std::vector<StorageEdge> PersistentStorage::getStorageEdgesByTargetIds(const std::vector<Id>& targetIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getEdgesByTargetIds(targetIds);
+  }
+  return m_sqliteIndexStorage.getEdgesByTargetIds(targetIds);
+}
+
+std::vector<StorageOccurrence> PersistentStorage::getStorageOccurrencesForElementIds(const std::vector<Id>& elementIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getOccurrencesForElementIds(elementIds);
+  }
+  return m_sqliteIndexStorage.getOccurrencesForElementIds(elementIds);
+}
+
+std::vector<StorageOccurrence> PersistentStorage::getStorageOccurrencesForLocationIds(const std::vector<Id>& locationIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getOccurrencesForLocationIds(locationIds);
+  }
+  return m_sqliteIndexStorage.getOccurrencesForLocationIds(locationIds);
+}
+
+StorageSourceLocation PersistentStorage::getStorageSourceLocationById(Id locationId) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getSourceLocationById(locationId);
+  }
+  return m_sqliteIndexStorage.getFirstById<StorageSourceLocation>(locationId);
+}
+
+std::vector<StorageSourceLocation> PersistentStorage::getStorageSourceLocationsByIds(const std::vector<Id>& locationIds) const {
+  if(m_columnarIndexBuilt) {
+    return m_columnarIndexStorage.getSourceLocationsByIds(locationIds);
+  }
+  return m_sqliteIndexStorage.getAllByIds<StorageSourceLocation>(locationIds);
+}
@@ -1,10 +1,16 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include "ColumnarIndexStorage.h"
+#include "FileDependencyGraph.h"
+#include "FilePathPool.h"
 #include "FullTextSearchIndex.h"
 #include "HierarchyCache.h"
+#include "LruCache.h"
 #include "SearchIndex.h"
 #include "SqliteBookmarkStorage.h"
 #include "SqliteIndexStorage.h"
@@ -72,6 +78,8 @@ public:
   void afterErrorRecording();
 
   void setMode(const SqliteIndexStorage::StorageModeType mode);
+  void setProfile(const SqliteStorage::StorageProfileType profile);
+  void setReadConnectionPoolEnabled(bool enabled);
 
   FilePath getIndexDbFilePath() const;
   FilePath getBookmarkDbFilePath() const;
@@ -98,6 +106,13 @@ public:
 
   void buildCaches();
 
+  // Copies nodes, edges, occurrences and source locations into memory so browsing queries don't hit SQLite.
+  // Only meant for storages that are not written anymore, the copy is dropped together with the other caches.
+  void buildColumnarIndex();
+
+  // Stores the include and import dependencies between files so that refreshes don't need to derive them from the edges.
+  void buildFileDependencies();
+
   void optimizeMemory();
 
   // StorageAccess implementation
@@ -262,10 +277,13 @@ private:
   std::wstring getFileNodeLanguage(Id fileId) const;
 
   std::unordered_map<Id, std::set<Id>> getFileIdToIncludingFileIdMap() const;
-  std::unordered_map<Id, std::set<Id>> getFileIdToIncludedFileIdMap() const;
   std::unordered_map<Id, std::set<Id>> getFileIdToImportingFileIdMap() const;
-  std::set<Id> getReferenced(const std::set<Id>& filePaths, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
-  std::set<Id> getReferencing(const std::set<Id>& filePaths, std::unordered_map<Id, std::set<Id>> idToReferencingIdMap) const;
+
+  // loads the dependencies stored by buildFileDependencies() on first use, the returned graph stays valid when the
+  // graphs get cleared
+  std::shared_ptr<const FileDependencyGraph> getFileDependencyGraph(Edge::EdgeType type) const;
+  void clearFileDependencyGraphs();
+  std::set<FilePath> getFileNodePaths(const std::vector<Id>& fileIds) const;
 
   std::set<FilePath> getReferencedByIncludes(const std::set<FilePath>& filePaths) const;
   std::set<FilePath> getReferencedByImports(const std::set<FilePath>& filePaths) const;
@@ -289,6 +307,18 @@ private:
   void addCompleteFlagsToSourceLocationCollection(SourceLocationCollection* collection) const;
   void addInheritanceChainsToGraph(const std::vector<Id>& nodeIds, Graph* graph) const;
 
+  // answered by the columnar index if it has been built and by SQLite otherwise
+  StorageNode getStorageNodeById(Id nodeId) const;
+  std::vector<StorageNode> getStorageNodesByIds(const std::vector<Id>& nodeIds) const;
+  StorageEdge getStorageEdgeById(Id edgeId) const;
+  std::vector<StorageEdge> getStorageEdgesByIds(const std::vector<Id>& edgeIds) const;
+  std::vector<StorageEdge> getStorageEdgesBySourceIds(const std::vector<Id>& sourceIds) const;
+  std::vector<StorageEdge> getStorageEdgesByTargetIds(const std::vector<Id>& targetIds) const;
+  std::vector<StorageOccurrence> getStorageOccurrencesForElementIds(const std::vector<Id>& elementIds) const;
+  std::vector<StorageOccurrence> getStorageOccurrencesForLocationIds(const std::vector<Id>& locationIds) const;
+  StorageSourceLocation getStorageSourceLocationById(Id locationId) const;
+  std::vector<StorageSourceLocation> getStorageSourceLocationsByIds(const std::vector<Id>& locationIds) const;
+
   void buildFilePathMaps();
   void buildSearchIndex();
   void buildFullTextSearchIndex() const;
@@ -310,8 +340,8 @@ private:
   SqliteIndexStorage m_sqliteIndexStorage;
   SqliteBookmarkStorage m_sqliteBookmarkStorage;
 
-  std::map<FilePath, Id> m_fileNodeIds;
-  std::map<FilePath, Id> m_lowerCasefileNodeIds;
+  std::unordered_map<PathId, Id> m_fileNodeIds;
+  std::unordered_map<PathId, Id> m_lowerCasefileNodeIds;
   std::map<Id, FilePath> m_fileNodePaths;
   std::map<Id, bool> m_fileNodeComplete;
   std::unordered_map<Id, bool> m_fileNodeIndexed;
@@ -321,4 +351,15 @@ private:
   std::map<Id, Id> m_memberEdgeIdOrderMap;
 
   HierarchyCache m_hierarchyCache;
+
+  // indexed file contents shared by code snippets and tooltips, cleared when files are cleared or the caches are rebuilt
+  mutable std::mutex m_fileContentsMutex;
+  mutable LruCache<std::wstring, std::shared_ptr<TextAccess>> m_fileContents;
+
+  ColumnarIndexStorage m_columnarIndexStorage;
+  bool m_columnarIndexBuilt = false;
+
+  mutable std::mutex m_fileDependencyMutex;
+  mutable std::shared_ptr<const FileDependencyGraph> m_includeDependencyGraph;
+  mutable std::shared_ptr<const FileDependencyGraph> m_importDependencyGraph;
 };
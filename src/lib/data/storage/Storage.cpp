@@ -1,5 +1,7 @@
 #include "Storage.h"
 
+#include <map>
+
 #include "logging.h"
 #include "tracing.h"
 
@@ -14,7 +16,7 @@ void Storage::inject(Storage* injected) {
   startInjection();
 
   {
-    // TRACE("inject errors");
+    TRACE("inject errors");
 
     for(const StorageError& error : injected->getErrors()) {
       Id errorId = addError(error);
@@ -23,7 +25,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject nodes");
+    TRACE("inject nodes");
 
     const std::vector<StorageNode>& nodes = injected->getStorageNodes();
 
@@ -37,7 +39,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject files");
+    TRACE("inject files");
 
     for(const StorageFile& file : injected->getStorageFiles()) {
       auto it = injectedIdToOwnElementId.find(file.id);
@@ -48,7 +50,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject symbols");
+    TRACE("inject symbols");
 
     std::vector<StorageSymbol> symbols = injected->getStorageSymbols();
     for(size_t i = 0; i < symbols.size(); i++) {
@@ -66,7 +68,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject edges");
+    TRACE("inject edges");
 
     std::vector<StorageEdge> edges = injected->getStorageEdges();
     for(size_t i = 0; i < edges.size(); i++) {
@@ -106,7 +108,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject local symbols");
+    TRACE("inject local symbols");
 
     const std::set<StorageLocalSymbol>& symbols = injected->getStorageLocalSymbols();
     std::vector<Id> symbolIds = addLocalSymbols(symbols);
@@ -121,7 +123,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject locations");
+    TRACE("inject locations");
 
     const std::set<StorageSourceLocation>& oldLocations = injected->getStorageSourceLocations();
     std::vector<StorageSourceLocation> locations;
@@ -150,7 +152,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject occurrences");
+    TRACE("inject occurrences");
 
     const std::set<StorageOccurrence>& oldOccurrences = injected->getStorageOccurrences();
 
@@ -184,7 +186,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject element components");
+    TRACE("inject element components");
 
     const std::set<StorageElementComponent>& oldComponents = injected->getElementComponents();
     std::vector<StorageElementComponent> components;
@@ -201,7 +203,7 @@ void Storage::inject(Storage* injected) {
   }
 
   {
-    // TRACE("inject accesses");
+    TRACE("inject accesses");
 
     const std::set<StorageComponentAccess>& oldAccesses = injected->getComponentAccesses();
     std::vector<StorageComponentAccess> accesses;
@@ -9,7 +9,7 @@ class StorageAccessProxy : public StorageAccess {
 public:
   StorageAccessProxy() = default;
 
-  void setSubject(std::weak_ptr<StorageAccess> subject);
+  virtual void setSubject(std::weak_ptr<StorageAccess> subject);
 
   // StorageAccess implementation
   Id getNodeIdForFileNode(const FilePath& filePath) const override;
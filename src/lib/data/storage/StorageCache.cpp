@@ -1,16 +1,64 @@
 #include "StorageCache.h"
 
+#include "Graph.h"
 #include "SourceLocationCollection.h"
 #include "SourceLocationFile.h"
 #include "TextAccess.h"
 #include "utility.h"
 
+namespace {
+// rough memory estimates used as cost of the cached activation results
+constexpr size_t MAX_ACTIVATION_CACHE_COST = 64 * 1024 * 1024;
+constexpr size_t GRAPH_TOKEN_COST = 512;
+constexpr size_t SOURCE_LOCATION_COST = 128;
+constexpr size_t MAX_TOOLTIP_CACHE_COST = 4 * 1024 * 1024;
+constexpr size_t TOOLTIP_SNIPPET_COST = 512;
+
+std::shared_ptr<Graph> copyGraph(const Graph& graph) {
+  auto copy = std::make_shared<Graph>();
+  graph.forEachNode([&copy](Node* node) { copy->addNodeAsPlainCopy(node); });
+  graph.forEachEdge([&copy](Edge* edge) { copy->addEdgeAsPlainCopy(edge); });
+  copy->setTrailMode(graph.getTrailMode());
+  copy->setHasTrailOrigin(graph.hasTrailOrigin());
+  return copy;
+}
+
+std::shared_ptr<SourceLocationCollection> copySourceLocations(const SourceLocationCollection& collection) {
+  auto copy = std::make_shared<SourceLocationCollection>();
+  copy->addSourceLocationCopies(&collection);
+  return copy;
+}
+
+TooltipInfo copyTooltipInfo(const TooltipInfo& info) {
+  TooltipInfo copy = info;
+  for(TooltipSnippet& snippet : copy.snippets) {
+    if(snippet.locationFile) {
+      snippet.locationFile = std::make_shared<SourceLocationFile>(*snippet.locationFile);
+    }
+  }
+  return copy;
+}
+}    // namespace
+
+StorageCache::StorageCache()
+    : m_activeGraphs(MAX_ACTIVATION_CACHE_COST / 2)
+    , m_tokenSourceLocations(MAX_ACTIVATION_CACHE_COST / 2)
+    , m_tooltipInfos(MAX_TOOLTIP_CACHE_COST) {}
+
 void StorageCache::clear() {
   m_graphForAll.reset();
 
   m_storageStats = StorageStats();
 
   setUseErrorCache(false);
+
+  clearActivationCache();
+}
+
+void StorageCache::setSubject(std::weak_ptr<StorageAccess> subject) {
+  clearActivationCache();
+
+  StorageAccessProxy::setSubject(std::move(subject));
 }
 
 std::shared_ptr<Graph> StorageCache::getGraphForAll() const {
@@ -21,6 +69,62 @@ std::shared_ptr<Graph> StorageCache::getGraphForAll() const {
   return m_graphForAll;
 }
 
+std::shared_ptr<Graph> StorageCache::getGraphForActiveTokenIds(const std::vector<Id>& tokenIds,
+                                                             const std::vector<Id>& expandedNodeIds,
+                                                             bool* isActiveNamespace) const {
+  auto key = std::make_pair(tokenIds, expandedNodeIds);
+
+  {
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    ActiveGraph cached;
+    if(m_activeGraphs.getValue(key, cached)) {
+      if(isActiveNamespace != nullptr) {
+        *isActiveNamespace = cached.isActiveNamespace;
+      }
+      return copyGraph(*cached.graph);
+    }
+  }
+
+  ActiveGraph result;
+  result.graph = StorageAccessProxy::getGraphForActiveTokenIds(tokenIds, expandedNodeIds, &result.isActiveNamespace);
+  if(isActiveNamespace != nullptr) {
+    *isActiveNamespace = result.isActiveNamespace;
+  }
+
+  if(!result.graph) {
+    return result.graph;
+  }
+
+  std::shared_ptr<Graph> graph = copyGraph(*result.graph);
+  const size_t cost = result.graph->size() * GRAPH_TOKEN_COST;
+
+  std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+  m_activeGraphs.insert(key, std::move(result), cost);
+  return graph;
+}
+
+std::shared_ptr<SourceLocationCollection> StorageCache::getSourceLocationsForTokenIds(const std::vector<Id>& tokenIds) const {
+  {
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    std::shared_ptr<SourceLocationCollection> cached;
+    if(m_tokenSourceLocations.getValue(tokenIds, cached)) {
+      return copySourceLocations(*cached);
+    }
+  }
+
+  std::shared_ptr<SourceLocationCollection> collection = StorageAccessProxy::getSourceLocationsForTokenIds(tokenIds);
+  if(!collection) {
+    return collection;
+  }
+
+  std::shared_ptr<SourceLocationCollection> copy = copySourceLocations(*collection);
+  const size_t cost = collection->getSourceLocationCount() * SOURCE_LOCATION_COST;
+
+  std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+  m_tokenSourceLocations.insert(tokenIds, std::move(collection), cost);
+  return copy;
+}
+
 StorageStats StorageCache::getStorageStats() const {
   if(m_storageStats.nodeCount == 0U) {
     m_storageStats = StorageAccessProxy::getStorageStats();
@@ -37,6 +141,34 @@ std::shared_ptr<TextAccess> StorageCache::getFileContent(const FilePath& filePat
   return StorageAccessProxy::getFileContent(filePath, showsErrors);
 }
 
+TooltipInfo StorageCache::getTooltipInfoForTokenIds(const std::vector<Id>& tokenIds, TooltipOrigin origin) const {
+  const std::pair<std::vector<Id>, TooltipOrigin> key(tokenIds, origin);
+
+  {
+    std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+    TooltipInfo cached;
+    if(m_tooltipInfos.getValue(key, cached)) {
+      return copyTooltipInfo(cached);
+    }
+  }
+
+  TooltipInfo info = StorageAccessProxy::getTooltipInfoForTokenIds(tokenIds, origin);
+  if(!info.isValid()) {
+    return info;
+  }
+
+  size_t cost = TOOLTIP_SNIPPET_COST;
+  for(const TooltipSnippet& snippet : info.snippets) {
+    cost += TOOLTIP_SNIPPET_COST + snippet.code.size() * sizeof(wchar_t);
+  }
+
+  TooltipInfo copy = copyTooltipInfo(info);
+
+  std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+  m_tooltipInfos.insert(key, std::move(info), cost);
+  return copy;
+}
+
 ErrorCountInfo StorageCache::getErrorCount() const {
   if(!m_useErrorCache) {
     return StorageAccessProxy::getErrorCount();
@@ -92,6 +224,13 @@ void StorageCache::setUseErrorCache(bool enabled) {
   m_errorCount = ErrorCountInfo();
 }
 
+void StorageCache::clearActivationCache() {
+  std::lock_guard<std::mutex> lock(m_resultCacheMutex);
+  m_activeGraphs.clear();
+  m_tokenSourceLocations.clear();
+  m_tooltipInfos.clear();
+}
+
 void StorageCache::addErrorsToCache(const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount) {
   utility::append(m_cachedErrors, newErrors);
   m_errorCount = errorCount;
@@ -1,17 +1,35 @@
 #pragma once
 
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "LruCache.h"
 #include "StorageAccessProxy.h"
 
 class StorageCache : public StorageAccessProxy {
 public:
+  StorageCache();
+
   void clear();
 
+  void setSubject(std::weak_ptr<StorageAccess> subject) override;
+
   std::shared_ptr<Graph> getGraphForAll() const override;
 
+  // results of activations are kept in a bounded cache, so going back and forth in the history does not query again
+  std::shared_ptr<Graph> getGraphForActiveTokenIds(const std::vector<Id>& tokenIds,
+                                                   const std::vector<Id>& expandedNodeIds,
+                                                   bool* isActiveNamespace = nullptr) const override;
+  std::shared_ptr<SourceLocationCollection> getSourceLocationsForTokenIds(const std::vector<Id>& tokenIds) const override;
+
   StorageStats getStorageStats() const override;
 
   std::shared_ptr<TextAccess> getFileContent(const FilePath& filePath, bool showsErrors) const override;
 
+  // hovering back and forth over the same tokens does not query again
+  TooltipInfo getTooltipInfoForTokenIds(const std::vector<Id>& tokenIds, TooltipOrigin origin) const override;
+
   ErrorCountInfo getErrorCount() const override;
   std::vector<ErrorInfo> getErrorsLimited(const ErrorFilter& filter) const override;
   std::vector<ErrorInfo> getErrorsForFileLimited(const ErrorFilter& filter, const FilePath& filePath) const override;
@@ -21,10 +39,24 @@ public:
   void addErrorsToCache(const std::vector<ErrorInfo>& newErrors, const ErrorCountInfo& errorCount) override;
 
 private:
+  struct ActiveGraph {
+    std::shared_ptr<Graph> graph;
+    bool isActiveNamespace = false;
+  };
+
+  void clearActivationCache();
+
   mutable std::shared_ptr<Graph> m_graphForAll;
   mutable StorageStats m_storageStats;
 
   bool m_useErrorCache = false;
   ErrorCountInfo m_errorCount;
   std::vector<ErrorInfo> m_cachedErrors;
+
+  // callers modify the returned graphs, collections and tooltips, so only copies of the cached values are handed out
+  // file contents are cached by the storage itself, so they are shared with the tooltips it creates
+  mutable std::mutex m_resultCacheMutex;
+  mutable LruCache<std::pair<std::vector<Id>, std::vector<Id>>, ActiveGraph> m_activeGraphs;
+  mutable LruCache<std::vector<Id>, std::shared_ptr<SourceLocationCollection>> m_tokenSourceLocations;
+  mutable LruCache<std::pair<std::vector<Id>, TooltipOrigin>, TooltipInfo> m_tooltipInfos;
 };
@@ -2,6 +2,8 @@
 
 #include "logging.h"
 
+StorageProvider::StorageProvider() : m_indexingMetrics(std::make_shared<IndexingMetrics>()) {}
+
 int StorageProvider::getStorageCount() const {
   std::lock_guard<std::mutex> lock(m_storagesMutex);
   return static_cast<int>(m_storages.size());
@@ -14,51 +16,52 @@ void StorageProvider::clear() {
 
 void StorageProvider::insert(std::shared_ptr<IntermediateStorage> storage) {
   const std::size_t storageSize = storage->getSourceLocationCount();
-  std::list<std::shared_ptr<IntermediateStorage>>::iterator it;
+  std::list<QueuedStorage>::iterator it;
 
   std::lock_guard<std::mutex> lock(m_storagesMutex);
   for(it = m_storages.begin(); it != m_storages.end(); it++) {
-    if((*it)->getSourceLocationCount() < storageSize) {
+    if(it->storage->getSourceLocationCount() < storageSize) {
       break;
     }
   }
-  m_storages.insert(it, storage);
+  m_storages.insert(it, {storage, TimeStamp::now()});
 }
 
 std::shared_ptr<IntermediateStorage> StorageProvider::consumeSecondLargestStorage() {
-  std::shared_ptr<IntermediateStorage> ret;
-  {
-    std::lock_guard<std::mutex> lock(m_storagesMutex);
-    if(m_storages.size() > 1) {
-      std::list<std::shared_ptr<IntermediateStorage>>::iterator it = m_storages.begin();
-      it++;
-      ret = *it;
-      m_storages.erase(it);
-    }
+  std::lock_guard<std::mutex> lock(m_storagesMutex);
+  if(m_storages.size() > 1) {
+    return consume(std::next(m_storages.begin()));
   }
-  return ret;
+  return nullptr;
 }
 
 std::shared_ptr<IntermediateStorage> StorageProvider::consumeLargestStorage() {
-  std::shared_ptr<IntermediateStorage> ret;
-  {
-    std::lock_guard<std::mutex> lock(m_storagesMutex);
-    if(!m_storages.empty()) {
-      ret = m_storages.front();
-      m_storages.pop_front();
-    }
+  std::lock_guard<std::mutex> lock(m_storagesMutex);
+  if(!m_storages.empty()) {
+    return consume(m_storages.begin());
   }
-
-  return ret;
+  return nullptr;
 }
 
 void StorageProvider::logCurrentState() const {
   std::string logString = "Storages waiting for injection:";
   {
     std::lock_guard<std::mutex> lock(m_storagesMutex);
-    for(const std::shared_ptr<IntermediateStorage>& storage : m_storages) {
-      logString += " " + std::to_string(storage->getSourceLocationCount()) + ";";
+    for(const QueuedStorage& queuedStorage : m_storages) {
+      logString += " " + std::to_string(queuedStorage.storage->getSourceLocationCount()) + ";";
     }
   }
   LOG_INFO(logString);
 }
+
+std::shared_ptr<IndexingMetrics> StorageProvider::getIndexingMetrics() const {
+  return m_indexingMetrics;
+}
+
+std::shared_ptr<IntermediateStorage> StorageProvider::consume(std::list<QueuedStorage>::iterator it) {
+  std::shared_ptr<IntermediateStorage> storage = std::move(it->storage);
+  m_indexingMetrics->addPhaseTime(
+      IndexingMetrics::Phase::Queue, TimeStamp::durationSeconds(it->insertTime), storage->getSourceLocationCount());
+  m_storages.erase(it);
+  return storage;
+}
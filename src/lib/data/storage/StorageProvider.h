@@ -5,10 +5,14 @@
 #include <memory>
 #include <mutex>
 
+#include "IndexingMetrics.h"
 #include "IntermediateStorage.h"
+#include "TimeStamp.h"
 
 class StorageProvider {
 public:
+  StorageProvider();
+
   int getStorageCount() const;
 
   void clear();
@@ -23,9 +27,21 @@ public:
 
   void logCurrentState() const;
 
+  // the time storages wait here is recorded as queue phase
+  std::shared_ptr<IndexingMetrics> getIndexingMetrics() const;
+
 private:
-  std::list<std::shared_ptr<IntermediateStorage>> m_storages;    // larger storages are in front
+  struct QueuedStorage {
+    std::shared_ptr<IntermediateStorage> storage;
+    TimeStamp insertTime;
+  };
+
+  std::shared_ptr<IntermediateStorage> consume(std::list<QueuedStorage>::iterator it);
+
+  std::list<QueuedStorage> m_storages;    // larger storages are in front
   mutable std::mutex m_storagesMutex;
+
+  const std::shared_ptr<IndexingMetrics> m_indexingMetrics;
 };
 
 #endif    // STORAGE_PROVIDER_H
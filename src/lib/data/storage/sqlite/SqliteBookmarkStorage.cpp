@@ -222,7 +222,7 @@ void SqliteBookmarkStorage::setupPrecompiledStatements() {}
 
 template <>
 std::vector<StorageBookmarkCategory> SqliteBookmarkStorage::doGetAll<StorageBookmarkCategory>(const std::string& query) const {
-  CppSQLite3Query queryStr = executeQuery("SELECT id, name FROM bookmark_category " + query + ";");
+  Query queryStr = executeQuery("SELECT id, name FROM bookmark_category " + query + ";");
 
   std::vector<StorageBookmarkCategory> categories;
   while(!queryStr.eof()) {
@@ -240,7 +240,7 @@ std::vector<StorageBookmarkCategory> SqliteBookmarkStorage::doGetAll<StorageBook
 
 template <>
 std::vector<StorageBookmark> SqliteBookmarkStorage::doGetAll<StorageBookmark>(const std::string& query) const {
-  CppSQLite3Query q = executeQuery("SELECT id, name, comment, timestamp, category_id FROM bookmark " + query + ";");
+  Query q = executeQuery("SELECT id, name, comment, timestamp, category_id FROM bookmark " + query + ";");
 
   std::vector<StorageBookmark> bookmarks;
   while(!q.eof()) {
@@ -261,7 +261,7 @@ std::vector<StorageBookmark> SqliteBookmarkStorage::doGetAll<StorageBookmark>(co
 
 template <>
 std::vector<StorageBookmarkedNode> SqliteBookmarkStorage::doGetAll<StorageBookmarkedNode>(const std::string& query) const {
-  CppSQLite3Query q = executeQuery(
+  Query q = executeQuery(
       "SELECT "
       "bookmarked_node.id, bookmarked_element.bookmark_id, bookmarked_node.serialized_node_name "
       "FROM bookmarked_node "
@@ -286,7 +286,7 @@ std::vector<StorageBookmarkedNode> SqliteBookmarkStorage::doGetAll<StorageBookma
 
 template <>
 std::vector<StorageBookmarkedEdge> SqliteBookmarkStorage::doGetAll<StorageBookmarkedEdge>(const std::string& query) const {
-  CppSQLite3Query queryStr = executeQuery(
+  Query queryStr = executeQuery(
       "SELECT "
       "bookmarked_edge.id, bookmarked_element.bookmark_id, "
       "bookmarked_edge.serialized_source_node_name, bookmarked_edge.serialized_target_node_name, "
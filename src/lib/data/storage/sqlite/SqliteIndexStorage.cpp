@@ -1,7 +1,7 @@
 #include "SqliteIndexStorage.h"
 
+#include <algorithm>
 #include <sstream>
-
 #include <unordered_map>
 
 #include "FileSystem.h"
@@ -16,6 +16,17 @@
 const size_t SqliteIndexStorage::s_storageVersion = 25;
 
 namespace {
+// SQLite versions before 3.32 only allow 999 bound parameters per statement
+constexpr size_t MAX_BOUND_ID_COUNT = 512;
+
+std::string getParameterList(size_t count) {
+  std::string parameters(count * 2 - 1, ',');
+  for(size_t i = 0; i < parameters.size(); i += 2) {
+    parameters[i] = '?';
+  }
+  return parameters;
+}
+
 std::pair<std::wstring, std::wstring> splitLocalSymbolName(const std::wstring& name) {
   size_t pos = name.find_last_of(L'<');
   if(pos == std::wstring::npos || name.back() != L'>') {
@@ -386,7 +397,7 @@ void SqliteIndexStorage::removeElement(Id id) {
 }
 
 void SqliteIndexStorage::removeElements(const std::vector<Id>& ids) {
-  executeStatement("DELETE FROM element WHERE id IN (" + utility::join(utility::toStrings(ids), ',') + ");");
+  executeQueryForIds("DELETE FROM element ", "id", ids, "", [](CppSQLite3Query& /*q*/) {});
 }
 
 void SqliteIndexStorage::removeOccurrence(const StorageOccurrence& occurrence) {
@@ -401,8 +412,11 @@ void SqliteIndexStorage::removeOccurrences(const std::vector<StorageOccurrence>&
 }
 
 void SqliteIndexStorage::removeElementsWithoutOccurrences(const std::vector<Id>& elementIds) {
-  executeStatement("DELETE FROM element WHERE id IN (" + utility::join(utility::toStrings(elementIds), ',') +
-                   ") AND id NOT IN (SELECT element_id FROM occurrence);");
+  executeQueryForIds("DELETE FROM element ",
+                     "id",
+                     elementIds,
+                     " AND id NOT IN (SELECT element_id FROM occurrence)",
+                     [](CppSQLite3Query& /*q*/) {});
 }
 
 void SqliteIndexStorage::removeElementsWithLocationInFiles(const std::vector<Id>& fileIds,
@@ -428,17 +442,17 @@ void SqliteIndexStorage::removeElementsWithLocationInFiles(const std::vector<Id>
   }
 
   // store ids of all elements located in fileIds into element_id_to_clear
-  executeStatement(
-      "INSERT INTO element_id_to_clear "
+  executeQueryForIds(
+      "INSERT OR IGNORE INTO element_id_to_clear "
       "	SELECT occurrence.element_id "
       "	FROM occurrence "
       "	INNER JOIN source_location ON ("
       "		occurrence.source_location_id = source_location.id"
-      "	) "
-      "	WHERE source_location.file_node_id IN (" +
-      utility::join(utility::toStrings(fileIds), ',') +
-      ")"
-      "	GROUP BY (occurrence.element_id)");
+      "	) ",
+      "source_location.file_node_id",
+      fileIds,
+      "	GROUP BY (occurrence.element_id)",
+      [](CppSQLite3Query& /*q*/) {});
 
   if(updateStatusCallback != nullptr) {
     updateStatusCallback(4);
@@ -485,7 +499,7 @@ void SqliteIndexStorage::removeElementsWithLocationInFiles(const std::vector<Id>
   }
 
   // delete source locations from fileIds (this also deletes the respective occurrences)
-  executeStatement("DELETE FROM source_location WHERE file_node_id IN (" + utility::join(utility::toStrings(fileIds), ',') + ");");
+  executeQueryForIds("DELETE FROM source_location ", "file_node_id", fileIds, "", [](CppSQLite3Query& /*q*/) {});
 
   if(updateStatusCallback != nullptr) {
     updateStatusCallback(45);
@@ -534,58 +548,73 @@ void SqliteIndexStorage::removeAllErrors() {
   executeStatement("DELETE FROM error;");
 }
 
+void SqliteIndexStorage::setFileDependencies(const std::vector<StorageFileDependency>& dependencies) {
+  executeStatement("DELETE FROM file_dependency;");
+  m_insertFileDependencyBatchStatement.execute(dependencies, this);
+}
+
+bool SqliteIndexStorage::getFileDependenciesComplete() const {
+  return getMetaValue("file_dependencies_complete") == "1";
+}
+
+void SqliteIndexStorage::setFileDependenciesComplete(bool complete) {
+  insertOrUpdateMetaValue("file_dependencies_complete", complete ? "1" : "0");
+}
+
 bool SqliteIndexStorage::isEdge(Id elementId) const {
-  int count = executeStatementScalar("SELECT count(*) FROM edge WHERE id = " + std::to_string(elementId) + ";", 0);
+  CachedStatement stmt = getCachedStatement("SELECT count(*) FROM edge WHERE id = ?;");
+  stmt->bind(1, int(elementId));
+  const int count = executeStatementScalar(*stmt, 0);
   return (count > 0);
 }
 
 bool SqliteIndexStorage::isNode(Id elementId) const {
-  int count = executeStatementScalar("SELECT count(*) FROM node WHERE id = " + std::to_string(elementId) + ";", 0);
+  CachedStatement stmt = getCachedStatement("SELECT count(*) FROM node WHERE id = ?;");
+  stmt->bind(1, int(elementId));
+  const int count = executeStatementScalar(*stmt, 0);
   return (count > 0);
 }
 
 bool SqliteIndexStorage::isFile(Id elementId) const {
-  int count = executeStatementScalar("SELECT count(*) FROM file WHERE id = " + std::to_string(elementId) + ";", 0);
+  CachedStatement stmt = getCachedStatement("SELECT count(*) FROM file WHERE id = ?;");
+  stmt->bind(1, int(elementId));
+  const int count = executeStatementScalar(*stmt, 0);
   return (count > 0);
 }
 
 StorageEdge SqliteIndexStorage::getEdgeById(Id edgeId) const {
-  std::vector<StorageEdge> candidates = doGetAll<StorageEdge>("WHERE id = " + std::to_string(edgeId));
-
-  if(candidates.size() > 0) {
-    return candidates[0];
-  }
-
-  return StorageEdge();
+  return getFirstById<StorageEdge>(edgeId);
 }
 
 StorageEdge SqliteIndexStorage::getEdgeBySourceTargetType(Id sourceId, Id targetId, int type) const {
-  return doGetFirst<StorageEdge>(
-      "WHERE "
-      "source_node_id == " +
-      std::to_string(sourceId) +
-      " AND "
-      "target_node_id == " +
-      std::to_string(targetId) +
-      " AND "
-      "type == " +
-      std::to_string(type));
+  CachedStatement stmt = getCachedStatement(getSelectClause<StorageEdge>() +
+                                             "WHERE source_node_id == ? AND target_node_id == ? AND type == ? LIMIT 1;");
+  stmt->bind(1, int(sourceId));
+  stmt->bind(2, int(targetId));
+  stmt->bind(3, type);
+
+  StorageEdge edge;
+  {
+    CppSQLite3Query q = executeQuery(*stmt);
+    forEachRow<StorageEdge>(q, [&edge](StorageEdge&& e) { edge = std::move(e); });
+  }
+  return edge;
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesBySourceId(Id sourceId) const {
-  return doGetAll<StorageEdge>("WHERE source_node_id == " + std::to_string(sourceId));
+  return doGetAllByIds<StorageEdge>("source_node_id", {sourceId});
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesBySourceIds(const std::vector<Id>& sourceIds) const {
-  return doGetAll<StorageEdge>("WHERE source_node_id IN (" + utility::join(utility::toStrings(sourceIds), ',') + ")");
+  return doGetAllByIds<StorageEdge>("source_node_id", sourceIds);
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesByTargetId(Id targetId) const {
-  return doGetAll<StorageEdge>("WHERE target_node_id == " + std::to_string(targetId));
+  return doGetAllByIds<StorageEdge>("target_node_id", {targetId});
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesByTargetIds(const std::vector<Id>& targetIds) const {
-  return doGetAll<StorageEdge>("WHERE target_node_id IN (" + utility::join(utility::toStrings(targetIds), ',') + ")");
+  return doGetAllByIds<StorageEdge>("target_node_id", targetIds);
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesBySourceOrTargetId(Id id) const {
@@ -597,35 +626,30 @@ std::vector<StorageEdge> SqliteIndexStorage::getEdgesByType(int type) const {
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesBySourceType(Id sourceId, int type) const {
-  return doGetAll<StorageEdge>("WHERE source_node_id == " + std::to_string(sourceId) + " AND type == " + std::to_string(type));
+  return doGetAllByIds<StorageEdge>("source_node_id", {sourceId}, " AND type == " + std::to_string(type));
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesBySourcesType(const std::vector<Id>& sourceIds, int type) const {
-  return doGetAll<StorageEdge>("WHERE source_node_id IN (" + utility::join(utility::toStrings(sourceIds), ',') +
-                               ")"
-                               " AND type == " +
-                               std::to_string(type));
+  return doGetAllByIds<StorageEdge>("source_node_id", sourceIds, " AND type == " + std::to_string(type));
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesByTargetType(Id targetId, int type) const {
-  return doGetAll<StorageEdge>("WHERE target_node_id == " + std::to_string(targetId) + " AND type == " + std::to_string(type));
+  return doGetAllByIds<StorageEdge>("target_node_id", {targetId}, " AND type == " + std::to_string(type));
 }
 
 std::vector<StorageEdge> SqliteIndexStorage::getEdgesByTargetsType(const std::vector<Id>& targetIds, int type) const {
-  return doGetAll<StorageEdge>("WHERE target_node_id IN (" + utility::join(utility::toStrings(targetIds), ',') +
-                               ")"
-                               " AND type == " +
-                               std::to_string(type));
+  return doGetAllByIds<StorageEdge>("target_node_id", targetIds, " AND type == " + std::to_string(type));
 }
 
-StorageNode SqliteIndexStorage::getNodeById(Id id) const {
-  std::vector<StorageNode> candidates = doGetAll<StorageNode>("WHERE id = " + std::to_string(id));
-
-  if(candidates.size() > 0) {
-    return candidates[0];
-  }
+int SqliteIndexStorage::getEdgeCountByTargetIdWithoutType(Id targetId, int type) const {
+  CachedStatement stmt = getCachedStatement("SELECT COUNT(*) FROM edge WHERE target_node_id == ? AND type != ?;");
+  stmt->bind(1, int(targetId));
+  stmt->bind(2, type);
+  return executeStatementScalar(*stmt, 0);
+}
 
-  return StorageNode();
+StorageNode SqliteIndexStorage::getNodeById(Id id) const {
+  return getFirstById<StorageNode>(id);
 }
 
 StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& serializedName) const {
@@ -651,7 +675,7 @@ StorageNode SqliteIndexStorage::getNodeBySerializedName(const std::wstring& seri
 }
 
 std::vector<int> SqliteIndexStorage::getAvailableNodeTypes() const {
-  CppSQLite3Query q = executeQuery("SELECT DISTINCT type FROM node;");
+  Query q = executeQuery("SELECT DISTINCT type FROM node;");
 
   std::vector<int> types;
 
@@ -668,7 +692,7 @@ std::vector<int> SqliteIndexStorage::getAvailableNodeTypes() const {
 }
 
 std::vector<int> SqliteIndexStorage::getAvailableEdgeTypes() const {
-  CppSQLite3Query q = executeQuery("SELECT DISTINCT type FROM edge;");
+  Query q = executeQuery("SELECT DISTINCT type FROM edge;");
 
   std::vector<int> types;
 
@@ -685,7 +709,15 @@ std::vector<int> SqliteIndexStorage::getAvailableEdgeTypes() const {
 }
 
 StorageFile SqliteIndexStorage::getFileByPath(const std::wstring& filePath) const {
-  return doGetFirst<StorageFile>("WHERE file.path == '" + utility::encodeToUtf8(filePath) + "'");
+  CachedStatement stmt = getCachedStatement(getSelectClause<StorageFile>() + "WHERE file.path == ? LIMIT 1;");
+  stmt->bind(1, utility::encodeToUtf8(filePath).c_str());
+
+  StorageFile file;
+  {
+    CppSQLite3Query q = executeQuery(*stmt);
+    forEachRow<StorageFile>(q, [&file](StorageFile&& f) { file = std::move(f); });
+  }
+  return file;
 }
 
 std::vector<StorageFile> SqliteIndexStorage::getFilesByPaths(const std::vector<FilePath>& filePaths) const {
@@ -693,17 +725,20 @@ std::vector<StorageFile> SqliteIndexStorage::getFilesByPaths(const std::vector<F
 }
 
 std::shared_ptr<TextAccess> SqliteIndexStorage::getFileContentById(Id fileId) const {
-  CppSQLite3Query q = executeQuery("SELECT content FROM filecontent WHERE id = '" + std::to_string(fileId) + "';");
-  if(!q.eof()) {
-    return TextAccess::createFromString(q.getStringField(0, ""));
-  }
+  CachedStatement stmt = getCachedStatement("SELECT content FROM filecontent WHERE id = ?;");
+  stmt->bind(1, int(fileId));
 
-  return TextAccess::createFromString("");
+  std::shared_ptr<TextAccess> content;
+  {
+    CppSQLite3Query q = executeQuery(*stmt);
+    content = TextAccess::createFromString(!q.eof() ? q.getStringField(0, "") : "");
+  }
+  return content;
 }
 
 std::shared_ptr<TextAccess> SqliteIndexStorage::getFileContentByPath(const std::wstring& filePath) const {
   try {
-    CppSQLite3Query q = executeQuery(
+    Query q = executeQuery(
         "SELECT filecontent.content "
         "FROM filecontent "
         "INNER JOIN file ON filecontent.id = file.id "
@@ -800,40 +835,46 @@ std::shared_ptr<SourceLocationCollection> SqliteIndexStorage::getSourceLocations
     sourceLocationIdToElementIds[occurrence.sourceLocationId].push_back(occurrence.elementId);
   }
 
-  CppSQLite3Query q = executeQuery(
-      "SELECT source_location.id, file.path, source_location.start_line, "
-      "source_location.start_column, "
-      "source_location.end_line, source_location.end_column, source_location.type "
-      "FROM source_location INNER JOIN file ON (file.id = source_location.file_node_id) "
-      "WHERE source_location.id IN (" +
-      utility::join(utility::toStrings(sourceLocationIds), ',') + ");");
-
   std::shared_ptr<SourceLocationCollection> ret = std::make_shared<SourceLocationCollection>();
 
-  while(!q.eof()) {
-    const Id id = q.getIntField(0, 0);
-    const std::string filePath = q.getStringField(1, "");
-    const int startLineNumber = q.getIntField(2, -1);
-    const int startColNumber = q.getIntField(3, -1);
-    const int endLineNumber = q.getIntField(4, -1);
-    const int endColNumber = q.getIntField(5, -1);
-    const int type = q.getIntField(6, -1);
-
-    if(id != 0 && filePath.size() && startLineNumber != -1 && startColNumber != -1 && endLineNumber != -1 && endColNumber != -1 &&
-       type != -1) {
-      ret->addSourceLocation(intToLocationType(type),
-                             id,
-                             sourceLocationIdToElementIds[id],
-                             FilePath(utility::decodeFromUtf8(filePath)),
-                             startLineNumber,
-                             startColNumber,
-                             endLineNumber,
-                             endColNumber);
-    }
-
-    q.nextRow();
+  if(sourceLocationIds.empty()) {
+    return ret;
   }
 
+  executeQueryForIds(
+      "SELECT source_location.id, file.path, source_location.start_line, "
+      "source_location.start_column, "
+      "source_location.end_line, source_location.end_column, source_location.type "
+      "FROM source_location INNER JOIN file ON (file.id = source_location.file_node_id) ",
+      "source_location.id",
+      sourceLocationIds,
+      "",
+      [&ret, &sourceLocationIdToElementIds](CppSQLite3Query& q) {
+        while(!q.eof()) {
+          const Id id = q.getIntField(0, 0);
+          const std::string filePath = q.getStringField(1, "");
+          const int startLineNumber = q.getIntField(2, -1);
+          const int startColNumber = q.getIntField(3, -1);
+          const int endLineNumber = q.getIntField(4, -1);
+          const int endColNumber = q.getIntField(5, -1);
+          const int type = q.getIntField(6, -1);
+
+          if(id != 0 && filePath.size() && startLineNumber != -1 && startColNumber != -1 && endLineNumber != -1 &&
+             endColNumber != -1 && type != -1) {
+            ret->addSourceLocation(intToLocationType(type),
+                                   id,
+                                   sourceLocationIdToElementIds[id],
+                                   FilePath(utility::decodeFromUtf8(filePath)),
+                                   startLineNumber,
+                                   startColNumber,
+                                   endLineNumber,
+                                   endColNumber);
+          }
+
+          q.nextRow();
+        }
+      });
+
   return ret;
 }
 
@@ -843,29 +884,35 @@ std::vector<StorageOccurrence> SqliteIndexStorage::getOccurrencesForLocationId(I
 }
 
 std::vector<StorageOccurrence> SqliteIndexStorage::getOccurrencesForLocationIds(const std::vector<Id>& locationIds) const {
-  return doGetAll<StorageOccurrence>("WHERE source_location_id IN (" + utility::join(utility::toStrings(locationIds), ',') + ")");
+  return doGetAllByIds<StorageOccurrence>("source_location_id", locationIds);
 }
 
 std::vector<StorageOccurrence> SqliteIndexStorage::getOccurrencesForElementIds(const std::vector<Id>& elementIds) const {
-  return doGetAll<StorageOccurrence>("WHERE element_id IN (" + utility::join(utility::toStrings(elementIds), ',') + ")");
+  return doGetAllByIds<StorageOccurrence>("element_id", elementIds);
+}
+
+StorageOccurrence SqliteIndexStorage::getFirstOccurrenceForElementId(Id elementId) const {
+  std::vector<StorageOccurrence> occurrences = doGetAllByIds<StorageOccurrence>("element_id", {elementId}, " LIMIT 1");
+  return occurrences.size() ? occurrences[0] : StorageOccurrence();
 }
 
 StorageComponentAccess SqliteIndexStorage::getComponentAccessByNodeId(Id nodeId) const {
-  return doGetFirst<StorageComponentAccess>("WHERE node_id == " + std::to_string(nodeId));
+  std::vector<StorageComponentAccess> accesses = doGetAllByIds<StorageComponentAccess>("node_id", {nodeId});
+  return accesses.size() ? accesses[0] : StorageComponentAccess();
 }
 
 std::vector<StorageComponentAccess> SqliteIndexStorage::getComponentAccessesByNodeIds(const std::vector<Id>& nodeIds) const {
-  return doGetAll<StorageComponentAccess>("WHERE node_id IN (" + utility::join(utility::toStrings(nodeIds), ',') + ")");
+  return doGetAllByIds<StorageComponentAccess>("node_id", nodeIds);
 }
 
 std::vector<StorageElementComponent> SqliteIndexStorage::getElementComponentsByElementIds(const std::vector<Id>& elementIds) const {
-  return doGetAll<StorageElementComponent>("WHERE element_id IN (" + utility::join(utility::toStrings(elementIds), ',') + ")");
+  return doGetAllByIds<StorageElementComponent>("element_id", elementIds);
 }
 
 std::vector<ErrorInfo> SqliteIndexStorage::getAllErrorInfos() const {
   std::vector<ErrorInfo> errorInfos;
 
-  CppSQLite3Query q = executeQuery(
+  Query q = executeQuery(
       "SELECT error.id, error.message, error.fatal, error.indexed, error.translation_unit, "
       "file.path, source_location.start_line, source_location.start_column "
       "FROM occurrence "
@@ -972,6 +1019,7 @@ std::vector<std::pair<int, SqliteDatabaseIndex>> SqliteIndexStorage::getIndices(
 
 void SqliteIndexStorage::clearTables() {
   try {
+    m_database.execDML("DROP TABLE IF EXISTS main.file_dependency;");
     m_database.execDML("DROP TABLE IF EXISTS main.error;");
     m_database.execDML("DROP TABLE IF EXISTS main.component_access;");
     m_database.execDML("DROP TABLE IF EXISTS main.occurrence;");
@@ -1097,6 +1145,15 @@ void SqliteIndexStorage::setupTables() {
         "translation_unit TEXT, "
         "PRIMARY KEY(id), "
         "FOREIGN KEY(id) REFERENCES element(id) ON DELETE CASCADE);");
+
+    m_database.execDML(
+        "CREATE TABLE IF NOT EXISTS file_dependency("
+        "file_id INTEGER NOT NULL, "
+        "referencing_file_id INTEGER NOT NULL, "
+        "type INTEGER NOT NULL, "
+        "PRIMARY KEY(file_id, referencing_file_id, type), "
+        "FOREIGN KEY(file_id) REFERENCES node(id) ON DELETE CASCADE, "
+        "FOREIGN KEY(referencing_file_id) REFERENCES node(id) ON DELETE CASCADE) WITHOUT ROWID;");
   } catch(CppSQLite3Exception& e) {
     LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
 
@@ -1170,6 +1227,15 @@ void SqliteIndexStorage::setupPrecompiledStatements() {
           stmt.bind(int(index) * 2 + 2, int(componentAccess.type));
         },
         m_database);
+    m_insertFileDependencyBatchStatement.compile(
+        "INSERT OR IGNORE INTO file_dependency(file_id, referencing_file_id, type) VALUES",
+        3,
+        [](CppSQLite3Statement& stmt, const StorageFileDependency& dependency, size_t index) {
+          stmt.bind(int(index) * 3 + 1, int(dependency.fileId));
+          stmt.bind(int(index) * 3 + 2, int(dependency.referencingFileId));
+          stmt.bind(int(index) * 3 + 3, dependency.type);
+        },
+        m_database);
 
     m_insertElementStmt = m_database.compileStatement("INSERT INTO element(id) VALUES(NULL);");
     m_insertElementComponentStmt = m_database.compileStatement(
@@ -1195,18 +1261,99 @@ void SqliteIndexStorage::setupPrecompiledStatements() {
   }
 }
 
+void SqliteIndexStorage::executeQueryForIds(const std::string& selectClause,
+                                            const std::string& column,
+                                            std::vector<Id> ids,
+                                            const std::string& condition,
+                                            std::function<void(CppSQLite3Query&)> func) const {
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+  size_t batchSize = MAX_BOUND_ID_COUNT;
+  size_t i = 0;
+  while(i < ids.size()) {
+    while(ids.size() - i < batchSize) {
+      batchSize /= 2;
+    }
+
+    try {
+      CachedStatement stmt = getCachedStatement(selectClause + "WHERE " + column + " IN (" + getParameterList(batchSize) +
+                                                 ")" + condition + ";");
+      for(size_t j = 0; j < batchSize; j++) {
+        stmt->bind(static_cast<int>(j + 1), static_cast<int>(ids[i + j]));
+      }
+
+      {
+        CppSQLite3Query q = executeQuery(*stmt);
+        func(q);
+      }
+    } catch(CppSQLite3Exception& e) {
+      LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
+    }
+
+    i += batchSize;
+  }
+}
+
+bool SqliteIndexStorage::readRow(CppSQLite3Query& q, NodeRow& row) {
+  row.id = q.getIntField(0, 0);
+  row.type = q.getIntField(1, -1);
+  row.serializedName = q.getStringField(2, "");
+  return row.id != 0 && row.type != -1;
+}
+
+bool SqliteIndexStorage::readRow(CppSQLite3Query& q, StorageEdge& row) {
+  row.id = q.getIntField(0, 0);
+  row.type = q.getIntField(1, -1);
+  row.sourceNodeId = q.getIntField(2, 0);
+  row.targetNodeId = q.getIntField(3, 0);
+  return row.id != 0 && row.type != -1;
+}
+
+bool SqliteIndexStorage::readRow(CppSQLite3Query& q, StorageSymbol& row) {
+  row.id = q.getIntField(0, 0);
+  row.definitionKind = q.getIntField(1, 0);
+  return row.id != 0;
+}
+
+bool SqliteIndexStorage::readRow(CppSQLite3Query& q, StorageOccurrence& row) {
+  row.elementId = q.getIntField(0, 0);
+  row.sourceLocationId = q.getIntField(1, 0);
+  return row.elementId != 0 && row.sourceLocationId != 0;
+}
+
+bool SqliteIndexStorage::readRow(CppSQLite3Query& q, StorageSourceLocation& row) {
+  row.id = q.getIntField(0, 0);
+  row.fileNodeId = q.getIntField(1, 0);
+  const int startLineNumber = q.getIntField(2, -1);
+  const int startColNumber = q.getIntField(3, -1);
+  const int endLineNumber = q.getIntField(4, -1);
+  const int endColNumber = q.getIntField(5, -1);
+  row.type = q.getIntField(6, -1);
+
+  if(row.id == 0 || row.fileNodeId == 0 || startLineNumber == -1 || startColNumber == -1 || endLineNumber == -1 ||
+     endColNumber == -1 || row.type == -1) {
+    return false;
+  }
+
+  row.startLine = startLineNumber;
+  row.startCol = startColNumber;
+  row.endLine = endLineNumber;
+  row.endCol = endColNumber;
+  return true;
+}
+
 template <>
-void SqliteIndexStorage::forEach<StorageEdge>(const std::string& query, std::function<void(StorageEdge&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, type, source_node_id, target_node_id FROM edge " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageEdge>() {
+  return "SELECT id, type, source_node_id, target_node_id FROM edge ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageEdge>(CppSQLite3Query& q, std::function<void(StorageEdge&&)> func) const {
+  StorageEdge edge;
   while(!q.eof()) {
-    const Id id = q.getIntField(0, 0);
-    const int type = q.getIntField(1, -1);
-    const Id sourceId = q.getIntField(2, 0);
-    const Id targetId = q.getIntField(3, 0);
-
-    if(id != 0 && type != -1) {
-      func(StorageEdge(id, type, sourceId, targetId));
+    if(readRow(q, edge)) {
+      func(StorageEdge(edge));
     }
 
     q.nextRow();
@@ -1214,16 +1361,21 @@ void SqliteIndexStorage::forEach<StorageEdge>(const std::string& query, std::fun
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageNode>(const std::string& query, std::function<void(StorageNode&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, type, serialized_name FROM node " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageNode>() {
+  return "SELECT id, type, serialized_name FROM node ";
+}
 
-  while(!q.eof()) {
-    const Id id = q.getIntField(0, 0);
-    const int type = q.getIntField(1, -1);
-    const std::string serializedName = q.getStringField(2, "");
+template <>
+std::string SqliteIndexStorage::getSelectClause<SqliteIndexStorage::NodeRow>() {
+  return getSelectClause<StorageNode>();
+}
 
-    if(id != 0 && type != -1) {
-      func(StorageNode(id, type, utility::decodeFromUtf8(serializedName)));
+template <>
+void SqliteIndexStorage::forEachRow<StorageNode>(CppSQLite3Query& q, std::function<void(StorageNode&&)> func) const {
+  NodeRow row;
+  while(!q.eof()) {
+    if(readRow(q, row)) {
+      func(StorageNode(row.id, row.type, utility::decodeFromUtf8(std::string(row.serializedName))));
     }
 
     q.nextRow();
@@ -1231,15 +1383,16 @@ void SqliteIndexStorage::forEach<StorageNode>(const std::string& query, std::fun
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageSymbol>(const std::string& query, std::function<void(StorageSymbol&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, definition_kind FROM symbol " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageSymbol>() {
+  return "SELECT id, definition_kind FROM symbol ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageSymbol>(CppSQLite3Query& q, std::function<void(StorageSymbol&&)> func) const {
+  StorageSymbol symbol;
   while(!q.eof()) {
-    const Id id = q.getIntField(0, 0);
-    const int definitionKind = q.getIntField(1, 0);
-
-    if(id != 0) {
-      func(StorageSymbol(id, definitionKind));
+    if(readRow(q, symbol)) {
+      func(StorageSymbol(symbol));
     }
 
     q.nextRow();
@@ -1247,9 +1400,12 @@ void SqliteIndexStorage::forEach<StorageSymbol>(const std::string& query, std::f
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageFile>(const std::string& query, std::function<void(StorageFile&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, path, language, modification_time, indexed, complete FROM file " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageFile>() {
+  return "SELECT id, path, language, modification_time, indexed, complete FROM file ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageFile>(CppSQLite3Query& q, std::function<void(StorageFile&&)> func) const {
   while(!q.eof()) {
     const Id id = q.getIntField(0, 0);
     const std::string filePath = q.getStringField(1, "");
@@ -1267,10 +1423,13 @@ void SqliteIndexStorage::forEach<StorageFile>(const std::string& query, std::fun
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageLocalSymbol>(const std::string& query,
-                                                     std::function<void(StorageLocalSymbol&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, name FROM local_symbol " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageLocalSymbol>() {
+  return "SELECT id, name FROM local_symbol ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageLocalSymbol>(CppSQLite3Query& q,
+                                                        std::function<void(StorageLocalSymbol&&)> func) const {
   while(!q.eof()) {
     const Id id = q.getIntField(0, 0);
     const std::string name = q.getStringField(1, "");
@@ -1284,25 +1443,17 @@ void SqliteIndexStorage::forEach<StorageLocalSymbol>(const std::string& query,
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageSourceLocation>(const std::string& query,
-                                                        std::function<void(StorageSourceLocation&&)> func) const {
-  CppSQLite3Query q = executeQuery(
-      "SELECT id, file_node_id, start_line, start_column, end_line, end_column, type FROM "
-      "source_location " +
-      query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageSourceLocation>() {
+  return "SELECT id, file_node_id, start_line, start_column, end_line, end_column, type FROM source_location ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageSourceLocation>(CppSQLite3Query& q,
+                                                           std::function<void(StorageSourceLocation&&)> func) const {
+  StorageSourceLocation location;
   while(!q.eof()) {
-    const Id id = q.getIntField(0, 0);
-    const Id fileNodeId = q.getIntField(1, 0);
-    const int startLineNumber = q.getIntField(2, -1);
-    const int startColNumber = q.getIntField(3, -1);
-    const int endLineNumber = q.getIntField(4, -1);
-    const int endColNumber = q.getIntField(5, -1);
-    const int type = q.getIntField(6, -1);
-
-    if(id != 0 && fileNodeId != 0 && startLineNumber != -1 && startColNumber != -1 && endLineNumber != -1 && endColNumber != -1 &&
-       type != -1) {
-      func(StorageSourceLocation(id, fileNodeId, startLineNumber, startColNumber, endLineNumber, endColNumber, type));
+    if(readRow(q, location)) {
+      func(StorageSourceLocation(location));
     }
 
     q.nextRow();
@@ -1310,15 +1461,16 @@ void SqliteIndexStorage::forEach<StorageSourceLocation>(const std::string& query
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageOccurrence>(const std::string& query, std::function<void(StorageOccurrence&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT element_id, source_location_id FROM occurrence " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageOccurrence>() {
+  return "SELECT element_id, source_location_id FROM occurrence ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageOccurrence>(CppSQLite3Query& q, std::function<void(StorageOccurrence&&)> func) const {
+  StorageOccurrence occurrence;
   while(!q.eof()) {
-    const Id elementId = q.getIntField(0, 0);
-    const Id sourceLocationId = q.getIntField(1, 0);
-
-    if(elementId != 0 && sourceLocationId != 0) {
-      func(StorageOccurrence(elementId, sourceLocationId));
+    if(readRow(q, occurrence)) {
+      func(StorageOccurrence(occurrence));
     }
 
     q.nextRow();
@@ -1326,10 +1478,13 @@ void SqliteIndexStorage::forEach<StorageOccurrence>(const std::string& query, st
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageComponentAccess>(const std::string& query,
-                                                         std::function<void(StorageComponentAccess&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT node_id, type FROM component_access " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageComponentAccess>() {
+  return "SELECT node_id, type FROM component_access ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageComponentAccess>(CppSQLite3Query& q,
+                                                            std::function<void(StorageComponentAccess&&)> func) const {
   while(!q.eof()) {
     const Id nodeId = q.getIntField(0, 0);
     const int type = q.getIntField(1, -1);
@@ -1343,10 +1498,13 @@ void SqliteIndexStorage::forEach<StorageComponentAccess>(const std::string& quer
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageElementComponent>(const std::string& query,
-                                                          std::function<void(StorageElementComponent&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT element_id, type, data FROM element_component " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageElementComponent>() {
+  return "SELECT element_id, type, data FROM element_component ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageElementComponent>(CppSQLite3Query& q,
+                                                             std::function<void(StorageElementComponent&&)> func) const {
   while(!q.eof()) {
     const Id elementId = static_cast<uint32_t>(q.getIntField(0, 0));
     const int type = q.getIntField(1, -1);
@@ -1361,9 +1519,12 @@ void SqliteIndexStorage::forEach<StorageElementComponent>(const std::string& que
 }
 
 template <>
-void SqliteIndexStorage::forEach<StorageError>(const std::string& query, std::function<void(StorageError&&)> func) const {
-  CppSQLite3Query q = executeQuery("SELECT id, message, fatal, indexed, translation_unit FROM error " + query + ";");
+std::string SqliteIndexStorage::getSelectClause<StorageError>() {
+  return "SELECT id, message, fatal, indexed, translation_unit FROM error ";
+}
 
+template <>
+void SqliteIndexStorage::forEachRow<StorageError>(CppSQLite3Query& q, std::function<void(StorageError&&)> func) const {
   while(!q.eof()) {
     const Id id = static_cast<uint32_t>(q.getIntField(0, 0));
     const std::string message = q.getStringField(1, "");
@@ -1378,3 +1539,24 @@ void SqliteIndexStorage::forEach<StorageError>(const std::string& query, std::fu
     q.nextRow();
   }
 }
+
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageFileDependency>() {
+  return "SELECT file_id, referencing_file_id, type FROM file_dependency ";
+}
+
+template <>
+void SqliteIndexStorage::forEachRow<StorageFileDependency>(CppSQLite3Query& q,
+                                                           std::function<void(StorageFileDependency&&)> func) const {
+  while(!q.eof()) {
+    const Id fileId = static_cast<uint32_t>(q.getIntField(0, 0));
+    const Id referencingFileId = static_cast<uint32_t>(q.getIntField(1, 0));
+    const int type = q.getIntField(2, -1);
+
+    if(fileId != 0 && referencingFileId != 0 && type != -1) {
+      func(StorageFileDependency(fileId, referencingFileId, type));
+    }
+
+    q.nextRow();
+  }
+}
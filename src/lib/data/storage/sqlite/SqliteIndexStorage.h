@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ErrorInfo.h"
@@ -14,6 +15,7 @@
 #include "StorageElementComponent.h"
 #include "StorageError.h"
 #include "StorageFile.h"
+#include "StorageFileDependency.h"
 #include "StorageLocalSymbol.h"
 #include "StorageNode.h"
 #include "StorageOccurrence.h"
@@ -34,6 +36,14 @@ public:
 
   enum StorageModeType { STORAGE_MODE_READ = 1, STORAGE_MODE_WRITE = 2, STORAGE_MODE_CLEAR = 4 };
 
+  // Node row handed out by scan(). The serialized name points into SQLite's memory and is still UTF-8
+  // encoded, so it is only valid while the visitor runs and rows that get skipped are never decoded.
+  struct NodeRow {
+    Id id = 0;
+    int type = 0;
+    std::string_view serializedName;
+  };
+
   SqliteIndexStorage(const FilePath& dbFilePath);
 
   virtual size_t getStaticVersion() const;
@@ -71,6 +81,12 @@ public:
 
   void removeAllErrors();
 
+  // replaces the stored dependencies between files, which are derived from the include and import edges
+  void setFileDependencies(const std::vector<StorageFileDependency>& dependencies);
+  // false while the stored dependencies may not match the edges, e.g. after an interrupted indexing
+  bool getFileDependenciesComplete() const;
+  void setFileDependenciesComplete(bool complete);
+
   bool isEdge(Id elementId) const;
   bool isNode(Id elementId) const;
   bool isFile(Id elementId) const;
@@ -89,6 +105,7 @@ public:
   std::vector<StorageEdge> getEdgesBySourcesType(const std::vector<Id>& sourceIds, int type) const;
   std::vector<StorageEdge> getEdgesByTargetType(Id targetId, int type) const;
   std::vector<StorageEdge> getEdgesByTargetsType(const std::vector<Id>& targetIds, int type) const;
+  int getEdgeCountByTargetIdWithoutType(Id targetId, int type) const;
 
   StorageNode getNodeById(Id id) const;
   StorageNode getNodeBySerializedName(const std::wstring& serializedName) const;
@@ -117,6 +134,7 @@ public:
   std::vector<StorageOccurrence> getOccurrencesForLocationId(Id locationId) const;
   std::vector<StorageOccurrence> getOccurrencesForLocationIds(const std::vector<Id>& locationIds) const;
   std::vector<StorageOccurrence> getOccurrencesForElementIds(const std::vector<Id>& elementIds) const;
+  StorageOccurrence getFirstOccurrenceForElementId(Id elementId) const;
 
   StorageComponentAccess getComponentAccessByNodeId(Id nodeId) const;
   std::vector<StorageComponentAccess> getComponentAccessesByNodeIds(const std::vector<Id>& nodeIds) const;
@@ -133,17 +151,17 @@ public:
   template <typename ResultType>
   ResultType getFirstById(const Id id) const {
     if(id != 0) {
-      return doGetFirst<ResultType>("WHERE id == " + std::to_string(id));
+      std::vector<ResultType> results = doGetAllByIds<ResultType>("id", {id});
+      if(results.size() > 0) {
+        return results[0];
+      }
     }
     return ResultType();
   }
 
   template <typename ResultType>
   std::vector<ResultType> getAllByIds(const std::vector<Id>& ids) const {
-    if(ids.size()) {
-      return doGetAll<ResultType>("WHERE id IN (" + utility::join(utility::toStrings(ids), ',') + ")");
-    }
-    return std::vector<ResultType>();
+    return doGetAllByIds<ResultType>("id", ids);
   }
 
   template <typename StorageType>
@@ -151,18 +169,25 @@ public:
     forEach("", func);
   }
 
-  template <typename StorageType>
-  void forEachOfType(int type, std::function<void(StorageType&&)> func) const {
-    forEach("WHERE type == " + std::to_string(type), func);
-  }
-
   template <typename StorageType>
   void forEachByIds(const std::vector<Id> ids, std::function<void(StorageType&&)> func) const {
-    if(ids.size()) {
-      forEach("WHERE id IN (" + utility::join(utility::toStrings(ids), ',') + ")", func);
+    for(StorageType& element : doGetAllByIds<StorageType>("id", ids)) {
+      func(std::move(element));
     }
   }
 
+  // Full table scan that decodes every row into the same RowType buffer and calls visitor(const RowType&).
+  // Supported row types are NodeRow, StorageEdge, StorageSymbol, StorageOccurrence and StorageSourceLocation.
+  template <typename RowType, typename Visitor>
+  void scan(Visitor&& visitor) const {
+    scan<RowType>("", std::forward<Visitor>(visitor));
+  }
+
+  template <typename RowType, typename Visitor>
+  void scanOfType(int type, Visitor&& visitor) const {
+    scan<RowType>("WHERE type == " + std::to_string(type), std::forward<Visitor>(visitor));
+  }
+
   int getNodeCount() const;
   int getEdgeCount() const;
   int getFileCount() const;
@@ -208,7 +233,7 @@ private:
   template <typename ResultType>
   std::vector<ResultType> doGetAll(const std::string& query) const {
     std::vector<ResultType> elements;
-    forEach<ResultType>(query, [&elements](ResultType&& element) { elements.emplace_back(element); });
+    forEach<ResultType>(query, [&elements](ResultType&& element) { elements.emplace_back(std::move(element)); });
     return elements;
   }
 
@@ -221,8 +246,60 @@ private:
     return ResultType();
   }
 
+  // Runs "<selectClause>WHERE <column> IN (?, ...)<condition>" for chunks of the sorted and deduplicated ids.
+  // Chunk sizes are powers of two, so each query shape compiles to a handful of cached statements that are
+  // reused across calls instead of re-parsing a statement with all ids inlined.
+  void executeQueryForIds(const std::string& selectClause,
+                          const std::string& column,
+                          std::vector<Id> ids,
+                          const std::string& condition,
+                          std::function<void(CppSQLite3Query&)> func) const;
+
+  template <typename ResultType>
+  std::vector<ResultType> doGetAllByIds(const std::string& column,
+                                        const std::vector<Id>& ids,
+                                        const std::string& condition = "") const {
+    // rows are collected before they are handed out, so callers may query again with the same cached statement
+    std::vector<ResultType> elements;
+    if(ids.size()) {
+      executeQueryForIds(getSelectClause<ResultType>(), column, ids, condition, [this, &elements](CppSQLite3Query& q) {
+        forEachRow<ResultType>(q, [&elements](ResultType&& element) { elements.emplace_back(std::move(element)); });
+      });
+    }
+    return elements;
+  }
+
+  template <typename StorageType>
+  void forEach(const std::string& query, std::function<void(StorageType&&)> func) const {
+    Query q = executeQuery(getSelectClause<StorageType>() + query + ";");
+    forEachRow<StorageType>(q, func);
+  }
+
+  template <typename RowType, typename Visitor>
+  void scan(const std::string& query, Visitor&& visitor) const {
+    Query q = executeQuery(getSelectClause<RowType>() + query + ";");
+
+    RowType row;
+    while(!q.eof()) {
+      if(readRow(q, row)) {
+        visitor(static_cast<const RowType&>(row));
+      }
+      q.nextRow();
+    }
+  }
+
+  // return false for rows that are incomplete and need to be skipped
+  static bool readRow(CppSQLite3Query& q, NodeRow& row);
+  static bool readRow(CppSQLite3Query& q, StorageEdge& row);
+  static bool readRow(CppSQLite3Query& q, StorageSymbol& row);
+  static bool readRow(CppSQLite3Query& q, StorageOccurrence& row);
+  static bool readRow(CppSQLite3Query& q, StorageSourceLocation& row);
+
+  template <typename StorageType>
+  static std::string getSelectClause();
+
   template <typename StorageType>
-  void forEach(const std::string& query, std::function<void(StorageType&&)> func) const;
+  void forEachRow(CppSQLite3Query& q, std::function<void(StorageType&&)> func) const;
 
   LowMemoryStringMap<std::string, uint32_t, 0> m_tempNodeNameIndex;
   LowMemoryStringMap<std::wstring, uint32_t, 0> m_tempWNodeNameIndex;
@@ -303,6 +380,7 @@ private:
   InsertBatchStatement<StorageSourceLocationData> m_insertSourceLocationBatchStatement;
   InsertBatchStatement<StorageOccurrence> m_insertOccurrenceBatchStatement;
   InsertBatchStatement<StorageComponentAccess> m_insertComponentAccessBatchStatement;
+  InsertBatchStatement<StorageFileDependency> m_insertFileDependencyBatchStatement;
 
   CppSQLite3Statement m_insertElementStmt;
   CppSQLite3Statement m_insertElementComponentStmt;
@@ -313,25 +391,52 @@ private:
 };
 
 template <>
-void SqliteIndexStorage::forEach<StorageEdge>(const std::string& query, std::function<void(StorageEdge&&)> func) const;
+std::string SqliteIndexStorage::getSelectClause<StorageEdge>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageNode>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<SqliteIndexStorage::NodeRow>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageSymbol>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageFile>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageLocalSymbol>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageSourceLocation>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageOccurrence>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageComponentAccess>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageElementComponent>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageError>();
+template <>
+std::string SqliteIndexStorage::getSelectClause<StorageFileDependency>();
+template <>
+void SqliteIndexStorage::forEachRow<StorageEdge>(CppSQLite3Query& q, std::function<void(StorageEdge&&)> func) const;
+template <>
+void SqliteIndexStorage::forEachRow<StorageNode>(CppSQLite3Query& q, std::function<void(StorageNode&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageNode>(const std::string& query, std::function<void(StorageNode&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageSymbol>(CppSQLite3Query& q, std::function<void(StorageSymbol&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageSymbol>(const std::string& query, std::function<void(StorageSymbol&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageFile>(CppSQLite3Query& q, std::function<void(StorageFile&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageFile>(const std::string& query, std::function<void(StorageFile&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageLocalSymbol>(CppSQLite3Query& q, std::function<void(StorageLocalSymbol&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageLocalSymbol>(const std::string& query, std::function<void(StorageLocalSymbol&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageSourceLocation>(CppSQLite3Query& q,
+                                                           std::function<void(StorageSourceLocation&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageSourceLocation>(const std::string& query,
-                                                        std::function<void(StorageSourceLocation&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageOccurrence>(CppSQLite3Query& q, std::function<void(StorageOccurrence&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageOccurrence>(const std::string& query, std::function<void(StorageOccurrence&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageComponentAccess>(CppSQLite3Query& q,
+                                                            std::function<void(StorageComponentAccess&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageComponentAccess>(const std::string& query,
-                                                         std::function<void(StorageComponentAccess&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageElementComponent>(CppSQLite3Query& q,
+                                                             std::function<void(StorageElementComponent&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageElementComponent>(const std::string& query,
-                                                          std::function<void(StorageElementComponent&&)> func) const;
+void SqliteIndexStorage::forEachRow<StorageError>(CppSQLite3Query& q, std::function<void(StorageError&&)> func) const;
 template <>
-void SqliteIndexStorage::forEach<StorageError>(const std::string& query, std::function<void(StorageError&&)> func) const;
\ No newline at end of file
+void SqliteIndexStorage::forEachRow<StorageFileDependency>(CppSQLite3Query& q,
+                                                           std::function<void(StorageFileDependency&&)> func) const;
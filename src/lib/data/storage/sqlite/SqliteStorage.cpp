@@ -1,11 +1,79 @@
 #include "SqliteStorage.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "FileSystem.h"
 #include "logging.h"
 #include "TimeStamp.h"
 #include "utilityString.h"
 
-SqliteStorage::SqliteStorage(const FilePath& dbFilePath) : m_dbFilePath(dbFilePath.getCanonical()) {
+namespace {
+constexpr int BULK_CACHE_SIZE_KIB = 256 * 1024;
+constexpr long long BULK_MMAP_SIZE_BYTES = 1024LL * 1024 * 1024;
+
+// runs the registered callbacks when the thread it belongs to exits
+struct ThreadExitCallbacks {
+  ~ThreadExitCallbacks() {
+    for(auto& [owner, callback] : callbacks) {
+      callback();
+    }
+  }
+
+  // adds the callback unless one of the same owner is registered already, callbacks of destroyed owners are dropped
+  void add(const std::weak_ptr<void>& owner, std::function<void()> callback) {
+    callbacks.erase(std::remove_if(callbacks.begin(),
+                                   callbacks.end(),
+                                   [](const auto& registered) { return registered.first.expired(); }),
+                    callbacks.end());
+
+    for(const auto& [registeredOwner, registeredCallback] : callbacks) {
+      if(!registeredOwner.owner_before(owner) && !owner.owner_before(registeredOwner)) {
+        return;
+      }
+    }
+    callbacks.emplace_back(owner, std::move(callback));
+  }
+
+  std::vector<std::pair<std::weak_ptr<void>, std::function<void()>>> callbacks;
+};
+
+thread_local ThreadExitCallbacks t_threadExitCallbacks;
+}    // namespace
+
+struct SqliteStorage::ReadConnection {
+  ReadConnection() = default;
+  ReadConnection(const ReadConnection&) = delete;
+  ReadConnection& operator=(const ReadConnection&) = delete;
+
+  ~ReadConnection() {
+    // cached statements need to be finalized, otherwise the database refuses to close
+    cachedStatements.clear();
+    try {
+      database.close();
+    } catch(CppSQLite3Exception& e) {
+      LOG_ERROR(e.errorMessage());
+    }
+  }
+
+  CppSQLite3DB database;
+  std::map<std::string, CppSQLite3Statement> cachedStatements;
+};
+
+struct SqliteStorage::ReadConnectionPool {
+  std::mutex mutex;
+  // a connection is only ever used by its thread, queries and cached statements hold a reference while running
+  std::map<std::thread::id, std::shared_ptr<ReadConnection>> connections;
+};
+
+SqliteStorage::Query::Query(std::shared_ptr<ReadConnection> connection, const CppSQLite3Query& query)
+    : ReadConnectionLease{std::move(connection)}, CppSQLite3Query(query) {}
+
+SqliteStorage::SqliteStorage(const FilePath& dbFilePath)
+    : m_dbFilePath(dbFilePath.getCanonical()), m_readConnectionPool(std::make_shared<ReadConnectionPool>()) {
   if(!m_dbFilePath.getParentDirectory().empty() && !m_dbFilePath.getParentDirectory().exists()) {
     FileSystem::createDirectory(m_dbFilePath.getParentDirectory());
   }
@@ -22,6 +90,14 @@ SqliteStorage::SqliteStorage(const FilePath& dbFilePath) : m_dbFilePath(dbFilePa
 }
 
 SqliteStorage::~SqliteStorage() {
+  clearReadConnections();
+
+  // cached statements need to be finalized, otherwise the database refuses to close
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_cachedStatementsMutex);
+    m_cachedStatements.clear();
+  }
+
   try {
     m_database.close();
   } catch(CppSQLite3Exception e) {
@@ -44,6 +120,11 @@ void SqliteStorage::setup() {
 }
 
 void SqliteStorage::clear() {
+  clearReadConnections();
+  {
+    std::lock_guard<std::recursive_mutex> lock(m_cachedStatementsMutex);
+    m_cachedStatements.clear();
+  }
   executeStatement("PRAGMA foreign_keys=OFF;");
   clearMetaTable();
   clearTables();
@@ -81,6 +162,94 @@ void SqliteStorage::optimizeMemory() const {
   executeStatement("VACUUM;");
 }
 
+void SqliteStorage::analyze() const {
+  executeStatement("ANALYZE;");
+}
+
+SqliteStorage::StorageProfileType SqliteStorage::intToStorageProfileType(int value) {
+  switch(value) {
+  case STORAGE_PROFILE_DEFAULT:
+    return STORAGE_PROFILE_DEFAULT;
+  case STORAGE_PROFILE_BULK_WAL:
+    return STORAGE_PROFILE_BULK_WAL;
+  case STORAGE_PROFILE_BULK_UNSAFE:
+    return STORAGE_PROFILE_BULK_UNSAFE;
+  default:
+    break;
+  }
+
+  LOG_WARNING("Unknown storage profile " + std::to_string(value) + ", using the default profile.");
+  return STORAGE_PROFILE_DEFAULT;
+}
+
+void SqliteStorage::setProfile(StorageProfileType profile) {
+  if(profile == m_profile) {
+    return;
+  }
+
+  const StorageProfileType previousProfile = m_profile;
+  m_profile = profile;
+
+  switch(profile) {
+  case STORAGE_PROFILE_BULK_WAL:
+  case STORAGE_PROFILE_BULK_UNSAFE:
+    executeStatement(profile == STORAGE_PROFILE_BULK_WAL ? "PRAGMA journal_mode=WAL;" : "PRAGMA journal_mode=OFF;");
+    executeStatement("PRAGMA synchronous=OFF;");
+    executeStatement("PRAGMA temp_store=MEMORY;");
+    executeStatement("PRAGMA cache_size=-" + std::to_string(BULK_CACHE_SIZE_KIB) + ";");
+    executeStatement("PRAGMA mmap_size=" + std::to_string(BULK_MMAP_SIZE_BYTES) + ";");
+    executeStatement("PRAGMA foreign_keys=OFF;");
+    break;
+  case STORAGE_PROFILE_DEFAULT:
+    // leaving WAL mode checkpoints the log, so the database is a single file again afterwards
+    executeStatement("PRAGMA journal_mode=DELETE;");
+    executeStatement("PRAGMA synchronous=FULL;");
+    executeStatement("PRAGMA temp_store=DEFAULT;");
+    executeStatement("PRAGMA cache_size=-2000;");
+    executeStatement("PRAGMA mmap_size=0;");
+    executeStatement("PRAGMA foreign_keys=ON;");
+
+    if(previousProfile != STORAGE_PROFILE_DEFAULT) {
+      Query q = executeQuery("PRAGMA foreign_key_check;");
+      size_t violationCount = 0;
+      while(!q.eof()) {
+        violationCount++;
+        q.nextRow();
+      }
+
+      if(violationCount > 0) {
+        LOG_WARNING_W(L"Database \"" + m_dbFilePath.wstr() + L"\" has " + std::to_wstring(violationCount) +
+                      L" foreign key violations after bulk insertion.");
+      }
+    }
+    break;
+  }
+}
+
+SqliteStorage::StorageProfileType SqliteStorage::getProfile() const {
+  return m_profile;
+}
+
+void SqliteStorage::setReadConnectionPoolEnabled(bool enabled) {
+  if(m_readConnectionPoolEnabled == enabled) {
+    return;
+  }
+
+  {
+    // no connection may be created between disabling the pool and clearing it
+    std::lock_guard<std::mutex> lock(m_readConnectionPool->mutex);
+    m_readConnectionPoolEnabled = enabled;
+  }
+
+  if(!enabled) {
+    clearReadConnections();
+  }
+}
+
+bool SqliteStorage::isReadConnectionPoolEnabled() const {
+  return m_readConnectionPoolEnabled;
+}
+
 FilePath SqliteStorage::getDbFilePath() const {
   return m_dbFilePath;
 }
@@ -155,7 +324,11 @@ bool SqliteStorage::executeStatement(CppSQLite3Statement& statement) const {
 int SqliteStorage::executeStatementScalar(const std::string& statement, const int nullValue) const {
   int ret = 0;
   try {
-    ret = m_database.execScalar(statement.c_str(), nullValue);
+    if(std::shared_ptr<ReadConnection> connection = getReadConnection()) {
+      ret = connection->database.execScalar(statement.c_str(), nullValue);
+    } else {
+      ret = m_database.execScalar(statement.c_str(), nullValue);
+    }
   } catch(CppSQLite3Exception e) {
     LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
   }
@@ -180,13 +353,17 @@ int SqliteStorage::executeStatementScalar(CppSQLite3Statement& statement, const
   return ret;
 }
 
-CppSQLite3Query SqliteStorage::executeQuery(const std::string& statement) const {
+SqliteStorage::Query SqliteStorage::executeQuery(const std::string& statement) const {
   try {
-    return m_database.execQuery(statement.c_str());
+    if(std::shared_ptr<ReadConnection> connection = getReadConnection()) {
+      CppSQLite3Query query = connection->database.execQuery(statement.c_str());
+      return Query(std::move(connection), query);
+    }
+    return Query(nullptr, m_database.execQuery(statement.c_str()));
   } catch(CppSQLite3Exception e) {
     LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
   }
-  return CppSQLite3Query();
+  return Query();
 }
 
 CppSQLite3Query SqliteStorage::executeQuery(CppSQLite3Statement& statement) const {
@@ -198,8 +375,40 @@ CppSQLite3Query SqliteStorage::executeQuery(CppSQLite3Statement& statement) cons
   return CppSQLite3Query();
 }
 
+SqliteStorage::CachedStatement::CachedStatement(std::shared_ptr<ReadConnection> connection,
+                                               std::unique_lock<std::recursive_mutex> lock,
+                                               CppSQLite3Statement* statement)
+    : m_connection(std::move(connection)), m_lock(std::move(lock)), m_statement(statement) {}
+
+SqliteStorage::CachedStatement::~CachedStatement() {
+  try {
+    m_statement->reset();
+  } catch(CppSQLite3Exception& e) {
+    LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
+  }
+}
+
+SqliteStorage::CachedStatement SqliteStorage::getCachedStatement(const std::string& statement) const {
+  // a read connection belongs to the calling thread, only the statements of the main connection are shared
+  std::shared_ptr<ReadConnection> connection = getReadConnection();
+  std::unique_lock<std::recursive_mutex> lock;
+  if(!connection) {
+    lock = std::unique_lock<std::recursive_mutex>(m_cachedStatementsMutex);
+  }
+
+  CppSQLite3DB& database = connection ? connection->database : m_database;
+  std::map<std::string, CppSQLite3Statement>& cachedStatements = connection ? connection->cachedStatements
+                                                                            : m_cachedStatements;
+
+  auto it = cachedStatements.find(statement);
+  if(it == cachedStatements.end()) {
+    it = cachedStatements.emplace(statement, database.compileStatement(statement.c_str())).first;
+  }
+  return CachedStatement(std::move(connection), std::move(lock), &it->second);
+}
+
 bool SqliteStorage::hasTable(const std::string& tableName) const {
-  CppSQLite3Query q = executeQuery("SELECT name FROM sqlite_master WHERE type='table' AND name='" + tableName + "';");
+  Query q = executeQuery("SELECT name FROM sqlite_master WHERE type='table' AND name='" + tableName + "';");
 
   if(!q.eof()) {
     return q.getStringField(0, "") == tableName;
@@ -210,7 +419,7 @@ bool SqliteStorage::hasTable(const std::string& tableName) const {
 
 std::string SqliteStorage::getMetaValue(const std::string& key) const {
   if(hasTable("meta")) {
-    CppSQLite3Query q = executeQuery("SELECT value FROM meta WHERE key = '" + key + "';");
+    Query q = executeQuery("SELECT value FROM meta WHERE key = '" + key + "';");
 
     if(!q.eof()) {
       return q.getStringField(0, "");
@@ -231,3 +440,58 @@ void SqliteStorage::insertOrUpdateMetaValue(const std::string& key, const std::s
   stmt.bind(3, value.c_str());
   executeStatement(stmt);
 }
+
+std::shared_ptr<SqliteStorage::ReadConnection> SqliteStorage::getReadConnection() const {
+  if(!m_readConnectionPoolEnabled) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_readConnectionPool->mutex);
+  if(!m_readConnectionPoolEnabled) {
+    return nullptr;
+  }
+
+  const std::thread::id threadId = std::this_thread::get_id();
+  std::shared_ptr<ReadConnection>& connection = m_readConnectionPool->connections[threadId];
+  if(!connection) {
+    try {
+      auto newConnection = std::make_shared<ReadConnection>();
+      // each connection is only ever used by the thread it was created for
+      newConnection->database.open(utility::encodeToUtf8(m_dbFilePath.wstr()).c_str(),
+                                   SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX);
+      newConnection->database.execDML("PRAGMA query_only=ON;");
+      connection = std::move(newConnection);
+    } catch(CppSQLite3Exception& e) {
+      LOG_ERROR(std::to_string(e.errorCode()) + ": " + e.errorMessage());
+      m_readConnectionPool->connections.erase(threadId);
+      return nullptr;
+    }
+
+    // the pool may outlive the storage, connections of exited threads would never be used again
+    std::weak_ptr<ReadConnectionPool> pool = m_readConnectionPool;
+    t_threadExitCallbacks.add(pool, [pool, threadId]() {
+      if(std::shared_ptr<ReadConnectionPool> lockedPool = pool.lock()) {
+        std::shared_ptr<ReadConnection> exitedConnection;
+        std::lock_guard<std::mutex> poolLock(lockedPool->mutex);
+        auto it = lockedPool->connections.find(threadId);
+        if(it != lockedPool->connections.end()) {
+          exitedConnection = std::move(it->second);
+          lockedPool->connections.erase(it);
+        }
+      }
+    });
+  }
+  return connection;
+}
+
+void SqliteStorage::clearReadConnections() {
+  std::map<std::thread::id, std::shared_ptr<ReadConnection>> connections;
+  {
+    std::lock_guard<std::mutex> lock(m_readConnectionPool->mutex);
+    connections.swap(m_readConnectionPool->connections);
+  }
+
+  // Connections that are not in use are closed here. A connection still used by a query or a cached
+  // statement of its thread is closed by that thread once it releases the last reference.
+  connections.clear();
+}
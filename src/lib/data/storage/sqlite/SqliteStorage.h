@@ -1,6 +1,12 @@
 #ifndef SQLITE_STORAGE_H
 #define SQLITE_STORAGE_H
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "CppSQLite3.h"
 #include "FilePath.h"
 #include "SqliteDatabaseIndex.h"
@@ -10,6 +16,12 @@ class TimeStamp;
 
 class SqliteStorage {
 public:
+  enum StorageProfileType {
+    STORAGE_PROFILE_DEFAULT = 0,    // rollback journal, full sync, foreign keys enforced
+    STORAGE_PROFILE_BULK_WAL,       // write-ahead log, no sync, big cache, foreign key checks deferred
+    STORAGE_PROFILE_BULK_UNSAFE     // like STORAGE_PROFILE_BULK_WAL but without any journal
+  };
+
   SqliteStorage(const FilePath& dbFilePath);
   virtual ~SqliteStorage();
 
@@ -24,6 +36,23 @@ public:
   void rollbackTransaction();
 
   void optimizeMemory() const;
+  void analyze() const;
+
+  // values that are no profile, e.g. from an edited settings file, map to STORAGE_PROFILE_DEFAULT
+  static StorageProfileType intToStorageProfileType(int value);
+
+  // Bulk profiles trade durability for insert speed and must only be used on databases that only this
+  // process writes and that can be thrown away when it crashes. Switching back to STORAGE_PROFILE_DEFAULT
+  // checkpoints the journal and verifies the foreign keys that were not enforced in the meantime.
+  void setProfile(StorageProfileType profile);
+  StorageProfileType getProfile() const;
+
+  // While the pool is enabled every thread runs its queries on an own read-only connection, so reads of
+  // different threads do not serialize on one connection. Statements that modify the database still run on
+  // the main connection, a modifying query sent through executeQuery() is rejected because of query_only.
+  // A connection is closed when its thread exits, or when the pool is disabled and no query uses it anymore.
+  void setReadConnectionPoolEnabled(bool enabled);
+  bool isReadConnectionPoolEnabled() const;
 
   FilePath getDbFilePath() const;
 
@@ -37,13 +66,61 @@ protected:
   void setupMetaTable();
   void clearMetaTable();
 
+  struct ReadConnection;
+
+  struct ReadConnectionLease {
+    std::shared_ptr<ReadConnection> connection;
+  };
+
+  // Keeps the read connection the query runs on open until the query is destroyed, so it must not be
+  // copied into a plain CppSQLite3Query.
+  class Query
+      : private ReadConnectionLease
+      , public CppSQLite3Query {
+  public:
+    Query() = default;
+    Query(std::shared_ptr<ReadConnection> connection, const CppSQLite3Query& query);
+  };
+
   bool executeStatement(const std::string& statement) const;
   bool executeStatement(CppSQLite3Statement& statement) const;
   int executeStatementScalar(const std::string& statement, const int nullValue) const;
   int executeStatementScalar(CppSQLite3Statement& statement, const int nullValue) const;
-  CppSQLite3Query executeQuery(const std::string& statement) const;
+  Query executeQuery(const std::string& statement) const;
   CppSQLite3Query executeQuery(CppSQLite3Statement& statement) const;
 
+  // Grants exclusive use of a cached statement and resets it for the next user when destroyed.
+  class CachedStatement {
+  public:
+    CachedStatement(const CachedStatement&) = delete;
+    CachedStatement& operator=(const CachedStatement&) = delete;
+    ~CachedStatement();
+
+    CppSQLite3Statement& operator*() const {
+      return *m_statement;
+    }
+
+    CppSQLite3Statement* operator->() const {
+      return m_statement;
+    }
+
+  private:
+    CachedStatement(std::shared_ptr<ReadConnection> connection,
+                    std::unique_lock<std::recursive_mutex> lock,
+                    CppSQLite3Statement* statement);
+
+    std::shared_ptr<ReadConnection> m_connection;
+    std::unique_lock<std::recursive_mutex> m_lock;
+    CppSQLite3Statement* m_statement;
+
+    friend SqliteStorage;
+  };
+
+  // Returns a statement that is compiled on first request and reused for every later request with the
+  // same SQL. Statements of the main connection are shared by all threads, so the returned lease keeps
+  // other threads from using the same statement until it is destroyed.
+  CachedStatement getCachedStatement(const std::string& statement) const;
+
   bool hasTable(const std::string& tableName) const;
 
   std::string getMetaValue(const std::string& key) const;
@@ -53,6 +130,12 @@ protected:
   FilePath m_dbFilePath;
 
 private:
+  struct ReadConnectionPool;
+
+  // returns nullptr if the read connection pool is disabled
+  std::shared_ptr<ReadConnection> getReadConnection() const;
+  void clearReadConnections();
+
   virtual size_t getStaticVersion() const = 0;
   virtual void clearTables() = 0;
   virtual void setupTables() = 0;
@@ -60,8 +143,17 @@ private:
 
   std::vector<std::pair<int, SqliteDatabaseIndex>> m_indices;
 
+  mutable std::recursive_mutex m_cachedStatementsMutex;
+  mutable std::map<std::string, CppSQLite3Statement> m_cachedStatements;
+
+  std::atomic<bool> m_readConnectionPoolEnabled = false;
+  // shared with the threads owning a connection, so they can drop it when they exit
+  std::shared_ptr<ReadConnectionPool> m_readConnectionPool;
+
   bool m_precompiledStatementsInitialized = false;
 
+  StorageProfileType m_profile = STORAGE_PROFILE_DEFAULT;
+
   friend SqliteStorageMigration;
 };
 
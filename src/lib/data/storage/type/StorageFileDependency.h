@@ -0,0 +1,15 @@
+#pragma once
+// internal
+#include "types.h"
+
+// a file referencing another file, e.g. by including it, stored with the edge type that caused it
+struct StorageFileDependency {
+  StorageFileDependency() = default;
+
+  StorageFileDependency(Id fileId_, Id referencingFileId_, int type_)
+      : fileId(fileId_), referencingFileId(referencingFileId_), type(type_) {}
+
+  Id fileId = 0;
+  Id referencingFileId = 0;
+  int type = 0;
+};
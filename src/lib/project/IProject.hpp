@@ -18,6 +18,9 @@ struct IProject {
 
   virtual void refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refreshMode, bool shallowIndexingRequested) = 0;
 
+  // re-indexes the files reported by the file watcher without asking, does nothing while the project is busy
+  virtual void refreshChangedFiles(std::shared_ptr<DialogView> dialogView) = 0;
+
   [[nodiscard]] virtual RefreshInfo getRefreshInfo(RefreshMode mode) const = 0;
 
   virtual void buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogView) = 0;
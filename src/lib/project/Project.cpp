@@ -1,5 +1,6 @@
 #include "Project.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "../../scheduling/TaskDecoratorRepeat.h"
@@ -12,8 +13,10 @@
 #include "../../scheduling/TaskSetValue.h"
 #include "CombinedIndexerCommandProvider.h"
 #include "DialogView.h"
+#include "FileInfo.h"
 #include "FilePath.h"
 #include "FileSystem.h"
+#include "FileWatcher.h"
 #include "IApplicationSettings.hpp"
 #include "PersistentStorage.h"
 #include "ProjectSettings.h"
@@ -88,6 +91,7 @@ bool Project::settingsEqualExceptNameAndLocation(const ProjectSettings& otherSet
 void Project::setStateOutdated() {
   if(ProjectStateType::LOADED == m_state) {
     m_state = ProjectStateType::OUTDATED;
+    stopFileWatcher();
   }
 }
 
@@ -97,6 +101,8 @@ void Project::load(const std::shared_ptr<DialogView>& dialogView) {
     return;
   }
 
+  stopFileWatcher();
+
   m_storageCache->clear();
   // TODO: check if this is really required.
   m_storageCache->setSubject(std::weak_ptr<StorageAccess>());
@@ -180,6 +186,11 @@ void Project::load(const std::shared_ptr<DialogView>& dialogView) {
   if(canLoad) {
     m_storage->setMode(SqliteIndexStorage::STORAGE_MODE_READ);
     m_storage->buildCaches();
+    if(IApplicationSettings::getInstanceRaw()->getInMemoryIndexEnabled()) {
+      m_storage->buildColumnarIndex();
+    }
+    // the loaded index is only read from now on, indexing writes to the temp db
+    m_storage->setReadConnectionPoolEnabled(true);
     m_storageCache->setSubject(m_storage);
 
     if(m_hasGUI) {
@@ -220,7 +231,9 @@ void Project::load(const std::shared_ptr<DialogView>& dialogView) {
     }
   }
 
-  if(m_state != ProjectStateType::LOADED && m_hasGUI) {
+  if(m_state == ProjectStateType::LOADED) {
+    startFileWatcher();
+  } else if(m_hasGUI) {
     MessageRefresh().dispatch();
   }
 }
@@ -356,6 +369,50 @@ void Project::refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refres
   }
 }
 
+void Project::refreshChangedFiles(std::shared_ptr<DialogView> dialogView) {
+  if(!m_fileWatcher || m_refreshStage != RefreshStageType::NONE || m_state != ProjectStateType::LOADED) {
+    // pending changes stay with the watcher until the project is up to date again
+    return;
+  }
+
+  const FileChanges changes = m_fileWatcher->consumeChanges();
+  if(!changes.overflowed && changes.filePaths.empty()) {
+    return;
+  }
+
+  m_refreshStage = RefreshStageType::REFRESHING;
+
+  for(const std::shared_ptr<SourceGroup>& sourceGroup : m_sourceGroups) {
+    if(sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED && !sourceGroup->prepareIndexing()) {
+      m_refreshStage = RefreshStageType::NONE;
+      return;
+    }
+  }
+
+  RefreshInfo info;
+  if(changes.overflowed) {
+    LOG_WARNING("File watcher missed changes, checking all files for updates");
+    updateWatchedSourceFilePaths();
+    info = getRefreshInfo(REFRESH_UPDATED_FILES);
+  } else {
+    if(std::any_of(changes.filePaths.begin(), changes.filePaths.end(), [this](const FilePath& filePath) {
+         return mayBeNewSourceFile(filePath);
+       })) {
+      updateWatchedSourceFilePaths();
+    }
+    info = RefreshInfoGenerator::getRefreshInfoForChangedFiles(changes.filePaths, m_watchedSourceFilePaths, m_storage);
+  }
+
+  if(info.filesToClear.empty() && info.nonIndexedFilesToClear.empty() && info.filesToIndex.empty()) {
+    // e.g. a file was saved without modifying it, no need to report anything
+    m_refreshStage = RefreshStageType::NONE;
+    return;
+  }
+
+  LOG_INFO("Re-indexing " + std::to_string(info.filesToIndex.size()) + " source files changed on disk");
+  buildIndex(info, dialogView);
+}
+
 RefreshInfo Project::getRefreshInfo(RefreshMode mode) const {
   switch(mode) {
   case REFRESH_NONE:
@@ -497,10 +554,12 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
     }
   }
 
+  std::shared_ptr<IndexingMetrics> indexingMetrics;
   if(!indexerCommandProvider->empty()) {
     const int adjustedIndexerThreadCount = std::min<int>(indexerThreadCount, static_cast<int>(indexerCommandProvider->size()));
 
     std::shared_ptr<StorageProvider> storageProvider = std::make_shared<StorageProvider>();
+    indexingMetrics = storageProvider->getIndexingMetrics();
     // add tasks for setting some variables on the blackboard that are used during indexing
     taskSequential->addTask(std::make_shared<TaskSetValue<bool>>("indexer_threads_started", false));
     taskSequential->addTask(std::make_shared<TaskSetValue<bool>>("indexer_threads_stopped", false));
@@ -584,7 +643,7 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
                                                                         getProjectSettingsFilePath().getParentDirectory()));
   }
 
-  taskSequential->addTask(std::make_shared<TaskFinishParsing>(tempStorage, dialogView));
+  taskSequential->addTask(std::make_shared<TaskFinishParsing>(tempStorage, dialogView, indexingMetrics));
 
   taskSequential->addTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
       std::make_shared<TaskGroupSequence>()->addChildTasks(
@@ -599,6 +658,11 @@ void Project::buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogVie
   taskSequential->addTask(std::make_shared<TaskLambda>([dialogView, this]() {
     m_refreshStage = RefreshStageType::NONE;
     MessageIndexingFinished().dispatch();
+
+    // files changed while indexing were not refreshed
+    if(m_fileWatcher && m_fileWatcher->hasChanges()) {
+      MessageRefresh().refreshChangedFiles().dispatch();
+    }
   }));
 
   taskSequential->addTask(std::make_shared<TaskGroupSelector>()->addChildTasks(
@@ -631,6 +695,7 @@ void Project::swapToTempStorage(std::shared_ptr<DialogView> dialogView) {
 
   if(!swapToTempStorageFile(indexDbFilePath, tempIndexDbFilePath, dialogView)) {
     m_state = ProjectStateType::NOT_LOADED;
+    stopFileWatcher();
     return;
   }
 
@@ -642,9 +707,15 @@ void Project::swapToTempStorage(std::shared_ptr<DialogView> dialogView) {
   // dialogView->showUnknownProgressDialog(L"Finish Indexing", L"Building caches");
   m_storage->buildCaches();
   // dialogView->hideUnknownProgressDialog();
+  if(IApplicationSettings::getInstanceRaw()->getInMemoryIndexEnabled()) {
+    m_storage->buildColumnarIndex();
+  }
+  m_storage->setReadConnectionPoolEnabled(true);
 
   m_storageCache->setSubject(m_storage);
   m_state = ProjectStateType::LOADED;
+
+  startFileWatcher();
 }
 
 bool Project::swapToTempStorageFile(const FilePath& indexDbFilePath,
@@ -687,3 +758,72 @@ bool Project::hasCxxSourceGroup() const {
 #endif    // BUILD_CXX_LANGUAGE_PACKAGE
   return false;
 }
+
+void Project::startFileWatcher() {
+  if(!IApplicationSettings::getInstanceRaw()->getWatchSourceFilesEnabled() || !FileWatcher::isSupported()) {
+    return;
+  }
+
+  for(const std::shared_ptr<SourceGroup>& sourceGroup : m_sourceGroups) {
+    if(sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED && !sourceGroup->allowsPartialClearing()) {
+      // every change would need a full re-index
+      LOG_INFO("Not watching source files, project contains source groups that cannot be partially cleared");
+      return;
+    }
+  }
+
+  if(!m_fileWatcher) {
+    m_fileWatcher = std::make_unique<FileWatcher>([]() { MessageRefresh().refreshChangedFiles().dispatch(); });
+    if(!m_fileWatcher->start()) {
+      m_fileWatcher.reset();
+      return;
+    }
+  }
+
+  updateWatchedSourceFilePaths();
+
+  // the directories of the source files and of the indexed files inside the project, e.g. included headers
+  std::set<FilePath> directoryPaths;
+  for(const FilePath& sourceFilePath : m_watchedSourceFilePaths) {
+    directoryPaths.insert(sourceFilePath.getParentDirectory());
+  }
+  {
+    const std::set<FilePath> storedFilePaths = utility::toSet(utility::convert<FileInfo, FilePath>(
+        m_storage->getFileInfoForAllFiles(), [](const FileInfo& info) { return info.path; }));
+    for(const std::shared_ptr<SourceGroup>& sourceGroup : m_sourceGroups) {
+      if(sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED) {
+        for(const FilePath& filePath : sourceGroup->filterToContainedFilePaths(storedFilePaths)) {
+          directoryPaths.insert(filePath.getParentDirectory());
+        }
+      }
+    }
+  }
+  m_fileWatcher->addDirectories(directoryPaths);
+
+  LOG_INFO("Watching " + std::to_string(m_fileWatcher->getWatchedDirectoryCount()) + " directories for changes");
+}
+
+void Project::stopFileWatcher() {
+  m_fileWatcher.reset();
+  m_watchedSourceFilePaths.clear();
+  m_watchedSourceExtensions.clear();
+}
+
+void Project::updateWatchedSourceFilePaths() {
+  m_watchedSourceFilePaths.clear();
+  for(const std::shared_ptr<SourceGroup>& sourceGroup : m_sourceGroups) {
+    if(sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED) {
+      utility::append(m_watchedSourceFilePaths, sourceGroup->getAllSourceFilePaths());
+    }
+  }
+
+  m_watchedSourceExtensions.clear();
+  for(const FilePath& sourceFilePath : m_watchedSourceFilePaths) {
+    m_watchedSourceExtensions.insert(utility::toLowerCase(sourceFilePath.extension()));
+  }
+}
+
+bool Project::mayBeNewSourceFile(const FilePath& filePath) const {
+  return m_watchedSourceFilePaths.find(filePath) == m_watchedSourceFilePaths.end() &&
+      m_watchedSourceExtensions.find(utility::toLowerCase(filePath.extension())) != m_watchedSourceExtensions.end();
+}
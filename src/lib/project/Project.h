@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -9,6 +10,7 @@
 
 class DialogView;
 class FilePath;
+class FileWatcher;
 class PersistentStorage;
 class ProjectSettings;
 class StorageCache;
@@ -57,6 +59,8 @@ public:
 
   void refresh(std::shared_ptr<DialogView> dialogView, RefreshMode refreshMode, bool shallowIndexingRequested) override;
 
+  void refreshChangedFiles(std::shared_ptr<DialogView> dialogView) override;
+
   [[nodiscard]] RefreshInfo getRefreshInfo(RefreshMode mode) const override;
 
   void buildIndex(RefreshInfo info, std::shared_ptr<DialogView> dialogView) override;
@@ -74,6 +78,12 @@ private:
 
   [[nodiscard]] bool hasCxxSourceGroup() const;
 
+  // watches the directories of the project files if enabled in the settings, called whenever the index is up to date
+  void startFileWatcher();
+  void stopFileWatcher();
+  void updateWatchedSourceFilePaths();
+  [[nodiscard]] bool mayBeNewSourceFile(const FilePath& filePath) const;
+
   std::shared_ptr<ProjectSettings> m_settings;
   StorageCache* m_storageCache;
 
@@ -86,6 +96,12 @@ private:
   std::string m_appUUID;
   bool m_hasGUI;
 
+  std::unique_ptr<FileWatcher> m_fileWatcher;
+  // source files of the enabled source groups when the watcher was started, scanning them again is only needed when a
+  // new file may be one of them
+  std::set<FilePath> m_watchedSourceFilePaths;
+  std::set<std::wstring> m_watchedSourceExtensions;
+
   friend ProjectBuilderIndex;
 #ifdef ST_TESTING
   FRIEND_TEST(ProjectFix, loadWhileIndexing);
@@ -9,6 +9,8 @@ struct RefreshInfo {
   std::set<FilePath> filesToIndex;
   std::set<FilePath> filesToClear;
   std::set<FilePath> nonIndexedFilesToClear;
+  // files that changed themselves, the others are cleared because they depend on one of them
+  size_t changedFileCount = 0;
 
   RefreshMode mode = REFRESH_NONE;
   bool shallow = false;
@@ -11,6 +11,8 @@
 
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
                                                                 std::shared_ptr<const PersistentStorage> storage) {
+  const ScopedFileStatusCache statusCache;
+
   // 1) Divide filepaths that are already known by the storage to "unchanged and indexed",
   // "unchanged and non-indexed" and "changed"
   std::set<FilePath> unchangedIndexedFilePaths;
@@ -34,7 +36,7 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(const std::vecto
 
     // checking source and header files
     for(const FileInfo& info : fileInfosFromStorage) {
-      if(alreadyKnownPaths.find(info.path) != alreadyKnownPaths.end() && info.path.exists()) {
+      if(alreadyKnownPaths.find(info.path) != alreadyKnownPaths.end() && FileSystem::exists(info.path)) {
         if(storage->getFilePathIndexed(info.path)) {
           if(didFileChange(info, storage)) {
             changedFilePaths.insert(info.path);
@@ -108,6 +110,7 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(const std::vecto
   RefreshInfo info;
   info.mode = REFRESH_UPDATED_FILES;
   info.filesToIndex = filesToIndex;
+  info.changedFileCount = changedFilePaths.size();
   for(const FilePath& fileToClear : filesToClear) {
     if(storage->getFilePathIndexed(fileToClear)) {
       info.filesToClear.insert(fileToClear);
@@ -121,6 +124,8 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForUpdatedFiles(const std::vecto
 
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForIncompleteFiles(const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
                                                                    std::shared_ptr<const PersistentStorage> storage) {
+  const ScopedFileStatusCache statusCache;
+
   RefreshInfo info = getRefreshInfoForUpdatedFiles(sourceGroups, storage);
   info.mode = REFRESH_UPDATED_AND_INCOMPLETE_FILES;
 
@@ -158,7 +163,56 @@ RefreshInfo RefreshInfoGenerator::getRefreshInfoForIncompleteFiles(const std::ve
   return info;
 }
 
+RefreshInfo RefreshInfoGenerator::getRefreshInfoForChangedFiles(const std::set<FilePath>& changedFilePaths,
+                                                                const std::set<FilePath>& sourceFilePaths,
+                                                                std::shared_ptr<const PersistentStorage> storage) {
+  const ScopedFileStatusCache statusCache;
+
+  // 1) Changed files known by the storage have been modified or removed, unknown source files have been added
+  std::set<FilePath> modifiedFilePaths;
+  for(const FileInfo& info : storage->getFileInfosForFilePaths(utility::toVector(changedFilePaths))) {
+    if(!FileSystem::exists(info.path) || didFileChange(info, storage)) {
+      modifiedFilePaths.insert(info.path);
+    }
+  }
+
+  std::set<FilePath> filesToIndex;
+  for(const FilePath& path : changedFilePaths) {
+    if(sourceFilePaths.find(path) != sourceFilePaths.end() && FileSystem::exists(path) &&
+       storage->getFileInfoForFilePath(path).path.empty()) {
+      filesToIndex.insert(path);
+    }
+  }
+
+  // 2) Clear the modified files and the files referencing them, e.g. the source files including a modified header.
+  // Unlike a full update the files only referenced by the cleared files stay, if they are not referenced anymore
+  // they are removed by the next full update.
+  std::set<FilePath> filesToClear = modifiedFilePaths;
+  utility::append(filesToClear, storage->getReferencing(modifiedFilePaths));
+
+  // 3) Index the cleared source files that still exist and store this information
+  RefreshInfo info;
+  info.mode = REFRESH_UPDATED_FILES;
+  info.changedFileCount = modifiedFilePaths.size();
+  for(const FilePath& fileToClear : filesToClear) {
+    if(sourceFilePaths.find(fileToClear) != sourceFilePaths.end() && FileSystem::exists(fileToClear)) {
+      filesToIndex.insert(fileToClear);
+    }
+
+    if(storage->getFilePathIndexed(fileToClear)) {
+      info.filesToClear.insert(fileToClear);
+    } else {
+      info.nonIndexedFilesToClear.insert(fileToClear);
+    }
+  }
+  info.filesToIndex = filesToIndex;
+
+  return info;
+}
+
 RefreshInfo RefreshInfoGenerator::getRefreshInfoForAllFiles(const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups) {
+  const ScopedFileStatusCache statusCache;
+
   RefreshInfo info;
   info.mode = REFRESH_ALL_FILES;
   info.filesToIndex = getAllSourceFilePaths(sourceGroups);
@@ -171,7 +225,7 @@ std::set<FilePath> RefreshInfoGenerator::getAllSourceFilePaths(const std::vector
   for(const auto& sourceGroup : sourceGroups) {
     if(sourceGroup->getStatus() == SOURCE_GROUP_STATUS_ENABLED) {
       for(const FilePath& sourceFilePath : sourceGroup->getAllSourceFilePaths()) {
-        if(sourceFilePath.exists()) {
+        if(FileSystem::exists(sourceFilePath)) {
           allSourceFilePaths.insert(sourceFilePath);
         }
       }
@@ -17,6 +17,12 @@ public:
   static RefreshInfo getRefreshInfoForIncompleteFiles(const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups,
                                                       std::shared_ptr<const PersistentStorage> storage);
 
+  // only looks at the given files and the files referencing them instead of scanning all files of the project, e.g. for
+  // the changes reported by a file watcher
+  static RefreshInfo getRefreshInfoForChangedFiles(const std::set<FilePath>& changedFilePaths,
+                                                   const std::set<FilePath>& sourceFilePaths,
+                                                   std::shared_ptr<const PersistentStorage> storage);
+
   static RefreshInfo getRefreshInfoForAllFiles(const std::vector<std::shared_ptr<SourceGroup>>& sourceGroups);
 
 private:
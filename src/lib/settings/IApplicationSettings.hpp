@@ -73,6 +73,10 @@ struct IApplicationSettings : Settings {
   [[nodiscard]] virtual GroupType getGraphGrouping() const noexcept = 0;
   virtual void setGraphGrouping(GroupType type) noexcept = 0;
 
+  // keep nodes, edges, occurrences and source locations of the loaded project in memory for browsing
+  [[nodiscard]] virtual bool getInMemoryIndexEnabled() const noexcept = 0;
+  virtual void setInMemoryIndexEnabled(bool enabled) noexcept = 0;
+
   // screen
   [[nodiscard]] virtual int getScreenAutoScaling() const noexcept = 0;
   virtual void setScreenAutoScaling(int autoScaling) noexcept = 0;
@@ -103,6 +107,14 @@ struct IApplicationSettings : Settings {
   [[nodiscard]] virtual bool getMultiProcessIndexingEnabled() const noexcept = 0;
   virtual void setMultiProcessIndexingEnabled(bool enabled) noexcept = 0;
 
+  // value of SqliteStorage::StorageProfileType applied to the temporary index database while indexing
+  [[nodiscard]] virtual int getIndexingStorageProfile() const noexcept = 0;
+  virtual void setIndexingStorageProfile(int profile) noexcept = 0;
+
+  // re-indexes the files changed on disk in the background while a project is open
+  [[nodiscard]] virtual bool getWatchSourceFilesEnabled() const noexcept = 0;
+  virtual void setWatchSourceFilesEnabled(bool enabled) noexcept = 0;
+
   [[nodiscard]] virtual std::vector<std::filesystem::path> getHeaderSearchPaths() const noexcept = 0;
   [[nodiscard]] virtual std::vector<std::filesystem::path> getHeaderSearchPathsExpanded() const noexcept = 0;
   virtual bool setHeaderSearchPaths(const std::vector<std::filesystem::path>& headerSearchPaths) noexcept = 0;
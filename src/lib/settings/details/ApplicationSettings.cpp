@@ -220,6 +220,14 @@ void ApplicationSettings::setGraphGrouping(GroupType type) noexcept {
   setValue<std::wstring>("application/graph_grouping", groupTypeToString(type));
 }
 
+bool ApplicationSettings::getInMemoryIndexEnabled() const noexcept {
+  return getValue<bool>("application/in_memory_index", false);
+}
+
+void ApplicationSettings::setInMemoryIndexEnabled(bool enabled) noexcept {
+  setValue<bool>("application/in_memory_index", enabled);
+}
+
 int ApplicationSettings::getScreenAutoScaling() const noexcept {
   return getValue<int>("screen/auto_scaling", 1);
 }
@@ -294,6 +302,22 @@ void ApplicationSettings::setMultiProcessIndexingEnabled(bool enabled) noexcept
   setValue<bool>("indexing/multi_process_indexing", enabled);
 }
 
+int ApplicationSettings::getIndexingStorageProfile() const noexcept {
+  return getValue<int>("indexing/storage_profile", 1 /*SqliteStorage::STORAGE_PROFILE_BULK_WAL*/);
+}
+
+void ApplicationSettings::setIndexingStorageProfile(int profile) noexcept {
+  setValue<int>("indexing/storage_profile", profile);
+}
+
+bool ApplicationSettings::getWatchSourceFilesEnabled() const noexcept {
+  return getValue<bool>("indexing/watch_source_files", false);
+}
+
+void ApplicationSettings::setWatchSourceFilesEnabled(bool enabled) noexcept {
+  setValue<bool>("indexing/watch_source_files", enabled);
+}
+
 std::vector<fs::path> ApplicationSettings::getHeaderSearchPaths() const noexcept {
   return getPathValuesStl("indexing/cxx/header_search_paths/header_search_path");
 }
@@ -69,6 +69,9 @@ public:
   GroupType getGraphGrouping() const noexcept override;
   void setGraphGrouping(GroupType type) noexcept override;
 
+  bool getInMemoryIndexEnabled() const noexcept override;
+  void setInMemoryIndexEnabled(bool enabled) noexcept override;
+
   // screen
   int getScreenAutoScaling() const noexcept override;
   void setScreenAutoScaling(int autoScaling) noexcept override;
@@ -99,6 +102,12 @@ public:
   bool getMultiProcessIndexingEnabled() const noexcept override;
   void setMultiProcessIndexingEnabled(bool enabled) noexcept override;
 
+  int getIndexingStorageProfile() const noexcept override;
+  void setIndexingStorageProfile(int profile) noexcept override;
+
+  bool getWatchSourceFilesEnabled() const noexcept override;
+  void setWatchSourceFilesEnabled(bool enabled) noexcept override;
+
   std::vector<std::filesystem::path> getHeaderSearchPaths() const noexcept override;
   std::vector<std::filesystem::path> getHeaderSearchPathsExpanded() const noexcept override;
   bool setHeaderSearchPaths(const std::vector<std::filesystem::path>& headerSearchPaths) noexcept override;
@@ -0,0 +1,109 @@
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "CodeController.h"
+#include "Component.h"
+#include "MockedMessageQueue.hpp"
+#include "mocks/MockedApplicationSetting.hpp"
+#include "mocks/MockedCodeView.hpp"
+#include "mocks/MockedStorageAccess.hpp"
+#include "mocks/MockedViewLayout.hpp"
+#include "SourceLocationCollection.h"
+#include "SourceLocationFile.h"
+#include "TextAccess.h"
+#include "type/activation/MessageActivateTokens.h"
+#include "type/code/MessageActivateLocalSymbols.h"
+#include "type/code/MessageLoadCodeSnippets.h"
+
+using namespace testing;
+
+namespace {
+constexpr Id TokenId = 1;
+constexpr Id LocalSymbolId = 2;
+// more snippets than fit on the first page
+constexpr size_t SnippetCount = 30;
+constexpr size_t LinesPerSnippet = 10;
+
+template <typename MessageType>
+void send(CodeController* controller, MessageType& message) {
+  static_cast<MessageListener<MessageType>*>(controller)->handleMessageBase(&message);
+}
+}    // namespace
+
+struct CodeControllerFix : Test {
+  void SetUp() override {
+    IMessageQueue::setInstance(mMessageQueue);
+
+    mAppSettings = std::make_shared<NiceMock<MockedApplicationSettings>>();
+    ON_CALL(*mAppSettings, getCodeSnippetExpandRange).WillByDefault(Return(1));
+    IApplicationSettings::setInstance(mAppSettings);
+
+    mView = std::make_shared<MockedCodeView>(&mViewLayout);
+    ON_CALL(*mView, isInListMode).WillByDefault(Return(true));
+    ON_CALL(*mView, showSnippets).WillByDefault([this](const auto&, const CodeView::CodeParams& params, const auto&) {
+      mLocalReferenceCount = params.localReferenceCount;
+    });
+
+    std::string text;
+    for(size_t line = 1; line <= SnippetCount * LinesPerSnippet; line++) {
+      text += "line " + std::to_string(line) + "\n";
+    }
+
+    // one token and one local symbol location far enough apart to get a snippet each
+    auto collection = std::make_shared<SourceLocationCollection>();
+    for(size_t i = 0; i < SnippetCount; i++) {
+      const size_t line = i * LinesPerSnippet + 5;
+      collection->addSourceLocation(LOCATION_TOKEN, 2 * i + 1, {TokenId}, mFilePath, line, 1, line, 4);
+      collection->addSourceLocation(LOCATION_LOCAL_SYMBOL, 2 * i + 2, {LocalSymbolId}, mFilePath, line, 6, line, 8);
+    }
+
+    ON_CALL(mStorageAccess, getActiveTokenIdsForId(TokenId, _)).WillByDefault(Return(std::vector<Id>{TokenId}));
+    ON_CALL(mStorageAccess, getSourceLocationsForTokenIds).WillByDefault(Return(collection));
+    ON_CALL(mStorageAccess, getFileContent).WillByDefault(Return(TextAccess::createFromString(text, mFilePath)));
+    ON_CALL(mStorageAccess, getSourceLocationsOfTypeInFile).WillByDefault([this](const FilePath&, LocationType) {
+      return std::make_shared<SourceLocationFile>(mFilePath, L"cpp", false, true, true);
+    });
+
+    mComponent = std::make_shared<Component>(mView, std::make_shared<CodeController>(&mStorageAccess));
+    mController = mComponent->getController<CodeController>();
+    ASSERT_NE(nullptr, mController);
+  }
+
+  void TearDown() override {
+    mComponent.reset();
+    IApplicationSettings::setInstance(nullptr);
+    IMessageQueue::setInstance(nullptr);
+  }
+
+  const FilePath mFilePath{L"/src/main.cpp"};
+  std::shared_ptr<NiceMock<MockedMessageQueue>> mMessageQueue = std::make_shared<NiceMock<MockedMessageQueue>>();
+  std::shared_ptr<NiceMock<MockedApplicationSettings>> mAppSettings;
+  NiceMock<MockedViewLayout> mViewLayout;
+  NiceMock<MockedStorageAccess> mStorageAccess;
+  std::shared_ptr<MockedCodeView> mView;
+  std::shared_ptr<Component> mComponent;
+  CodeController* mController = nullptr;
+  size_t mLocalReferenceCount = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CodeControllerFix, loadedSnippetsAddTheirLocalReferences) {
+  MessageActivateLocalSymbols activateLocalSymbols({LocalSymbolId});
+
+  MessageActivateTokens activateTokens(&activateLocalSymbols);
+  activateTokens.tokenIds = {TokenId};
+  send(mController, activateTokens);
+
+  send(mController, activateLocalSymbols);
+  const size_t firstPageReferenceCount = mLocalReferenceCount;
+  ASSERT_GT(firstPageReferenceCount, 0U);
+  ASSERT_LT(firstPageReferenceCount, SnippetCount);
+
+  MessageLoadCodeSnippets loadSnippets(mFilePath);
+  send(mController, loadSnippets);
+
+  EXPECT_GT(mLocalReferenceCount, firstPageReferenceCount);
+}
@@ -0,0 +1,115 @@
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "ColumnarIndexStorage.h"
+
+using namespace ::testing;
+
+namespace {
+ColumnarIndexStorage createStorage() {
+  ColumnarIndexStorage storage;
+  storage.addNode(1, 2, "a");
+  storage.addNode(2, 4, "b");
+  storage.addNode(3, 4, "c");
+  storage.addEdge(StorageEdge(5, 1, 1, 2));
+  storage.addEdge(StorageEdge(4, 1, 1, 3));
+  storage.addEdge(StorageEdge(6, 8, 3, 2));
+  storage.addOccurrence(StorageOccurrence(2, 10));
+  storage.addOccurrence(StorageOccurrence(1, 11));
+  storage.addOccurrence(StorageOccurrence(2, 11));
+  storage.addSourceLocation(StorageSourceLocation(10, 7, 1, 2, 3, 4, 1));
+  storage.addSourceLocation(StorageSourceLocation(11, 7, 5, 6, 7, 8, 2));
+  storage.finishSetup();
+  return storage;
+}
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, nodesAreFoundById) {
+  const ColumnarIndexStorage storage = createStorage();
+
+  EXPECT_EQ(3, storage.getNodeCount());
+
+  const StorageNode node = storage.getNodeById(2);
+  EXPECT_EQ(2, node.id);
+  EXPECT_EQ(4, node.type);
+  EXPECT_EQ(L"b", node.serializedName);
+
+  const std::vector<StorageNode> nodes = storage.getNodesByIds({3, 1, 3, 5});
+  ASSERT_EQ(2, nodes.size());
+  EXPECT_EQ(1, nodes[0].id);
+  EXPECT_EQ(L"a", nodes[0].serializedName);
+  EXPECT_EQ(3, nodes[1].id);
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, unknownIdsReturnDefaultElements) {
+  const ColumnarIndexStorage storage = createStorage();
+
+  EXPECT_EQ(0, storage.getNodeById(5).id);
+  EXPECT_EQ(0, storage.getNodeById(100).id);
+  EXPECT_EQ(0, storage.getEdgeById(1).id);
+  EXPECT_EQ(0, storage.getSourceLocationById(12).id);
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, edgesAreFoundBySourceAndTarget) {
+  const ColumnarIndexStorage storage = createStorage();
+
+  EXPECT_EQ(3, storage.getEdgeCount());
+
+  const std::vector<StorageEdge> outgoing = storage.getEdgesBySourceIds({1});
+  ASSERT_EQ(2, outgoing.size());
+  EXPECT_EQ(4, outgoing[0].id);
+  EXPECT_EQ(5, outgoing[1].id);
+
+  const std::vector<StorageEdge> incoming = storage.getEdgesByTargetIds({2, 3});
+  ASSERT_EQ(3, incoming.size());
+  EXPECT_EQ(5, incoming[0].id);
+  EXPECT_EQ(6, incoming[1].id);
+  EXPECT_EQ(4, incoming[2].id);
+
+  EXPECT_TRUE(storage.getEdgesBySourceIds({2}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, occurrencesAreFoundByElementAndLocation) {
+  const ColumnarIndexStorage storage = createStorage();
+
+  const std::vector<StorageOccurrence> byElement = storage.getOccurrencesForElementIds({2});
+  ASSERT_EQ(2, byElement.size());
+  EXPECT_EQ(10, byElement[0].sourceLocationId);
+  EXPECT_EQ(11, byElement[1].sourceLocationId);
+
+  const std::vector<StorageOccurrence> byLocation = storage.getOccurrencesForLocationIds({11});
+  ASSERT_EQ(2, byLocation.size());
+  EXPECT_EQ(1, byLocation[0].elementId);
+  EXPECT_EQ(2, byLocation[1].elementId);
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, sourceLocationsAreFoundById) {
+  const ColumnarIndexStorage storage = createStorage();
+
+  const std::vector<StorageSourceLocation> locations = storage.getSourceLocationsByIds({11, 10});
+  ASSERT_EQ(2, locations.size());
+  EXPECT_EQ(10, locations[0].id);
+  EXPECT_EQ(11, locations[1].id);
+  EXPECT_EQ(7, locations[1].fileNodeId);
+  EXPECT_EQ(5, locations[1].startLine);
+  EXPECT_EQ(6, locations[1].startCol);
+  EXPECT_EQ(7, locations[1].endLine);
+  EXPECT_EQ(8, locations[1].endCol);
+  EXPECT_EQ(2, locations[1].type);
+}
+
+// NOLINTNEXTLINE
+TEST(ColumnarIndexStorage, clearRemovesAllElements) {
+  ColumnarIndexStorage storage = createStorage();
+  storage.clear();
+
+  EXPECT_EQ(0, storage.getNodeCount());
+  EXPECT_EQ(0, storage.getEdgeCount());
+  EXPECT_TRUE(storage.getOccurrencesForElementIds({1, 2}).empty());
+  EXPECT_TRUE(storage.getSourceLocationsByIds({10, 11}).empty());
+}
@@ -66,7 +66,8 @@ TEST(CommandLineParserConfig, helpOption) {
   {
     constexpr std::string_view HelpString =
         "Usage:\n  Sourcetrail [command] [option...] [positional arguments]\n\nCommands:\n  config                 Change "
-        "preferences relevant to project indexing.*\n  index                  Index a certain project.*\n\n  * has its own "
+        "preferences relevant to project indexing.*\n  index                  Index a certain project.*\n"
+        "  serve                  Keep a project indexed and serve requests.*\n\n  * has its own "
         "--help\n\nOptions:\n  -h [ --help ]          Print this help message\n  -v [ --version ]       Version of Sourcetrail\n "
         " --project-file arg     Open Sourcetrail with this project (.srctrlprj)\n\nPositional Arguments: \n  1: project-file\n";
     CollectOutStream collectCout(std::cout);
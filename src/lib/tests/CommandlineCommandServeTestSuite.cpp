@@ -0,0 +1,58 @@
+#include <iostream>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "CommandlineCommandServe.h"
+#include "CommandLineParser.h"
+#include "utilities/CollectOutStream.hpp"
+#include "utilities/FileHandler.hpp"
+
+using namespace testing;
+using namespace commandline;
+
+struct CommandlineCommandServeFix : public Test {
+  void SetUp() override {
+    mParser = std::make_unique<CommandLineParser>("2023.6.8");
+
+    mServe = std::make_unique<CommandlineCommandServe>(mParser.get());
+    mServe->setup();
+  }
+
+  std::unique_ptr<CommandLineParser> mParser;
+  std::unique_ptr<CommandlineCommandServe> mServe;
+};
+
+TEST_F(CommandlineCommandServeFix, helpArgs) {
+  std::vector<std::string> args = {"--help"};
+
+  CollectOutStream oStream(std::cout);
+  auto ret = mServe->parse(args);
+  oStream.close();
+  ASSERT_EQ(CommandlineCommand::ReturnStatus::CMD_QUIT, ret);
+  EXPECT_THAT(oStream.str(), HasSubstr("Sourcetrail serve [option...]"));
+  EXPECT_THAT(oStream.str(), HasSubstr("[ --socket ] arg"));
+  EXPECT_FALSE(mParser->runAsDaemon());
+}
+
+TEST_F(CommandlineCommandServeFix, socketArgs) {
+  std::vector<std::string> args = {"--socket", "/tmp/sourcetrail.sock", "-f"};
+
+  auto ret = mServe->parse(args);
+
+  ASSERT_EQ(CommandlineCommand::ReturnStatus::CMD_OK, ret);
+  EXPECT_TRUE(mParser->runAsDaemon());
+  EXPECT_EQ(FilePath("/tmp/sourcetrail.sock"), mParser->getDaemonSocketPath());
+  EXPECT_EQ(RefreshMode::REFRESH_ALL_FILES, mParser->getRefreshMode());
+}
+
+TEST_F(CommandlineCommandServeFix, noSocketForInvalidProject) {
+  auto handler = FileHandler::createEmptyFile("/tmp/invalid.srctrlprj");
+  std::vector<std::string> args = {"/tmp/invalid.srctrlprj"};
+
+  auto ret = mServe->parse(args);
+
+  ASSERT_EQ(CommandlineCommand::ReturnStatus::CMD_OK, ret);
+  EXPECT_TRUE(mParser->hasError());
+  EXPECT_TRUE(mParser->getDaemonSocketPath().empty());
+}
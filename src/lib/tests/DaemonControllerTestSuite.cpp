@@ -0,0 +1,116 @@
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "DaemonController.h"
+#include "MessageQueue.h"
+#include "type/indexing/MessageIndexingFinished.h"
+#include "type/indexing/MessageIndexingStatus.h"
+
+using namespace testing;
+
+namespace {
+// collects what would be sent to the clients
+class TestDaemonController final : public DaemonController {
+public:
+  TestDaemonController() : DaemonController(nullptr) {}
+
+  bool startListening(const FilePath& /*socketPath*/) override {
+    return true;
+  }
+
+  void stopListening() override {}
+
+  [[nodiscard]] bool isListening() const override {
+    return true;
+  }
+
+  std::map<ClientId, std::vector<std::string>> responses;
+  std::vector<std::string> events;
+
+private:
+  void sendResponse(ClientId clientId, const std::string& response) override {
+    responses[clientId].push_back(response);
+  }
+
+  void sendEvent(const std::string& event) override {
+    events.push_back(event);
+  }
+};
+}    // namespace
+
+struct DaemonControllerFix : Test {
+  void SetUp() override {
+    mQueue = std::make_shared<details::MessageQueue>();
+    IMessageQueue::setInstance(mQueue);
+    mController = std::make_unique<TestDaemonController>();
+  }
+
+  void TearDown() override {
+    mController.reset();
+    IMessageQueue::setInstance(nullptr);
+    mQueue.reset();
+  }
+
+  std::shared_ptr<details::MessageQueue> mQueue;
+  std::unique_ptr<TestDaemonController> mController;
+};
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, invalidRequestIsAnswered) {
+  mController->handleRequest(1, "{\"id\": 1, \"method\": ");
+
+  ASSERT_EQ(1, mController->responses[1].size());
+  EXPECT_THAT(mController->responses[1][0], StartsWith("{\"error\":\"Invalid request: "));
+  EXPECT_THAT(mController->responses[1][0], EndsWith("}\n"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, unknownMethodIsAnsweredWithId) {
+  mController->handleRequest(1, R"({"id": 7, "method": "compile"})");
+
+  ASSERT_EQ(1, mController->responses[1].size());
+  EXPECT_EQ("{\"error\":\"Unknown method: \\\"compile\\\"\",\"id\":7}\n", mController->responses[1][0]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, responsesGoToRequestingClient) {
+  mController->handleRequest(1, R"({"id": 1, "method": "status"})");
+  mController->handleRequest(2, R"({"id": 2, "method": "status"})");
+
+  ASSERT_EQ(1, mController->responses[1].size());
+  ASSERT_EQ(1, mController->responses[2].size());
+  EXPECT_THAT(mController->responses[2][0], HasSubstr("\"id\":2"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, statusWithoutProject) {
+  mController->handleRequest(1, R"({"id": 1, "method": "status"})");
+
+  ASSERT_EQ(1, mController->responses[1].size());
+  EXPECT_EQ("{\"id\":1,\"result\":{\"indexing\":false,\"loaded\":false,\"project\":\"\"}}\n", mController->responses[1][0]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, indexAndSearchNeedProject) {
+  mController->handleRequest(1, R"({"id": 1, "method": "index", "params": {"mode": "all"}})");
+  mController->handleRequest(1, R"({"id": 2, "method": "search", "params": {"query": "main"}})");
+
+  ASSERT_EQ(2, mController->responses[1].size());
+  EXPECT_EQ("{\"error\":\"No project loaded\",\"id\":1}\n", mController->responses[1][0]);
+  EXPECT_EQ("{\"error\":\"No project loaded\",\"id\":2}\n", mController->responses[1][1]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DaemonControllerFix, indexingProgressIsSentAsEvents) {
+  mQueue->processMessage(std::make_shared<MessageIndexingStatus>(true, 42), false);
+  mQueue->processMessage(std::make_shared<MessageIndexingStatus>(false), false);
+  mQueue->processMessage(std::make_shared<MessageIndexingFinished>(), false);
+
+  EXPECT_THAT(mController->events,
+              ElementsAre("{\"event\":\"progress\",\"percent\":42}\n", "{\"event\":\"finished\"}\n"));
+}
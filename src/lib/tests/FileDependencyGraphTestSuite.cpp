@@ -0,0 +1,82 @@
+// STL
+#include <algorithm>
+#include <vector>
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "FileDependencyGraph.h"
+
+using namespace ::testing;
+
+namespace {
+std::vector<Id> sorted(std::vector<Id> ids) {
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+// 1.cpp includes 10.h and 11.h, 2.cpp includes 11.h, 10.h and 11.h include 20.h
+FileDependencyGraph createIncludeGraph() {
+  return FileDependencyGraph({{10, 1}, {11, 1}, {11, 2}, {20, 10}, {20, 11}});
+}
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, referencingFilesAreTransitive) {
+  const FileDependencyGraph graph = createIncludeGraph();
+
+  EXPECT_EQ(std::vector<Id>({1, 2, 10, 11}), sorted(graph.getReferencing({20})));
+  EXPECT_EQ(std::vector<Id>({1, 2}), sorted(graph.getReferencing({11})));
+  EXPECT_TRUE(graph.getReferencing({1}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, referencedFilesAreTransitive) {
+  const FileDependencyGraph graph = createIncludeGraph();
+
+  EXPECT_EQ(std::vector<Id>({10, 11, 20}), sorted(graph.getReferenced({1})));
+  EXPECT_EQ(std::vector<Id>({11, 20}), sorted(graph.getReferenced({2})));
+  EXPECT_TRUE(graph.getReferenced({20}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, closuresOfSeveralFilesAreMerged) {
+  const FileDependencyGraph graph = createIncludeGraph();
+
+  EXPECT_EQ(std::vector<Id>({1, 2}), sorted(graph.getReferencing({10, 11})));
+  EXPECT_EQ(std::vector<Id>({1, 2, 10, 11}), sorted(graph.getReferencing({11, 20})));
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, closuresAreCachedPerFile) {
+  const FileDependencyGraph graph = createIncludeGraph();
+
+  // the closure of 11.h is reused for the closure of 20.h
+  EXPECT_EQ(std::vector<Id>({1, 2}), sorted(graph.getReferencing({11})));
+  EXPECT_EQ(std::vector<Id>({1, 2, 10, 11}), sorted(graph.getReferencing({20})));
+  EXPECT_EQ(std::vector<Id>({1, 2, 10, 11}), sorted(graph.getReferencing({20})));
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, cyclesAreFollowedOnce) {
+  const FileDependencyGraph graph({{1, 2}, {2, 3}, {3, 1}, {4, 3}});
+
+  EXPECT_EQ(std::vector<Id>({1, 2, 3}), sorted(graph.getReferencing({1})));
+  EXPECT_EQ(std::vector<Id>({1, 2, 3}), sorted(graph.getReferencing({4})));
+  EXPECT_EQ(std::vector<Id>({1, 2, 3, 4}), sorted(graph.getReferenced({2})));
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, unknownFilesHaveNoDependencies) {
+  const FileDependencyGraph graph = createIncludeGraph();
+
+  EXPECT_TRUE(graph.getReferencing({0, 99}).empty());
+  EXPECT_TRUE(graph.getReferenced({99}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST(FileDependencyGraph, duplicateDependenciesAreStoredOnce) {
+  const FileDependencyGraph graph({{10, 1}, {10, 1}, {11, 1}});
+
+  EXPECT_EQ(3, graph.getFileCount());
+  EXPECT_EQ(2, graph.getDependencyCount());
+}
@@ -0,0 +1,100 @@
+// STL
+#include <filesystem>
+#include <thread>
+#include <vector>
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "FilePathPool.h"
+
+using namespace ::testing;
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, samePathGetsSameId) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  const PathId id = pool->getId(FilePath(L"/pool/same/file.cpp"));
+
+  EXPECT_NE(FilePathPool::EmptyPathId, id);
+  EXPECT_EQ(id, pool->getId(L"/pool/same/file.cpp"));
+  EXPECT_NE(id, pool->getId(L"/pool/same/other.cpp"));
+  EXPECT_EQ(L"/pool/same/file.cpp", pool->getString(id));
+  EXPECT_EQ(FilePath(L"/pool/same/file.cpp"), pool->getFilePath(id));
+}
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, emptyPathHasEmptyId) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  EXPECT_EQ(FilePathPool::EmptyPathId, pool->getId(FilePath()));
+  EXPECT_TRUE(pool->getFilePath(FilePathPool::EmptyPathId).empty());
+}
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, lowerCaseIdIsIdOfLowerCasePath) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  const PathId id = pool->getId(L"/Pool/Lower/File.CPP");
+  const PathId lowerCaseId = pool->getLowerCaseId(id);
+
+  EXPECT_NE(id, lowerCaseId);
+  EXPECT_EQ(pool->getId(L"/pool/lower/file.cpp"), lowerCaseId);
+  EXPECT_EQ(lowerCaseId, pool->getLowerCaseId(lowerCaseId));
+}
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, statusOfMissingPath) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  const PathId id = pool->getId(L"/pool/missing/file.cpp");
+
+  EXPECT_FALSE(pool->exists(id));
+  EXPECT_FALSE(pool->isDirectory(id));
+  EXPECT_EQ(id, pool->getCanonicalId(id));
+}
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, statusIsCachedUntilInvalidated) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sourcetrail_file_path_pool";
+  std::filesystem::remove_all(directory);
+
+  const PathId id = pool->getId(FilePath(directory.wstring()));
+  EXPECT_FALSE(pool->exists(id));
+
+  std::filesystem::create_directories(directory);
+  EXPECT_FALSE(pool->exists(id));
+
+  pool->invalidateStatus(id);
+  EXPECT_TRUE(pool->exists(id));
+  EXPECT_TRUE(pool->isDirectory(id));
+
+  std::filesystem::remove_all(directory);
+}
+
+// NOLINTNEXTLINE
+TEST(FilePathPool, concurrentInterningGivesOneIdPerPath) {
+  FilePathPool* pool = FilePathPool::getInstance();
+
+  constexpr size_t ThreadCount = 4;
+  constexpr size_t PathCount = 500;
+
+  std::vector<std::vector<PathId>> ids(ThreadCount);
+  std::vector<std::thread> threads;
+  for(size_t thread = 0; thread < ThreadCount; thread++) {
+    threads.emplace_back([&ids, pool, thread]() {
+      for(size_t i = 0; i < PathCount; i++) {
+        ids[thread].push_back(pool->getId(L"/pool/concurrent/file" + std::to_wstring(i) + L".cpp"));
+      }
+    });
+  }
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for(size_t thread = 1; thread < ThreadCount; thread++) {
+    EXPECT_EQ(ids[0], ids[thread]);
+  }
+  EXPECT_EQ(L"/pool/concurrent/file42.cpp", pool->getString(ids[0][42]));
+}
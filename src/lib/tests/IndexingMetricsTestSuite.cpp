@@ -0,0 +1,115 @@
+// STL
+#include <sstream>
+#include <string>
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "IndexingMetrics.h"
+
+using namespace ::testing;
+
+namespace {
+TranslationUnitMetrics createMetrics(const std::wstring& filePath, double indexTime, size_t sourceLocationCount) {
+  TranslationUnitMetrics metrics;
+  metrics.sourceFilePath = FilePath(filePath);
+  metrics.processId = 1;
+  metrics.indexTime = indexTime;
+  metrics.transferTime = 0.5;
+  metrics.transferByteSize = 2048;
+  metrics.nodeCount = 3;
+  metrics.edgeCount = 4;
+  metrics.sourceLocationCount = sourceLocationCount;
+  metrics.occurrenceCount = 6;
+  metrics.errorCount = 1;
+  metrics.peakMemoryByteSize = 1024 * 1024;
+  return metrics;
+}
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST(IndexingMetrics, phaseTimesAreAccumulated) {
+  IndexingMetrics metrics;
+  metrics.addPhaseTime(IndexingMetrics::Phase::Inject, 1.0, 10);
+  metrics.addPhaseTime(IndexingMetrics::Phase::Inject, 3.0, 20);
+  metrics.addPhaseTime(IndexingMetrics::Phase::Queue, 0.5, 10);
+
+  const IndexingMetrics::PhaseMetrics inject = metrics.getPhase(IndexingMetrics::Phase::Inject);
+  EXPECT_EQ(2, inject.count);
+  EXPECT_DOUBLE_EQ(4.0, inject.time);
+  EXPECT_DOUBLE_EQ(3.0, inject.maxTime);
+  EXPECT_EQ(30, inject.sourceLocationCount);
+
+  EXPECT_EQ(1, metrics.getPhase(IndexingMetrics::Phase::Queue).count);
+  EXPECT_EQ(0, metrics.getPhase(IndexingMetrics::Phase::Merge).count);
+
+  metrics.clear();
+  EXPECT_EQ(0, metrics.getPhase(IndexingMetrics::Phase::Inject).count);
+}
+
+// NOLINTNEXTLINE
+TEST(IndexingMetrics, csvContainsOneQuotedRowPerTranslationUnit) {
+  IndexingMetrics metrics;
+  metrics.addTranslationUnit(createMetrics(L"/src/a.cpp", 1.0, 5));
+  metrics.addTranslationUnit(createMetrics(L"/src/b \"c\".cpp", 2.0, 7));
+
+  std::stringstream stream;
+  metrics.writeCsv(stream);
+
+  std::string line;
+  std::getline(stream, line);
+  EXPECT_EQ(0, line.find("source_file_path,process_id,index_time,"));
+
+  std::getline(stream, line);
+  EXPECT_EQ("\"/src/a.cpp\",1,1.000000,0.500000,2048,3,4,5,6,1,1048576", line);
+
+  std::getline(stream, line);
+  EXPECT_EQ(0, line.find("\"/src/b \"\"c\"\".cpp\",1,2.000000,"));
+
+  EXPECT_FALSE(std::getline(stream, line));
+}
+
+// NOLINTNEXTLINE
+TEST(IndexingMetrics, jsonContainsPhasesAndTranslationUnits) {
+  IndexingMetrics metrics;
+  metrics.addTranslationUnit(createMetrics(L"/src/a.cpp", 1.0, 5));
+  metrics.addTranslationUnit(createMetrics(L"/src/b.cpp", 3.0, 7));
+  metrics.addPhaseTime(IndexingMetrics::Phase::Merge, 0.25, 7);
+  metrics.setPeakMemoryByteSize(4096);
+
+  std::stringstream stream;
+  metrics.writeJson(stream, 10.0);
+  const std::string json = stream.str();
+
+  EXPECT_NE(std::string::npos, json.find("\"totalTime\":10.000000"));
+  EXPECT_NE(std::string::npos, json.find("\"peakProcessMemoryByteSize\":4096"));
+  EXPECT_NE(std::string::npos,
+            json.find("\"index\":{\"count\":2,\"time\":4.000000,\"maxTime\":3.000000,\"sourceLocationCount\":12}"));
+  EXPECT_NE(std::string::npos, json.find("\"merge\":{\"count\":1,\"time\":0.250000"));
+  EXPECT_NE(std::string::npos, json.find("{\"sourceFilePath\":\"/src/b.cpp\",\"processId\":1,\"indexTime\":3.000000"));
+}
+
+// NOLINTNEXTLINE
+TEST(IndexingMetrics, summaryListsAllPhases) {
+  IndexingMetrics metrics;
+  metrics.addTranslationUnit(createMetrics(L"/src/a.cpp", 1.0, 5));
+
+  const std::string summary = metrics.getSummary(2.0);
+  for(const char* phase : {"index", "transfer", "queue", "merge", "inject"}) {
+    EXPECT_NE(std::string::npos, summary.find(phase));
+  }
+  EXPECT_NE(std::string::npos, summary.find("translation units: 1 in 2.000 s (0.50/s), transferred 2 KB"));
+  EXPECT_NE(std::string::npos, summary.find("peak process memory: indexer 1 MB, application 0 MB"));
+}
+
+// NOLINTNEXTLINE
+TEST(IndexingMetrics, summaryOmitsIndexerMemoryForInProcessIndexing) {
+  IndexingMetrics metrics;
+  TranslationUnitMetrics unit = createMetrics(L"/src/a.cpp", 1.0, 5);
+  unit.peakMemoryByteSize = 0;
+  metrics.addTranslationUnit(unit);
+  metrics.setPeakMemoryByteSize(3 * 1024 * 1024);
+
+  const std::string summary = metrics.getSummary(2.0);
+  EXPECT_NE(std::string::npos, summary.find("peak process memory: application 3 MB"));
+  EXPECT_EQ(std::string::npos, summary.find("indexer"));
+}
@@ -0,0 +1,172 @@
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "LayeredGraphLayouter.h"
+
+using namespace ::testing;
+
+namespace {
+constexpr int LAYER_GAP = 150;
+constexpr int NODE_GAP = 30;
+constexpr int VIRTUAL_NODE_HEIGHT = 20;
+
+void expectNoOverlapsWithinLayers(const LayeredGraphLayouter& layouter) {
+  for(size_t a = 0; a < layouter.getNodeCount(); a++) {
+    for(size_t b = a + 1; b < layouter.getNodeCount(); b++) {
+      if(layouter.getLevel(a) < 0 || layouter.getLevel(a) != layouter.getLevel(b)) {
+        continue;
+      }
+
+      const bool aAboveB = layouter.getY(a) + layouter.getHeight(a) + NODE_GAP <= layouter.getY(b);
+      const bool bAboveA = layouter.getY(b) + layouter.getHeight(b) + NODE_GAP <= layouter.getY(a);
+      EXPECT_TRUE(aAboveB || bAboveA) << "nodes " << a << " and " << b << " overlap";
+    }
+  }
+}
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, chainIsLayeredFromRoot) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  const size_t a = layouter.addNode(100, 20);
+  const size_t b = layouter.addNode(50, 20);
+  const size_t c = layouter.addNode(80, 20);
+  layouter.addEdge(a, b);
+  layouter.addEdge(b, c);
+
+  layouter.layout(a);
+
+  EXPECT_EQ(0, layouter.getLevel(a));
+  EXPECT_EQ(1, layouter.getLevel(b));
+  EXPECT_EQ(2, layouter.getLevel(c));
+
+  EXPECT_EQ(0, layouter.getX(a));
+  EXPECT_EQ(100 + LAYER_GAP, layouter.getX(b));
+  EXPECT_EQ(100 + LAYER_GAP + 50 + LAYER_GAP, layouter.getX(c));
+  EXPECT_EQ(layouter.getY(a), layouter.getY(c));
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, invertedLayersGrowToNegativeX) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, true);
+  const size_t a = layouter.addNode(100, 20);
+  const size_t b = layouter.addNode(50, 20);
+  layouter.addEdge(a, b);
+
+  layouter.layout(a);
+
+  EXPECT_EQ(0, layouter.getX(a));
+  EXPECT_EQ(-(50 + LAYER_GAP), layouter.getX(b));
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, cyclesAreBroken) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  const size_t a = layouter.addNode(10, 10);
+  const size_t b = layouter.addNode(10, 10);
+  const size_t c = layouter.addNode(10, 10);
+  layouter.addEdge(a, b);
+  layouter.addEdge(b, c);
+  layouter.addEdge(c, a);
+
+  layouter.layout(a);
+
+  EXPECT_EQ(0, layouter.getLevel(a));
+  EXPECT_EQ(1, layouter.getLevel(b));
+  EXPECT_EQ(2, layouter.getLevel(c));
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, unreachableNodesAreLayeredFromTheirSources) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  const size_t a = layouter.addNode(10, 10);
+  const size_t b = layouter.addNode(10, 10);
+  const size_t c = layouter.addNode(10, 10);
+  const size_t d = layouter.addNode(10, 10);
+  const size_t e = layouter.addNode(10, 10);
+  layouter.addEdge(a, b);
+  layouter.addEdge(c, b);
+  layouter.addEdge(d, e);
+  layouter.addEdge(e, d);
+
+  layouter.layout(a);
+
+  EXPECT_EQ(0, layouter.getLevel(a));
+  EXPECT_EQ(1, layouter.getLevel(b));
+  EXPECT_EQ(0, layouter.getLevel(c));
+  EXPECT_EQ(0, layouter.getLevel(d));
+  EXPECT_EQ(1, layouter.getLevel(e));
+  expectNoOverlapsWithinLayers(layouter);
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, longEdgesGetVirtualNodesInEdgeDirection) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  const size_t a = layouter.addNode(10, 10);
+  const size_t b = layouter.addNode(70, 10);
+  const size_t c = layouter.addNode(10, 10);
+  const size_t d = layouter.addNode(10, 10);
+  layouter.addEdge(a, b);
+  layouter.addEdge(b, c);
+  layouter.addEdge(c, d);
+  const size_t forward = layouter.addEdge(a, d);
+  const size_t backward = layouter.addEdge(d, a);
+
+  layouter.layout(a);
+
+  const std::vector<size_t>& forwardNodes = layouter.getVirtualNodes(forward);
+  ASSERT_EQ(2, forwardNodes.size());
+  EXPECT_EQ(1, layouter.getLevel(forwardNodes[0]));
+  EXPECT_EQ(2, layouter.getLevel(forwardNodes[1]));
+  EXPECT_EQ(70, layouter.getWidth(forwardNodes[0]));
+  EXPECT_EQ(VIRTUAL_NODE_HEIGHT, layouter.getHeight(forwardNodes[0]));
+
+  const std::vector<size_t>& backwardNodes = layouter.getVirtualNodes(backward);
+  ASSERT_EQ(2, backwardNodes.size());
+  EXPECT_EQ(2, layouter.getLevel(backwardNodes[0]));
+  EXPECT_EQ(1, layouter.getLevel(backwardNodes[1]));
+
+  expectNoOverlapsWithinLayers(layouter);
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, crossingsAreRemoved) {
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  const size_t root = layouter.addNode(10, 10);
+  const size_t a = layouter.addNode(10, 10);
+  const size_t b = layouter.addNode(10, 10);
+  const size_t c = layouter.addNode(10, 10);
+  const size_t d = layouter.addNode(10, 10);
+  layouter.addEdge(root, a);
+  layouter.addEdge(root, b);
+  layouter.addEdge(root, c);
+  layouter.addEdge(root, d);
+  layouter.addEdge(c, a);
+  layouter.addEdge(d, b);
+  layouter.addEdge(a, b);
+
+  layouter.layout(root);
+
+  EXPECT_EQ(0, layouter.getCrossingCount());
+  expectNoOverlapsWithinLayers(layouter);
+}
+
+// NOLINTNEXTLINE
+TEST(LayeredGraphLayouter, largeGraphsAreLaidOut) {
+  constexpr size_t NodeCount = 20000;
+
+  LayeredGraphLayouter layouter(LAYER_GAP, NODE_GAP, VIRTUAL_NODE_HEIGHT, false);
+  for(size_t i = 0; i < NodeCount; i++) {
+    layouter.addNode(100, 20);
+  }
+  for(size_t i = 1; i < NodeCount; i++) {
+    layouter.addEdge(i - 1, i);
+  }
+  for(size_t i = 3; i < NodeCount; i++) {
+    layouter.addEdge(i, i - 1 - i % 3);
+  }
+
+  layouter.layout(0);
+
+  EXPECT_EQ(static_cast<int>(NodeCount) - 1, layouter.getLevel(NodeCount - 1));
+}
@@ -0,0 +1,77 @@
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "LruCache.h"
+
+using namespace ::testing;
+
+// NOLINTNEXTLINE
+TEST(LruCache, storedValuesAreFound) {
+  LruCache<int, int> cache(10);
+  cache.insert(1, 11, 1);
+  cache.insert(2, 22, 1);
+
+  int value = 0;
+  EXPECT_TRUE(cache.getValue(1, value));
+  EXPECT_EQ(11, value);
+  EXPECT_TRUE(cache.getValue(2, value));
+  EXPECT_EQ(22, value);
+  EXPECT_FALSE(cache.getValue(3, value));
+  EXPECT_EQ(2, cache.getSize());
+  EXPECT_EQ(2, cache.getCost());
+}
+
+// NOLINTNEXTLINE
+TEST(LruCache, leastRecentlyUsedValueIsEvicted) {
+  LruCache<int, int> cache(3);
+  cache.insert(1, 11, 1);
+  cache.insert(2, 22, 1);
+  cache.insert(3, 33, 1);
+
+  int value = 0;
+  EXPECT_TRUE(cache.getValue(1, value));
+
+  cache.insert(4, 44, 2);
+
+  EXPECT_TRUE(cache.getValue(1, value));
+  EXPECT_FALSE(cache.getValue(2, value));
+  EXPECT_FALSE(cache.getValue(3, value));
+  EXPECT_TRUE(cache.getValue(4, value));
+  EXPECT_EQ(3, cache.getCost());
+}
+
+// NOLINTNEXTLINE
+TEST(LruCache, insertReplacesExistingValue) {
+  LruCache<int, int> cache(10);
+  cache.insert(1, 11, 4);
+  cache.insert(1, 12, 2);
+
+  int value = 0;
+  EXPECT_TRUE(cache.getValue(1, value));
+  EXPECT_EQ(12, value);
+  EXPECT_EQ(1, cache.getSize());
+  EXPECT_EQ(2, cache.getCost());
+}
+
+// NOLINTNEXTLINE
+TEST(LruCache, valuesExceedingMaxCostAreNotStored) {
+  LruCache<int, int> cache(3);
+  cache.insert(1, 11, 1);
+  cache.insert(2, 22, 4);
+
+  int value = 0;
+  EXPECT_TRUE(cache.getValue(1, value));
+  EXPECT_FALSE(cache.getValue(2, value));
+}
+
+// NOLINTNEXTLINE
+TEST(LruCache, clearRemovesAllValues) {
+  LruCache<int, int> cache(3);
+  cache.insert(1, 11, 1);
+  cache.clear();
+
+  int value = 0;
+  EXPECT_FALSE(cache.getValue(1, value));
+  EXPECT_EQ(0, cache.getSize());
+  EXPECT_EQ(0, cache.getCost());
+}
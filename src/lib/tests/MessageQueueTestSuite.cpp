@@ -0,0 +1,153 @@
+// STL
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "filter_types/MessageFilterIndexingStatus.h"
+#include "filter_types/MessageFilterScroll.h"
+#include "MessageListener.h"
+#include "MessageQueue.h"
+#include "type/code/MessageScrollCode.h"
+#include "type/indexing/MessageIndexingStatus.h"
+#include "type/MessageStatus.h"
+#include "utilityString.h"
+
+using namespace ::testing;
+
+namespace {
+class RecordingListener
+    : public MessageListener<MessageStatus>
+    , public MessageListener<MessageScrollCode>
+    , public MessageListener<MessageIndexingStatus> {
+public:
+  std::vector<std::string> getHandled() const {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    return m_handled;
+  }
+
+  std::function<void()> onScroll;
+
+private:
+  void handleMessage(MessageStatus* message) override {
+    record("status " + utility::encodeToUtf8(message->status()));
+  }
+
+  void handleMessage(MessageScrollCode* message) override {
+    record("scroll " + std::to_string(message->value));
+    if(onScroll) {
+      onScroll();
+    }
+  }
+
+  void handleMessage(MessageIndexingStatus* message) override {
+    record("progress " + std::to_string(message->progressPercent));
+  }
+
+  void record(const std::string& handled) {
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_handled.push_back(handled);
+  }
+
+  mutable std::mutex m_mutex;
+  std::vector<std::string> m_handled;
+};
+
+struct MessageQueueFix : Test {
+  void SetUp() override {
+    mQueue = std::make_shared<details::MessageQueue>();
+    IMessageQueue::setInstance(mQueue);
+  }
+
+  void TearDown() override {
+    if(mQueue->loopIsRunning()) {
+      mQueue->stopMessageLoop();
+    }
+    IMessageQueue::setInstance(nullptr);
+    mQueue.reset();
+  }
+
+  void processAll(const RecordingListener& listener, size_t handledCount) {
+    mQueue->startMessageLoopThreaded();
+    for(int i = 0; i < 200 && listener.getHandled().size() < handledCount; i++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    mQueue->stopMessageLoop();
+  }
+
+  std::shared_ptr<details::MessageQueue> mQueue;
+};
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST_F(MessageQueueFix, interactiveMessagesAreHandledBeforeStatusAndBackgroundMessages) {
+  RecordingListener listener;
+
+  mQueue->pushMessage(std::make_shared<MessageIndexingStatus>(true, 10));
+  mQueue->pushMessage(std::make_shared<MessageStatus>(L"first"));
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(1, false));
+  mQueue->pushMessage(std::make_shared<MessageStatus>(L"second"));
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(2, true));
+
+  processAll(listener, 5);
+
+  const std::vector<std::string> expected = {"scroll 1", "scroll 2", "status first", "status second", "progress 10"};
+  EXPECT_EQ(expected, listener.getHandled());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MessageQueueFix, consecutiveScrollsAreCoalesced) {
+  RecordingListener listener;
+  mQueue->addMessageFilter(std::make_shared<MessageFilterScroll>());
+
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(1, false));
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(2, false));
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(3, false));
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(4, true));
+
+  processAll(listener, 2);
+
+  const std::vector<std::string> expected = {"scroll 3", "scroll 4"};
+  EXPECT_EQ(expected, listener.getHandled());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MessageQueueFix, onlyLatestIndexingStatusIsHandled) {
+  RecordingListener listener;
+  mQueue->addMessageFilter(std::make_shared<MessageFilterIndexingStatus>());
+
+  mQueue->pushMessage(std::make_shared<MessageIndexingStatus>(true, 10));
+  mQueue->pushMessage(std::make_shared<MessageIndexingStatus>(true, 20));
+  mQueue->pushMessage(std::make_shared<MessageIndexingStatus>(true, 30));
+
+  processAll(listener, 1);
+
+  const std::vector<std::string> expected = {"progress 30"};
+  EXPECT_EQ(expected, listener.getHandled());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MessageQueueFix, listenersUnregisteredWhileHandlingAreSkipped) {
+  RecordingListener first;
+  auto second = std::make_unique<RecordingListener>();
+  std::unique_ptr<RecordingListener> added;
+  first.onScroll = [&second, &added]() {
+    second.reset();
+    added = std::make_unique<RecordingListener>();
+  };
+
+  mQueue->pushMessage(std::make_shared<MessageScrollCode>(1, false));
+
+  processAll(first, 1);
+
+  const std::vector<std::string> expected = {"scroll 1"};
+  EXPECT_EQ(expected, first.getHandled());
+  EXPECT_EQ(nullptr, second);
+  ASSERT_NE(nullptr, added);
+  EXPECT_TRUE(added->getHandled().empty());
+}
@@ -192,6 +192,29 @@ TEST_F(ProjectFix, loadGoodCase) {
   EXPECT_FALSE(mProject->isIndexing());
 }
 
+TEST_F(ProjectFix, refreshChangedFilesWithoutFileWatcher) {
+  // Given: The project is loaded without watching its files
+  mProject->m_state = Project::ProjectStateType::LOADED;
+
+  // When: Refreshing the changed files
+  mProject->refreshChangedFiles(mDialogView);
+
+  // Then: Nothing is refreshed
+  EXPECT_EQ(Project::RefreshStageType::NONE, mProject->m_refreshStage);
+}
+
+TEST_F(ProjectFix, refreshChangedFilesWhileIndexing) {
+  // Given: The project is indexing
+  mProject->m_state = Project::ProjectStateType::LOADED;
+  mProject->m_refreshStage = Project::RefreshStageType::INDEXING;
+
+  // When: Refreshing the changed files
+  mProject->refreshChangedFiles(mDialogView);
+
+  // Then: The indexing is not interrupted
+  EXPECT_TRUE(mProject->isIndexing());
+}
+
 TEST_F(ProjectFix, DISABLED_loadFailed) {
   EXPECT_CALL(*mSettings, load(_, _)).WillOnce(Return(true));
   EXPECT_CALL(*mStorageCache, setUseErrorCache(_)).WillOnce(Return());
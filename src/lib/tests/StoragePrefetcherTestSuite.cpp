@@ -0,0 +1,67 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "mocks/MockedStorageAccess.hpp"
+#include "mocks/MockedTaskManager.hpp"
+#include "SourceLocationCollection.h"
+#include "StorageCache.h"
+#include "StoragePrefetcher.h"
+#include "TaskScheduler.h"
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+struct StoragePrefetcherFix : Test {
+  void SetUp() override {
+    mTaskManager = std::make_shared<NiceMock<scheduling::mocks::MockedTaskManager>>();
+    ON_CALL(*mTaskManager, getScheduler).WillByDefault(Return(mScheduler));
+    scheduling::ITaskManager::setInstance(mTaskManager);
+    mScheduler->startSchedulerLoopThreaded();
+
+    mStorageCache.setSubject(mStorageAccess);
+  }
+
+  void TearDown() override {
+    mScheduler->stopSchedulerLoop();
+    scheduling::ITaskManager::setInstance(nullptr);
+    mTaskManager.reset();
+  }
+
+  void waitForPrefetch() const {
+    for(int i = 0; i < 500 && mScheduler->hasTasksQueued(); i++) {
+      std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_FALSE(mScheduler->hasTasksQueued());
+  }
+
+  std::shared_ptr<TaskScheduler> mScheduler = std::make_shared<TaskScheduler>(GlobalId{});
+  std::shared_ptr<NiceMock<scheduling::mocks::MockedTaskManager>> mTaskManager;
+  std::shared_ptr<NiceMock<MockedStorageAccess>> mStorageAccess = std::make_shared<NiceMock<MockedStorageAccess>>();
+  StorageCache mStorageCache;
+};
+
+// NOLINTNEXTLINE
+TEST_F(StoragePrefetcherFix, prefetchedSourceLocationsAreUsedForActivation) {
+  const std::vector<Id> activeTokenIds = {1, 2, 3};
+  ON_CALL(*mStorageAccess, getActiveTokenIdsForId(1, _)).WillByDefault(Return(activeTokenIds));
+
+  auto collection = std::make_shared<SourceLocationCollection>();
+  collection->addSourceLocation(LOCATION_TOKEN, 4, {2}, FilePath(L"file.cpp"), 1, 1, 1, 5);
+  EXPECT_CALL(*mStorageAccess, getSourceLocationsForTokenIds(activeTokenIds)).WillOnce(Return(collection));
+
+  StoragePrefetcher prefetcher(&mStorageCache);
+  prefetcher.prefetch({1}, {});
+  waitForPrefetch();
+
+  // the lookup CodeController runs when node 1 gets activated
+  Id declarationId = 0;
+  std::shared_ptr<SourceLocationCollection> result = mStorageCache.getSourceLocationsForTokenIds(
+      mStorageCache.getActiveTokenIdsForId(1, &declarationId));
+
+  ASSERT_TRUE(result);
+  EXPECT_EQ(1, result->getSourceLocationCount());
+}
@@ -8,6 +8,7 @@ TEST(TabId, goodCase) {
   EXPECT_EQ(1, TabId::app());
   EXPECT_EQ(2, TabId::background());
   EXPECT_EQ(3, TabId::ignore());
+  EXPECT_EQ(4, TabId::prefetch());
 
   EXPECT_EQ(0, TabId::currentTab());
   TabId::setCurrentTabId(100);
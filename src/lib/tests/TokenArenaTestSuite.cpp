@@ -0,0 +1,85 @@
+// GTest
+#include <gtest/gtest.h>
+// internal
+#include "TokenArena.h"
+
+using namespace ::testing;
+
+namespace {
+class TestToken {
+public:
+  TestToken(Id id, int value) : m_id(id), m_value(value) {}
+
+  Id getId() const {
+    return m_id;
+  }
+
+  int getValue() const {
+    return m_value;
+  }
+
+private:
+  const Id m_id;
+  const int m_value;
+};
+}    // namespace
+
+// NOLINTNEXTLINE
+TEST(TokenArena, emplacedTokensAreFound) {
+  TokenArena<TestToken> arena;
+  TestToken* a = arena.emplace(1, 11);
+  TestToken* b = arena.emplace(2, 22);
+
+  EXPECT_EQ(a, arena.find(1));
+  EXPECT_EQ(b, arena.find(2));
+  EXPECT_EQ(22, arena.find(2)->getValue());
+  EXPECT_EQ(nullptr, arena.find(3));
+  EXPECT_EQ(2, arena.size());
+}
+
+// NOLINTNEXTLINE
+TEST(TokenArena, tokensAreOrderedById) {
+  TokenArena<TestToken> arena;
+  TestToken* c = arena.emplace(30, 0);
+  TestToken* a = arena.emplace(10, 0);
+  TestToken* d = arena.emplace(40, 0);
+  TestToken* b = arena.emplace(20, 0);
+
+  EXPECT_EQ(std::vector<TestToken*>({a, b, c, d}), arena.getTokens());
+}
+
+// NOLINTNEXTLINE
+TEST(TokenArena, erasedTokensAreRemoved) {
+  TokenArena<TestToken> arena;
+  TestToken* a = arena.emplace(1, 0);
+  arena.emplace(2, 0);
+  TestToken* c = arena.emplace(3, 0);
+
+  EXPECT_TRUE(arena.erase(2));
+  EXPECT_FALSE(arena.erase(2));
+
+  EXPECT_EQ(nullptr, arena.find(2));
+  EXPECT_EQ(std::vector<TestToken*>({a, c}), arena.getTokens());
+}
+
+// NOLINTNEXTLINE
+TEST(TokenArena, tokenAddressesAreStable) {
+  TokenArena<TestToken> arena;
+  TestToken* first = arena.emplace(1, 11);
+  for(Id id = 2; id < 10000; id++) {
+    arena.emplace(id, 0);
+  }
+
+  EXPECT_EQ(first, arena.find(1));
+  EXPECT_EQ(11, first->getValue());
+}
+
+// NOLINTNEXTLINE
+TEST(TokenArena, clearRemovesAllTokens) {
+  TokenArena<TestToken> arena;
+  arena.emplace(1, 0);
+  arena.clear();
+
+  EXPECT_EQ(0, arena.size());
+  EXPECT_EQ(nullptr, arena.find(1));
+}
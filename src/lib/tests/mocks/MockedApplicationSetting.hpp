@@ -52,6 +52,9 @@ struct MockedApplicationSettings : IApplicationSettings {
   MOCK_METHOD(GroupType, getGraphGrouping, (), (const, noexcept, override));
   MOCK_METHOD(void, setGraphGrouping, (GroupType), (noexcept, override));
 
+  MOCK_METHOD(bool, getInMemoryIndexEnabled, (), (const, noexcept, override));
+  MOCK_METHOD(void, setInMemoryIndexEnabled, (bool), (noexcept, override));
+
   // screen
   MOCK_METHOD(int, getScreenAutoScaling, (), (const, noexcept, override));
   MOCK_METHOD(void, setScreenAutoScaling, (int), (noexcept, override));
@@ -82,6 +85,12 @@ struct MockedApplicationSettings : IApplicationSettings {
   MOCK_METHOD(bool, getMultiProcessIndexingEnabled, (), (const, noexcept, override));
   MOCK_METHOD(void, setMultiProcessIndexingEnabled, (bool), (noexcept, override));
 
+  MOCK_METHOD(int, getIndexingStorageProfile, (), (const, noexcept, override));
+  MOCK_METHOD(void, setIndexingStorageProfile, (int), (noexcept, override));
+
+  MOCK_METHOD(bool, getWatchSourceFilesEnabled, (), (const, noexcept, override));
+  MOCK_METHOD(void, setWatchSourceFilesEnabled, (bool), (noexcept, override));
+
   MOCK_METHOD(std::vector<std::filesystem::path>, getHeaderSearchPaths, (), (const, noexcept, override));
   MOCK_METHOD(std::vector<std::filesystem::path>, getHeaderSearchPathsExpanded, (), (const, noexcept, override));
   MOCK_METHOD(bool, setHeaderSearchPaths, (const std::vector<std::filesystem::path>&), (noexcept, override));
@@ -18,6 +18,8 @@ struct MockedProject : IProject {
 
   MOCK_METHOD(void, refresh, (std::shared_ptr<DialogView>, RefreshMode, bool), (override));
 
+  MOCK_METHOD(void, refreshChangedFiles, (std::shared_ptr<DialogView>), (override));
+
   MOCK_METHOD(RefreshInfo, getRefreshInfo, (RefreshMode), (const, override));
 
   MOCK_METHOD(void, buildIndex, (RefreshInfo, std::shared_ptr<DialogView>), (override));
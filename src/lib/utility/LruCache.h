@@ -0,0 +1,100 @@
+#pragma once
+// STL
+#include <list>
+#include <map>
+#include <utility>
+
+/**
+ * Bounded cache that evicts the least recently used entries once the summed cost of all entries exceeds the maximum
+ * cost. The cost of an entry is provided by the caller, e.g. an estimate of its memory size.
+ */
+template <typename KeyType, typename ValType>
+class LruCache {
+public:
+  explicit LruCache(size_t maxCost);
+
+  // returns false if there is no value for the key, otherwise writes it to value and marks the entry as recently used
+  bool getValue(const KeyType& key, ValType& value);
+
+  // values that cost more than the maximum cost are not stored
+  void insert(const KeyType& key, ValType value, size_t cost);
+
+  void clear();
+
+  [[nodiscard]] size_t getSize() const;
+  [[nodiscard]] size_t getCost() const;
+
+private:
+  struct Entry {
+    KeyType key;
+    ValType value;
+    size_t cost;
+  };
+
+  void erase(typename std::list<Entry>::iterator iterator);
+
+  size_t m_maxCost;
+  size_t m_cost = 0;
+
+  std::list<Entry> m_entries;    // most recently used first
+  std::map<KeyType, typename std::list<Entry>::iterator> m_index;
+};
+
+template <typename KeyType, typename ValType>
+LruCache<KeyType, ValType>::LruCache(size_t maxCost) : m_maxCost(maxCost) {}
+
+template <typename KeyType, typename ValType>
+bool LruCache<KeyType, ValType>::getValue(const KeyType& key, ValType& value) {
+  auto iterator = m_index.find(key);
+  if(iterator == m_index.end()) {
+    return false;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, iterator->second);
+  value = iterator->second->value;
+  return true;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::insert(const KeyType& key, ValType value, size_t cost) {
+  auto iterator = m_index.find(key);
+  if(iterator != m_index.end()) {
+    erase(iterator->second);
+  }
+
+  if(cost > m_maxCost) {
+    return;
+  }
+
+  while(!m_entries.empty() && m_cost + cost > m_maxCost) {
+    erase(std::prev(m_entries.end()));
+  }
+
+  m_entries.push_front(Entry{key, std::move(value), cost});
+  m_index.emplace(key, m_entries.begin());
+  m_cost += cost;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::clear() {
+  m_entries.clear();
+  m_index.clear();
+  m_cost = 0;
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getSize() const {
+  return m_entries.size();
+}
+
+template <typename KeyType, typename ValType>
+size_t LruCache<KeyType, ValType>::getCost() const {
+  return m_cost;
+}
+
+template <typename KeyType, typename ValType>
+void LruCache<KeyType, ValType>::erase(typename std::list<Entry>::iterator iterator) {
+  m_cost -= iterator->cost;
+  m_index.erase(iterator->key);
+  m_entries.erase(iterator);
+}
@@ -5,6 +5,7 @@
 
 #include "CommandlineCommandConfig.h"
 #include "CommandlineCommandIndex.h"
+#include "CommandlineCommandServe.h"
 #include "ConfigManager.hpp"
 #include "TextAccess.h"
 
@@ -27,6 +28,7 @@ CommandLineParser::CommandLineParser(std::string version) : m_version(std::move(
   // NOTE: Should be moved
   m_commands.push_back(std::make_unique<commandline::CommandlineCommandConfig>(this));
   m_commands.push_back(std::make_unique<commandline::CommandlineCommandIndex>(this));
+  m_commands.push_back(std::make_unique<commandline::CommandlineCommandServe>(this));
 
   for(auto& command : m_commands) {
     command->setup();
@@ -199,4 +201,17 @@ bool CommandLineParser::getShallowIndexingRequested() const {
   return m_shallowIndexingRequested;
 }
 
+void CommandLineParser::setDaemonSocketPath(const FilePath& socketPath) {
+  m_daemonSocketPath = socketPath;
+  m_runAsDaemon = true;
+}
+
+bool CommandLineParser::runAsDaemon() const {
+  return m_runAsDaemon;
+}
+
+const FilePath& CommandLineParser::getDaemonSocketPath() const {
+  return m_daemonSocketPath;
+}
+
 }    // namespace commandline
@@ -48,6 +48,13 @@ public:
 
   [[nodiscard]] bool getShallowIndexingRequested() const;
 
+  // keeps the project loaded after indexing and answers requests on the socket
+  void setDaemonSocketPath(const FilePath& socketPath);
+
+  [[nodiscard]] bool runAsDaemon() const;
+
+  [[nodiscard]] const FilePath& getDaemonSocketPath() const;
+
 private:
   void processProjectfile();
 
@@ -63,6 +70,8 @@ private:
   FilePath m_projectFile;
   RefreshMode m_refreshMode = REFRESH_UPDATED_FILES;
   bool m_shallowIndexingRequested = false;
+  FilePath m_daemonSocketPath;
+  bool m_runAsDaemon = false;
 
   bool m_quit = false;
   bool m_withoutGUI = false;
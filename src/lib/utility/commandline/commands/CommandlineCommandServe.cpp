@@ -0,0 +1,67 @@
+#include "CommandlineCommandServe.h"
+
+#include <iostream>
+
+#include "CommandlineHelper.h"
+#include "CommandLineParser.h"
+
+namespace po = boost::program_options;
+
+namespace commandline {
+
+CommandlineCommandServe::CommandlineCommandServe(CommandLineParser* parser)
+    : CommandlineCommand("serve", "Keep a project indexed and serve requests.", parser) {}
+
+CommandlineCommandServe::~CommandlineCommandServe() = default;
+
+void CommandlineCommandServe::setup() {
+  po::options_description options("Config Options");
+  // clang-format off
+  options.add_options()
+    ("help,h", "Print this help message")
+    ("socket,s", po::value<std::string>(), "Socket to listen on (defaults to the project file with .sock extension)")
+    ("full,f", "Index full project on start (omit to only index new/changed files)")
+    ("project-file", po::value<std::string>(), "Project file to serve (.srctrlprj)");
+  // clang-format on
+  m_options.add(options);
+  m_positional.add("project-file", 1);
+}
+
+CommandlineCommand::ReturnStatus CommandlineCommandServe::parse(std::vector<std::string>& args) {
+  po::variables_map variablesMap;
+  try {
+    po::store(po::command_line_parser(args).options(m_options).positional(m_positional).run(), variablesMap);
+    po::notify(variablesMap);
+
+    parseConfigFile(variablesMap, m_options);
+  } catch(po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+    std::cerr << m_options << std::endl;
+    return ReturnStatus::CMD_FAILURE;
+  }
+
+  if((variablesMap.count("help") != 0U) || args.empty() || args[0] == "help") {
+    printHelp();
+    return ReturnStatus::CMD_QUIT;
+  }
+
+  if(variablesMap.count("full") != 0U) {
+    m_parser->fullRefresh();
+  }
+
+  if(variablesMap.count("project-file") != 0U) {
+    m_parser->setProjectFile(FilePath(variablesMap["project-file"].as<std::string>()));
+  }
+
+  FilePath socketPath;
+  if(variablesMap.count("socket") != 0U) {
+    socketPath = FilePath(variablesMap["socket"].as<std::string>());
+  } else if(!m_parser->getProjectFilePath().empty()) {
+    socketPath = m_parser->getProjectFilePath().replaceExtension(L".sock");
+  }
+  m_parser->setDaemonSocketPath(socketPath);
+
+  return ReturnStatus::CMD_OK;
+}
+
+}    // namespace commandline
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CommandlineCommand.h"
+
+namespace commandline {
+
+class CommandlineCommandServe : public CommandlineCommand {
+public:
+  explicit CommandlineCommandServe(CommandLineParser* parser);
+
+  CommandlineCommandServe(const CommandlineCommandServe&) = delete;
+  CommandlineCommandServe& operator=(const CommandlineCommandServe&) = delete;
+  CommandlineCommandServe(CommandlineCommandServe&&) = delete;
+  CommandlineCommandServe& operator=(CommandlineCommandServe&&) = delete;
+
+  ~CommandlineCommandServe() override;
+
+  void setup() override;
+
+  ReturnStatus parse(std::vector<std::string>& args) override;
+
+  [[nodiscard]] bool hasHelp() const override {
+    return true;
+  }
+};
+
+}    // namespace commandline
\ No newline at end of file
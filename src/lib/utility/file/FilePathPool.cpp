@@ -0,0 +1,162 @@
+#include "FilePathPool.h"
+// STL
+#include <mutex>
+#include <utility>
+// boost
+#include <boost/filesystem.hpp>
+// internal
+#include "logging.h"
+#include "utilityString.h"
+
+FilePathPool* FilePathPool::getInstance() {
+  static FilePathPool sInstance;
+  return &sInstance;
+}
+
+FilePathPool::FilePathPool() {
+  Entry& emptyEntry = m_entries.emplace_back(std::wstring());
+  m_ids.emplace(emptyEntry.path, EmptyPathId);
+}
+
+PathId FilePathPool::getId(const FilePath& filePath) {
+  return getId(filePath.wstr());
+}
+
+PathId FilePathPool::getId(const std::wstring& filePath) {
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_ids.find(filePath);
+    if(it != m_ids.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(m_mutex);
+  auto it = m_ids.find(filePath);
+  if(it != m_ids.end()) {
+    return it->second;
+  }
+
+  const auto id = static_cast<PathId>(m_entries.size());
+  const Entry& entry = m_entries.emplace_back(filePath);
+  m_ids.emplace(entry.path, id);
+  return id;
+}
+
+FilePath FilePathPool::getFilePath(PathId id) const {
+  return FilePath(getString(id));
+}
+
+const std::wstring& FilePathPool::getString(PathId id) const {
+  return getEntry(id).path;
+}
+
+PathId FilePathPool::getLowerCaseId(PathId id) {
+  Entry& entry = getEntry(id);
+
+  PathId lowerCaseId = entry.lowerCaseId.load(std::memory_order_acquire);
+  if(lowerCaseId == UnknownId) {
+    lowerCaseId = getId(utility::toLowerCase(entry.path));
+    entry.lowerCaseId.store(lowerCaseId, std::memory_order_release);
+  }
+  return lowerCaseId;
+}
+
+PathId FilePathPool::getCanonicalId(PathId id) {
+  Entry& entry = getEntry(id);
+
+  PathId canonicalId = entry.canonicalId.load(std::memory_order_acquire);
+  if(canonicalId == UnknownId) {
+    canonicalId = exists(id) ? getId(FilePath(entry.path).makeCanonical()) : id;
+    entry.canonicalId.store(canonicalId, std::memory_order_release);
+  }
+  return canonicalId;
+}
+
+bool FilePathPool::exists(PathId id) {
+  Entry& entry = getEntry(id);
+
+  const uint8_t status = entry.status.load(std::memory_order_acquire);
+  if((status & STATUS_CHECKED_EXISTS) != 0) {
+    return (status & STATUS_EXISTS) != 0;
+  }
+
+  const bool exists = FilePath(entry.path).exists();
+  entry.status.fetch_or(static_cast<uint8_t>(STATUS_CHECKED_EXISTS | (exists ? STATUS_EXISTS : 0)), std::memory_order_acq_rel);
+  return exists;
+}
+
+bool FilePathPool::isDirectory(PathId id) {
+  Entry& entry = getEntry(id);
+
+  const uint8_t status = entry.status.load(std::memory_order_acquire);
+  if((status & STATUS_CHECKED_DIRECTORY) != 0) {
+    return (status & STATUS_DIRECTORY) != 0;
+  }
+
+  const bool isDirectory = FilePath(entry.path).isDirectory();
+  entry.status.fetch_or(static_cast<uint8_t>(STATUS_CHECKED_DIRECTORY | (isDirectory ? STATUS_DIRECTORY : 0)),
+                        std::memory_order_acq_rel);
+  return isDirectory;
+}
+
+std::time_t FilePathPool::getLastWriteTime(PathId id) {
+  Entry& entry = getEntry(id);
+
+  const uint8_t status = entry.status.load(std::memory_order_acquire);
+  if((status & STATUS_CHECKED_WRITE_TIME) != 0) {
+    return entry.lastWriteTime.load(std::memory_order_relaxed);
+  }
+
+  std::time_t lastWriteTime = 0;
+  if(exists(id)) {
+    boost::system::error_code error;
+    lastWriteTime = boost::filesystem::last_write_time(boost::filesystem::path(entry.path), error);
+    if(error) {
+      lastWriteTime = 0;
+    }
+  }
+  entry.lastWriteTime.store(lastWriteTime, std::memory_order_relaxed);
+  entry.status.fetch_or(STATUS_CHECKED_WRITE_TIME, std::memory_order_acq_rel);
+  return lastWriteTime;
+}
+
+void FilePathPool::setStatus(PathId id, bool isDirectory, std::time_t lastWriteTime) {
+  Entry& entry = getEntry(id);
+  entry.lastWriteTime.store(lastWriteTime, std::memory_order_relaxed);
+  entry.status.store(static_cast<uint8_t>(STATUS_CHECKED_EXISTS | STATUS_EXISTS | STATUS_CHECKED_DIRECTORY |
+                                         STATUS_CHECKED_WRITE_TIME | (isDirectory ? STATUS_DIRECTORY : 0)),
+                     std::memory_order_release);
+}
+
+void FilePathPool::invalidateStatus(PathId id) {
+  Entry& entry = getEntry(id);
+  entry.status.store(0, std::memory_order_release);
+  entry.canonicalId.store(UnknownId, std::memory_order_release);
+}
+
+void FilePathPool::invalidateAllStatus() {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  for(Entry& entry : m_entries) {
+    entry.status.store(0, std::memory_order_release);
+    entry.canonicalId.store(UnknownId, std::memory_order_release);
+  }
+}
+
+size_t FilePathPool::size() const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+const FilePathPool::Entry& FilePathPool::getEntry(PathId id) const {
+  std::shared_lock<std::shared_mutex> lock(m_mutex);
+  if(id >= m_entries.size()) {
+    LOG_ERROR("Unknown path id: " + std::to_string(id));
+    return m_entries[EmptyPathId];
+  }
+  return m_entries[id];
+}
+
+FilePathPool::Entry& FilePathPool::getEntry(PathId id) {
+  return const_cast<Entry&>(std::as_const(*this).getEntry(id));
+}
@@ -0,0 +1,89 @@
+#pragma once
+// STL
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+// internal
+#include "FilePath.h"
+
+using PathId = uint32_t;
+
+/**
+ * Process wide table of interned file paths. Every distinct path string gets a compact id that stays valid for the
+ * lifetime of the process, so maps keyed by paths can use the id and compare integers instead of path elements. The
+ * lower case and canonical form and the stat results of a path are computed once and cached with its entry.
+ *
+ * Ids are looked up under a shared lock, only interning a new path takes the exclusive lock. The cached forms and stat
+ * results are stored atomically and never need the exclusive lock.
+ */
+class FilePathPool {
+public:
+  // the empty path always has this id
+  static constexpr PathId EmptyPathId = 0;
+
+  static FilePathPool* getInstance();
+
+  PathId getId(const FilePath& filePath);
+  PathId getId(const std::wstring& filePath);
+
+  [[nodiscard]] FilePath getFilePath(PathId id) const;
+  // the generic form of the path, the reference stays valid for the lifetime of the pool
+  [[nodiscard]] const std::wstring& getString(PathId id) const;
+
+  PathId getLowerCaseId(PathId id);
+  // resolves symlinks of existing paths, paths that don't exist are their own canonical form
+  PathId getCanonicalId(PathId id);
+
+  bool exists(PathId id);
+  bool isDirectory(PathId id);
+  // zero if the path does not exist
+  std::time_t getLastWriteTime(PathId id);
+
+  // records what a directory scan already found out, so later queries don't stat the path again
+  void setStatus(PathId id, bool isDirectory, std::time_t lastWriteTime);
+
+  // stat results and canonical forms are computed again on next access, e.g. after files changed on disk
+  void invalidateStatus(PathId id);
+  void invalidateAllStatus();
+
+  [[nodiscard]] size_t size() const;
+
+private:
+  static constexpr PathId UnknownId = std::numeric_limits<PathId>::max();
+
+  enum StatusFlag : uint8_t {
+    STATUS_CHECKED_EXISTS = 1 << 0,
+    STATUS_EXISTS = 1 << 1,
+    STATUS_CHECKED_DIRECTORY = 1 << 2,
+    STATUS_DIRECTORY = 1 << 3,
+    STATUS_CHECKED_WRITE_TIME = 1 << 4,
+  };
+
+  struct Entry {
+    explicit Entry(std::wstring path_) : path(std::move(path_)) {}
+
+    const std::wstring path;
+    std::atomic<PathId> lowerCaseId = UnknownId;
+    std::atomic<PathId> canonicalId = UnknownId;
+    std::atomic<uint8_t> status = 0;
+    std::atomic<std::time_t> lastWriteTime = 0;
+  };
+
+  FilePathPool();
+  FilePathPool(const FilePathPool&) = delete;
+  void operator=(const FilePathPool&) = delete;
+
+  const Entry& getEntry(PathId id) const;
+  Entry& getEntry(PathId id);
+
+  // entries live in a deque so the keys of m_ids, which view their path strings, stay valid when entries are added
+  mutable std::shared_mutex m_mutex;
+  std::deque<Entry> m_entries;
+  std::unordered_map<std::wstring_view, PathId> m_ids;
+};
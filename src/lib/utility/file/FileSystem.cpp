@@ -1,39 +1,239 @@
 #include "FileSystem.h"
+// STL
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
 // boost
 #include <boost/date_time.hpp>
 #include <boost/date_time/c_local_time_adjustor.hpp>
 #include <boost/filesystem.hpp>
 // internal
+#include "FilePathPool.h"
 #include "utilityString.h"
 
+namespace {
+namespace stdfs = std::filesystem;
+
+constexpr size_t MaxScanThreadCount = 8;
+
+std::atomic<int> s_statusCacheCount = 0;
+
+enum class SymLinks {
+  SKIP,            // ignores symlinks to files and directories
+  FOLLOW_FILES,    // lists symlinks to files but does not enter symlinks to directories
+  FOLLOW_ALL,      // also enters symlinks to directories, every target directory only once
+};
+
+/**
+ * Walks directory trees on several threads. Directories are the unit of work: a thread takes a directory from the shared
+ * queue, lists it and queues all subdirectories it found at once, so wide and deep trees both keep the threads busy. The
+ * type of an entry comes with the directory listing, only symlinks need to be resolved with further system calls.
+ */
+class ParallelDirectoryWalker {
+public:
+  struct File {
+    stdfs::path path;
+    stdfs::path canonicalPath;
+  };
+
+  // called on the walking threads, threadIndex is below the thread count
+  using FileFunction = std::function<void(const File& file, size_t threadIndex)>;
+
+  ParallelDirectoryWalker(SymLinks symLinks, size_t threadCount)
+      : m_symLinks(symLinks), m_threadCount(std::max<size_t>(threadCount, 1)) {}
+
+  void walk(const std::vector<stdfs::path>& directories, const FileFunction& onFile) {
+    for(const stdfs::path& directory : directories) {
+      std::error_code error;
+      stdfs::path canonicalPath = stdfs::canonical(directory, error);
+      if(!error && markVisited(canonicalPath)) {
+        m_queue.push_back({directory, std::move(canonicalPath)});
+      }
+    }
+    m_pendingCount = m_queue.size();
+
+    std::vector<std::thread> threads;
+    for(size_t threadIndex = 1; threadIndex < m_threadCount; threadIndex++) {
+      threads.emplace_back([this, threadIndex, &onFile]() { run(threadIndex, onFile); });
+    }
+    run(0, onFile);
+
+    for(std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
+  [[nodiscard]] size_t getThreadCount() const {
+    return m_threadCount;
+  }
+
+private:
+  struct Directory {
+    stdfs::path path;
+    stdfs::path canonicalPath;
+  };
+
+  void run(size_t threadIndex, const FileFunction& onFile) {
+    std::vector<Directory> subDirectories;
+    while(true) {
+      Directory directory;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return !m_queue.empty() || m_pendingCount == 0; });
+        if(m_queue.empty()) {
+          return;
+        }
+        // depth first keeps the queue short on wide trees
+        directory = std::move(m_queue.back());
+        m_queue.pop_back();
+      }
+
+      subDirectories.clear();
+      listDirectory(directory, threadIndex, onFile, subDirectories);
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingCount += subDirectories.size();
+        m_pendingCount--;
+        std::move(subDirectories.begin(), subDirectories.end(), std::back_inserter(m_queue));
+      }
+      // wakes threads for the new directories or, when nothing is pending anymore, for finishing
+      m_condition.notify_all();
+    }
+  }
+
+  void listDirectory(const Directory& directory,
+                     size_t threadIndex,
+                     const FileFunction& onFile,
+                     std::vector<Directory>& subDirectories) {
+    std::error_code error;
+    stdfs::directory_iterator it(directory.path, stdfs::directory_options::skip_permission_denied, error);
+    for(; !error && it != stdfs::directory_iterator(); it.increment(error)) {
+      const stdfs::directory_entry& entry = *it;
+
+      std::error_code entryError;
+      if(entry.is_symlink(entryError)) {
+        if(m_symLinks == SymLinks::SKIP) {
+          continue;
+        }
+
+        // self referencing and dangling symlinks fail to resolve and are skipped
+        if(entry.is_directory(entryError)) {
+          if(m_symLinks == SymLinks::FOLLOW_ALL) {
+            stdfs::path canonicalPath = stdfs::canonical(entry.path(), entryError);
+            if(!entryError && markVisited(canonicalPath)) {
+              subDirectories.push_back({entry.path(), std::move(canonicalPath)});
+            }
+          }
+        } else if(entry.is_regular_file(entryError)) {
+          stdfs::path canonicalPath = stdfs::canonical(entry.path(), entryError);
+          if(!entryError) {
+            onFile({entry.path(), std::move(canonicalPath)}, threadIndex);
+          }
+        }
+      } else if(entry.is_directory(entryError)) {
+        subDirectories.push_back({entry.path(), directory.canonicalPath / entry.path().filename()});
+      } else if(entry.is_regular_file(entryError)) {
+        onFile({entry.path(), directory.canonicalPath / entry.path().filename()}, threadIndex);
+      }
+    }
+  }
+
+  bool markVisited(const stdfs::path& canonicalPath) {
+    std::lock_guard<std::mutex> lock(m_visitedMutex);
+    return m_visitedDirectories.insert(canonicalPath).second;
+  }
+
+  const SymLinks m_symLinks;
+  const size_t m_threadCount;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::vector<Directory> m_queue;
+  // directories that are queued or being listed
+  size_t m_pendingCount = 0;
+
+  std::mutex m_visitedMutex;
+  std::set<stdfs::path> m_visitedDirectories;
+};
+
+size_t getScanThreadCount() {
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, MaxScanThreadCount);
+}
+
+TimeStamp toLocalTimeStamp(std::time_t time) {
+  const boost::posix_time::ptime lastWriteTime = boost::posix_time::from_time_t(time);
+  return TimeStamp(boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(lastWriteTime));
+}
+
+// the file is known to exist
+FileInfo getFileInfoForExistingPath(const FilePath& filePath) {
+  boost::system::error_code error;
+  const std::time_t lastWriteTime = boost::filesystem::last_write_time(filePath.getPath(), error);
+  if(error) {
+    return FileInfo();
+  }
+
+  if(ScopedFileStatusCache::isActive()) {
+    FilePathPool* pathPool = FilePathPool::getInstance();
+    pathPool->setStatus(pathPool->getId(filePath), false, lastWriteTime);
+  }
+  return FileInfo(filePath, toLocalTimeStamp(lastWriteTime));
+}
+}    // namespace
+
+ScopedFileStatusCache::ScopedFileStatusCache() {
+  if(s_statusCacheCount.fetch_add(1) == 0) {
+    FilePathPool::getInstance()->invalidateAllStatus();
+  }
+}
+
+ScopedFileStatusCache::~ScopedFileStatusCache() {
+  if(s_statusCacheCount.fetch_sub(1) == 1) {
+    FilePathPool::getInstance()->invalidateAllStatus();
+  }
+}
+
+bool ScopedFileStatusCache::isActive() {
+  return s_statusCacheCount.load() > 0;
+}
+
 std::vector<FilePath> FileSystem::getFilePathsFromDirectory(const FilePath& path, const std::vector<std::wstring>& extensions) {
   std::set<std::wstring> ext(extensions.begin(), extensions.end());
   std::vector<FilePath> files;
 
   if(path.isDirectory()) {
-    boost::filesystem::recursive_directory_iterator it(path.getPath());
-    boost::filesystem::recursive_directory_iterator endit;
-    while(it != endit) {
-      if(boost::filesystem::is_symlink(*it)) {
-        // check for self-referencing symlinks
-        boost::filesystem::path p = boost::filesystem::read_symlink(*it);
-        if(p.filename() == p.string() && p.filename() == it->path().filename()) {
-          ++it;
-          continue;
-        }
-      }
+    ParallelDirectoryWalker walker(SymLinks::FOLLOW_FILES, getScanThreadCount());
 
-      if(boost::filesystem::is_regular_file(*it) && (ext.empty() || ext.find(it->path().extension().wstring()) != ext.end())) {
-        files.push_back(FilePath(it->path().generic_wstring()));
+    std::vector<std::vector<FilePath>> threadFiles(walker.getThreadCount());
+    walker.walk({stdfs::path(path.wstr())}, [&](const ParallelDirectoryWalker::File& file, size_t threadIndex) {
+      if(ext.empty() || ext.find(file.path.extension().wstring()) != ext.end()) {
+        threadFiles[threadIndex].emplace_back(file.path.generic_wstring());
       }
-      ++it;
+    });
+
+    for(std::vector<FilePath>& filePaths : threadFiles) {
+      std::move(filePaths.begin(), filePaths.end(), std::back_inserter(files));
     }
+    std::sort(files.begin(), files.end());
   }
   return files;
 }
 
+bool FileSystem::exists(const FilePath& filePath) {
+  if(ScopedFileStatusCache::isActive()) {
+    FilePathPool* pathPool = FilePathPool::getInstance();
+    return pathPool->exists(pathPool->getId(filePath));
+  }
+  return filePath.exists();
+}
+
 FileInfo FileSystem::getFileInfoForPath(const FilePath& filePath) {
-  if(filePath.exists()) {
+  if(exists(filePath)) {
     return FileInfo(filePath, getLastWriteTime(filePath));
   }
   return FileInfo();
@@ -46,63 +246,46 @@ std::vector<FileInfo> FileSystem::getFileInfosFromPaths(const std::vector<FilePa
   for(const std::wstring& e : fileExtensions) {
     ext.insert(utility::toLowerCase(e));
   }
+  const auto hasExtension = [&ext](const std::wstring& extension) {
+    return ext.empty() || ext.find(utility::toLowerCase(extension)) != ext.end();
+  };
 
-  std::set<boost::filesystem::path> symlinkDirs;
   std::set<FilePath> filePaths;
-
   std::vector<FileInfo> files;
+  const auto addFile = [&filePaths, &files](FileInfo&& info) {
+    if(!info.path.empty() && filePaths.insert(info.path).second) {
+      files.push_back(std::move(info));
+    }
+  };
 
+  std::vector<stdfs::path> directories;
   for(const FilePath& path : paths) {
     if(path.isDirectory()) {
-      boost::filesystem::recursive_directory_iterator it(path.getPath(), boost::filesystem::symlink_option::recurse);
-      boost::filesystem::recursive_directory_iterator endit;
-      boost::system::error_code ec;
-      for(; it != endit; it.increment(ec)) {
-        if(boost::filesystem::is_symlink(*it)) {
-          if(!followSymLinks) {
-            it.no_push();
-            continue;
-          }
-
-          // check for self-referencing symlinks
-          boost::filesystem::path p = boost::filesystem::read_symlink(*it);
-          if(p.filename() == p.string() && p.filename() == it->path().filename()) {
-            continue;
-          }
-
-          // check for duplicates when following directory symlinks
-          if(boost::filesystem::is_directory(*it)) {
-            boost::filesystem::path absDir = boost::filesystem::canonical(p, it->path().parent_path());
-
-            if(symlinkDirs.find(absDir) != symlinkDirs.end()) {
-              it.no_push();
-              continue;
-            }
+      directories.emplace_back(path.wstr());
+    } else if(path.exists() && hasExtension(path.extension())) {
+      addFile(getFileInfoForExistingPath(path.getCanonical()));
+    }
+  }
 
-            symlinkDirs.insert(absDir);
-          }
-        }
+  if(!directories.empty()) {
+    ParallelDirectoryWalker walker(followSymLinks ? SymLinks::FOLLOW_ALL : SymLinks::SKIP, getScanThreadCount());
 
-        if(boost::filesystem::is_regular_file(*it) &&
-           (ext.empty() || ext.find(utility::toLowerCase(it->path().extension().wstring())) != ext.end())) {
-          const FilePath canonicalPath = FilePath(it->path().wstring()).getCanonical();
-          if(filePaths.find(canonicalPath) != filePaths.end()) {
-            continue;
-          }
-          filePaths.insert(canonicalPath);
-          files.push_back(getFileInfoForPath(canonicalPath));
-        }
+    // stat'ing the files happens on the walking threads as well
+    std::vector<std::vector<FileInfo>> threadFiles(walker.getThreadCount());
+    walker.walk(directories, [&](const ParallelDirectoryWalker::File& file, size_t threadIndex) {
+      if(hasExtension(file.path.extension().wstring())) {
+        threadFiles[threadIndex].push_back(getFileInfoForExistingPath(FilePath(file.canonicalPath.wstring())));
       }
-    } else if(path.exists() && (ext.empty() || ext.find(utility::toLowerCase(path.extension())) != ext.end())) {
-      const FilePath canonicalPath = path.getCanonical();
-      if(filePaths.find(canonicalPath) != filePaths.end()) {
-        continue;
+    });
+
+    for(std::vector<FileInfo>& infos : threadFiles) {
+      for(FileInfo& info : infos) {
+        addFile(std::move(info));
       }
-      filePaths.insert(canonicalPath);
-      files.push_back(getFileInfoForPath(canonicalPath));
     }
   }
 
+  std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.path < b.path; });
   return files;
 }
 
@@ -154,13 +337,16 @@ unsigned long long FileSystem::getFileByteSize(const FilePath& filePath) {
 }
 
 TimeStamp FileSystem::getLastWriteTime(const FilePath& filePath) {
-  boost::posix_time::ptime lastWriteTime;
-  if(filePath.exists()) {
-    std::time_t t = boost::filesystem::last_write_time(filePath.getPath());
-    lastWriteTime = boost::posix_time::from_time_t(t);
-    lastWriteTime = boost::date_time::c_local_adjustor<boost::posix_time::ptime>::utc_to_local(lastWriteTime);
+  if(ScopedFileStatusCache::isActive()) {
+    FilePathPool* pathPool = FilePathPool::getInstance();
+    const PathId id = pathPool->getId(filePath);
+    if(pathPool->exists(id)) {
+      return toLocalTimeStamp(pathPool->getLastWriteTime(id));
+    }
+  } else if(filePath.exists()) {
+    return toLocalTimeStamp(boost::filesystem::last_write_time(filePath.getPath()));
   }
-  return TimeStamp(lastWriteTime);
+  return TimeStamp(boost::posix_time::ptime());
 }
 
 bool FileSystem::remove(const FilePath& path) {
@@ -7,10 +7,29 @@
 #include "FileInfo.h"
 #include "TimeStamp.h"
 
+/**
+ * While an instance is alive FileSystem caches stat results in the FilePathPool and directory scans record the status of
+ * the files they find there. Meant to span one project refresh, which otherwise stats the same files several times. The
+ * cached results are dropped again when the last instance goes away.
+ */
+class ScopedFileStatusCache final {
+public:
+  ScopedFileStatusCache();
+  ~ScopedFileStatusCache();
+
+  ScopedFileStatusCache(const ScopedFileStatusCache&) = delete;
+  ScopedFileStatusCache& operator=(const ScopedFileStatusCache&) = delete;
+
+  static bool isActive();
+};
+
 class FileSystem final {
 public:
+  // directory trees are listed on several threads, the order of the returned files is sorted by path
   static std::vector<FilePath> getFilePathsFromDirectory(const FilePath& path, const std::vector<std::wstring>& extensions = {});
 
+  static bool exists(const FilePath& filePath);
+
   static FileInfo getFileInfoForPath(const FilePath& filePath);
 
   static std::vector<FileInfo> getFileInfosFromPaths(const std::vector<FilePath>& paths,
@@ -0,0 +1,334 @@
+#include "FileWatcher.h"
+// STL
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+#ifdef __linux__
+#  include <poll.h>
+#  include <sys/eventfd.h>
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#endif
+// internal
+#include "logging.h"
+
+#ifdef __linux__
+namespace {
+constexpr uint32_t WatchMask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE |
+    IN_MOVE_SELF | IN_ONLYDIR;
+constexpr size_t EventBufferSize = 64 * 1024;
+
+bool isSameOrInside(const FilePath& path, const FilePath& directoryPath) {
+  const std::filesystem::path fsPath(path.wstr());
+  const std::filesystem::path fsDirectoryPath(directoryPath.wstr());
+  return std::mismatch(fsDirectoryPath.begin(), fsDirectoryPath.end(), fsPath.begin(), fsPath.end()).first ==
+      fsDirectoryPath.end();
+}
+}    // namespace
+#endif
+
+bool FileWatcher::isSupported() {
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+FileWatcher::FileWatcher(ChangeCallback onChange, std::chrono::milliseconds settleTime)
+    : m_onChange(std::move(onChange)), m_settleTime(settleTime) {}
+
+FileWatcher::~FileWatcher() {
+  stop();
+}
+
+bool FileWatcher::start() {
+#ifdef __linux__
+  if(m_thread.joinable()) {
+    return true;
+  }
+
+  m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(m_inotifyFd < 0) {
+    LOG_ERROR(std::string("Unable to initialize inotify: ") + std::strerror(errno));
+    return false;
+  }
+
+  m_stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if(m_stopFd < 0) {
+    LOG_ERROR(std::string("Unable to create event file descriptor: ") + std::strerror(errno));
+    close(m_inotifyFd);
+    m_inotifyFd = -1;
+    return false;
+  }
+
+  m_thread = std::thread(&FileWatcher::run, this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void FileWatcher::stop() {
+#ifdef __linux__
+  if(!m_thread.joinable()) {
+    return;
+  }
+
+  const uint64_t value = 1;
+  if(write(m_stopFd, &value, sizeof(value)) < 0) {
+    LOG_ERROR(std::string("Unable to stop file watcher: ") + std::strerror(errno));
+  }
+  m_thread.join();
+
+  close(m_inotifyFd);
+  close(m_stopFd);
+  m_inotifyFd = -1;
+  m_stopFd = -1;
+
+  std::lock_guard<std::mutex> lock(m_watchMutex);
+  m_watchedDirectories.clear();
+  m_watchedDirectoryPaths.clear();
+  m_watchLimitReached = false;
+#endif
+}
+
+void FileWatcher::addDirectories(const std::set<FilePath>& directoryPaths) {
+  for(const FilePath& directoryPath : directoryPaths) {
+    {
+      std::lock_guard<std::mutex> lock(m_watchMutex);
+      if(m_watchedDirectoryPaths.find(directoryPath) != m_watchedDirectoryPaths.end()) {
+        continue;
+      }
+    }
+    addDirectory(directoryPath, false);
+  }
+}
+
+size_t FileWatcher::getWatchedDirectoryCount() const {
+  std::lock_guard<std::mutex> lock(m_watchMutex);
+  return m_watchedDirectoryPaths.size();
+}
+
+bool FileWatcher::hasChanges() const {
+  {
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    if(m_watchLimitReached) {
+      return true;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_changesMutex);
+  return m_changes.overflowed || !m_changes.filePaths.empty();
+}
+
+FileChanges FileWatcher::consumeChanges() {
+  bool watchLimitReached = false;
+  {
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    watchLimitReached = m_watchLimitReached;
+  }
+
+  FileChanges changes;
+  {
+    std::lock_guard<std::mutex> lock(m_changesMutex);
+    std::swap(changes, m_changes);
+  }
+
+  // changes in directories that could not be watched are only found by scanning
+  changes.overflowed = changes.overflowed || watchLimitReached;
+  return changes;
+}
+
+void FileWatcher::run() {
+#ifdef __linux__
+  std::array<pollfd, 2> fds = {pollfd {m_inotifyFd, POLLIN, 0}, pollfd {m_stopFd, POLLIN, 0}};
+
+  while(true) {
+    const int timeout = m_hasUnreportedChanges ? static_cast<int>(m_settleTime.count()) : -1;
+    const int result = poll(fds.data(), fds.size(), timeout);
+    if(result < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      LOG_ERROR(std::string("Unable to wait for file changes: ") + std::strerror(errno));
+      break;
+    }
+
+    if((fds[1].revents & POLLIN) != 0) {
+      break;
+    }
+
+    if(result == 0) {
+      m_hasUnreportedChanges = false;
+      if(m_onChange) {
+        m_onChange();
+      }
+    } else if((fds[0].revents & POLLIN) != 0) {
+      readEvents();
+    }
+  }
+#endif
+}
+
+void FileWatcher::readEvents() {
+#ifdef __linux__
+  alignas(inotify_event) std::array<char, EventBufferSize> buffer;
+
+  while(true) {
+    const ssize_t length = read(m_inotifyFd, buffer.data(), buffer.size());
+    if(length <= 0) {
+      // the descriptor is non blocking, so the queue is empty once nothing can be read
+      break;
+    }
+
+    for(const char* position = buffer.data(); position < buffer.data() + length;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(position);
+      handleEvent(event->wd, event->mask, event->len > 0 ? event->name : nullptr);
+      position += sizeof(inotify_event) + event->len;
+    }
+  }
+#endif
+}
+
+void FileWatcher::handleEvent(int watchDescriptor, uint32_t mask, const char* name) {
+#ifdef __linux__
+  if((mask & IN_Q_OVERFLOW) != 0) {
+    LOG_WARNING("File watcher event queue overflowed");
+    setOverflowed();
+    return;
+  }
+
+  FilePath directoryPath;
+  {
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    auto it = m_watchedDirectories.find(watchDescriptor);
+    if(it == m_watchedDirectories.end()) {
+      return;
+    }
+
+    if((mask & IN_IGNORED) != 0) {
+      // the directory was removed, the parent directory reports it
+      m_watchedDirectoryPaths.erase(it->second);
+      m_watchedDirectories.erase(it);
+      return;
+    }
+    directoryPath = it->second;
+  }
+
+  if((mask & IN_MOVE_SELF) != 0) {
+    // the watch follows the moved directory, it already got its new path if the directory was moved into a watched one
+    std::error_code error;
+    if(!std::filesystem::is_directory(directoryPath.wstr(), error)) {
+      removeWatches(directoryPath);
+      setOverflowed();
+    }
+    return;
+  }
+
+  if(name == nullptr) {
+    return;
+  }
+
+  const FilePath filePath = directoryPath.getConcatenated(FilePath(name));
+  if((mask & IN_ISDIR) == 0) {
+    addChangedFilePath(filePath);
+  } else if((mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+    addDirectory(filePath, true);
+  } else if((mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+    // the files that were inside are not reported one by one
+    setOverflowed();
+  }
+#else
+  (void)watchDescriptor;
+  (void)mask;
+  (void)name;
+#endif
+}
+
+void FileWatcher::addDirectory(const FilePath& directoryPath, bool reportContainedFiles) {
+#ifdef __linux__
+  if(m_inotifyFd < 0) {
+    return;
+  }
+
+  const int watchDescriptor = inotify_add_watch(m_inotifyFd, directoryPath.str().c_str(), WatchMask);
+  if(watchDescriptor < 0) {
+    if(errno == ENOSPC) {
+      std::lock_guard<std::mutex> lock(m_watchMutex);
+      if(!m_watchLimitReached) {
+        LOG_WARNING("Reached the inotify watch limit, changes in further directories are found by scanning");
+        m_watchLimitReached = true;
+      }
+    } else if(errno != ENOENT && errno != ENOTDIR) {
+      LOG_WARNING("Unable to watch directory " + directoryPath.str() + ": " + std::strerror(errno));
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_watchMutex);
+    // a moved directory that is watched again keeps its watch descriptor
+    FilePath& watchedPath = m_watchedDirectories[watchDescriptor];
+    if(!watchedPath.empty()) {
+      m_watchedDirectoryPaths.erase(watchedPath);
+    }
+    watchedPath = directoryPath;
+    m_watchedDirectoryPaths.insert(directoryPath);
+  }
+
+  if(!reportContainedFiles) {
+    return;
+  }
+
+  // files may have been added to a new directory before it was watched
+  std::error_code error;
+  for(const auto& entry : std::filesystem::directory_iterator(directoryPath.wstr(), error)) {
+    const FilePath entryPath(entry.path().wstring());
+    if(entry.is_directory(error)) {
+      addDirectory(entryPath, true);
+    } else {
+      addChangedFilePath(entryPath);
+    }
+  }
+#else
+  (void)directoryPath;
+  (void)reportContainedFiles;
+#endif
+}
+
+void FileWatcher::removeWatches(const FilePath& directoryPath) {
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(m_watchMutex);
+  for(auto it = m_watchedDirectories.begin(); it != m_watchedDirectories.end();) {
+    if(isSameOrInside(it->second, directoryPath)) {
+      inotify_rm_watch(m_inotifyFd, it->first);
+      m_watchedDirectoryPaths.erase(it->second);
+      it = m_watchedDirectories.erase(it);
+    } else {
+      ++it;
+    }
+  }
+#else
+  (void)directoryPath;
+#endif
+}
+
+void FileWatcher::addChangedFilePath(const FilePath& filePath) {
+  {
+    std::lock_guard<std::mutex> lock(m_changesMutex);
+    m_changes.filePaths.insert(filePath);
+  }
+  m_hasUnreportedChanges = true;
+}
+
+void FileWatcher::setOverflowed() {
+  {
+    std::lock_guard<std::mutex> lock(m_changesMutex);
+    m_changes.overflowed = true;
+  }
+  m_hasUnreportedChanges = true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+// STL
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+// internal
+#include "FilePath.h"
+
+struct FileChanges {
+  std::set<FilePath> filePaths;
+  // events were lost, e.g. because the kernel queue overflowed, a directory was removed or moved or not all directories
+  // could be watched, and the changed files need to be found by scanning
+  bool overflowed = false;
+};
+
+/**
+ * Collects the files that are created, modified, moved or removed in a set of directories on a background thread.
+ * Directories are watched without their subdirectories, only directories created inside a watched directory are
+ * watched as well. The change callback is called on the watcher thread once no further event arrived for the settle
+ * time, so saving many files at once leads to one notification.
+ *
+ * Only implemented with inotify on Linux, on other platforms start() fails and nothing is reported.
+ */
+class FileWatcher final {
+public:
+  using ChangeCallback = std::function<void()>;
+
+  static bool isSupported();
+
+  FileWatcher(ChangeCallback onChange, std::chrono::milliseconds settleTime = std::chrono::milliseconds(1000));
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  bool start();
+  void stop();
+
+  // directories that are watched already are skipped, needs a started watcher
+  void addDirectories(const std::set<FilePath>& directoryPaths);
+
+  [[nodiscard]] size_t getWatchedDirectoryCount() const;
+
+  [[nodiscard]] bool hasChanges() const;
+  FileChanges consumeChanges();
+
+private:
+  void run();
+  void readEvents();
+  void addDirectory(const FilePath& directoryPath, bool reportContainedFiles);
+  // stops watching the directory and the directories inside of it
+  void removeWatches(const FilePath& directoryPath);
+  void addChangedFilePath(const FilePath& filePath);
+  void setOverflowed();
+  void handleEvent(int watchDescriptor, uint32_t mask, const char* name);
+
+  const ChangeCallback m_onChange;
+  const std::chrono::milliseconds m_settleTime;
+
+  int m_inotifyFd = -1;
+  int m_stopFd = -1;
+  std::thread m_thread;
+
+  mutable std::mutex m_watchMutex;
+  std::map<int, FilePath> m_watchedDirectories;
+  std::set<FilePath> m_watchedDirectoryPaths;
+  bool m_watchLimitReached = false;
+
+  mutable std::mutex m_changesMutex;
+  FileChanges m_changes;
+  // only used on the watcher thread
+  bool m_hasUnreportedChanges = false;
+};
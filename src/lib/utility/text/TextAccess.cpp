@@ -89,7 +89,7 @@ std::string TextAccess::getLine(const uint32_t lineNumber) const {
   return m_lines[lineNumber - 1];    // -1 to correct for use as index
 }
 
-std::vector<std::string> TextAccess::getLines(const uint32_t firstLineNumber, const uint32_t lastLineNumber) {
+std::vector<std::string> TextAccess::getLines(const uint32_t firstLineNumber, const uint32_t lastLineNumber) const {
   if(!checkIndexIntervalInRange(firstLineNumber, lastLineNumber)) {
     return {};
   }
@@ -113,6 +113,28 @@ std::string TextAccess::getText() const {
   return result;
 }
 
+std::string TextAccess::getText(const uint32_t firstLineNumber, const uint32_t lastLineNumber) const {
+  if(!checkIndexIntervalInRange(firstLineNumber, lastLineNumber)) {
+    return "";
+  }
+
+  auto first = m_lines.begin() + firstLineNumber - 1;    // -1 to correct for use as index
+  auto last = m_lines.begin() + lastLineNumber;
+
+  size_t size = 0;
+  for(auto it = first; it != last; it++) {
+    size += it->size();
+  }
+
+  std::string result;
+  result.reserve(size);
+  for(auto it = first; it != last; it++) {
+    result += *it;
+  }
+
+  return result;
+}
+
 std::vector<std::string> TextAccess::readFile(const FilePath& filePath) {
   std::vector<std::string> result;
 
@@ -32,12 +32,19 @@ public:
    * @param firstLineNumber: starts with 1
    * @param lastLineNumber: starts with 1
    */
-  std::vector<std::string> getLines(const uint32_t firstLineNumber, const uint32_t lastLineNumber);
+  std::vector<std::string> getLines(const uint32_t firstLineNumber, const uint32_t lastLineNumber) const;
 
   const std::vector<std::string>& getAllLines() const;
 
   [[nodiscard]] std::string getText() const;
 
+  /**
+   * Concatenated lines of the range, without copying the single lines first.
+   * @param firstLineNumber: starts with 1
+   * @param lastLineNumber: starts with 1
+   */
+  [[nodiscard]] std::string getText(const uint32_t firstLineNumber, const uint32_t lastLineNumber) const;
+
 private:
   static std::vector<std::string> readFile(const FilePath& filePath);
   static std::vector<std::string> splitStringByLines(const std::string& text);
@@ -1,56 +1,87 @@
 #include "tracing.h"
 // STL
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
 #include <set>
-
-std::shared_ptr<Tracer> Tracer::s_instance;
-Id Tracer::s_nextTraceId = 0;
-
-Tracer* Tracer::getInstance() {
-  if(!s_instance) {
-    s_instance = std::shared_ptr<Tracer>(new Tracer());
+#include <string>
+// internal
+#include "utilityString.h"
+
+namespace {
+std::string getLocationName(const TraceEvent& event) {
+  const char* fileName = event.fileName != nullptr ? event.fileName : "";
+  for(const char* c = fileName; *c != '\0'; c++) {
+    if(*c == '/' || *c == '\\') {
+      fileName = c + 1;
+    }
   }
-
-  return s_instance.get();
+  return std::string(fileName) + ":" + std::to_string(event.lineNumber);
 }
+}    // namespace
 
-std::shared_ptr<TraceEvent> Tracer::startEvent(const std::string& eventName) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+Tracer* Tracer::getInstance() {
+  static Tracer s_instance;
+  return &s_instance;
+}
 
-  const std::thread::id id = std::this_thread::get_id();
+uint32_t Tracer::startEvent() {
+  return getThreadBuffer().depth++;
+}
 
-  std::shared_ptr<TraceEvent> event = std::make_shared<TraceEvent>(eventName, s_nextTraceId++, m_startedEvents[id].size());
+void Tracer::finishEvent(const TraceEvent& event) {
+  ThreadBuffer& buffer = getThreadBuffer();
+  buffer.depth--;
 
-  m_events[id].push_back(event);
-  m_startedEvents[id].push(event.get());
+  const uint64_t writeCount = buffer.writeCount.load(std::memory_order_relaxed);
+  buffer.events[writeCount % EventsPerThread] = event;
+  buffer.writeCount.store(writeCount + 1, std::memory_order_release);
+}
 
-  return event;
+int64_t Tracer::getTime() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count();
 }
 
-void Tracer::finishEvent(std::shared_ptr<TraceEvent> /*event*/) {
-  std::lock_guard<std::mutex> lock(m_mutex);
+std::vector<std::pair<size_t, TraceEvent>> Tracer::getEvents() const {
+  std::vector<std::pair<size_t, TraceEvent>> events;
 
-  const std::thread::id id = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+  for(const std::unique_ptr<ThreadBuffer>& buffer : m_buffers) {
+    const uint64_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+    // the slot of the oldest event is the one the next event is written to
+    const uint64_t first = std::max(buffer->readStart, writeCount >= EventsPerThread ? writeCount - EventsPerThread + 1 : 0);
 
-  m_startedEvents[id].pop();
-}
+    const size_t threadStart = events.size();
+    for(uint64_t i = first; i < writeCount; i++) {
+      const TraceEvent event = buffer->events[i % EventsPerThread];
+      std::atomic_thread_fence(std::memory_order_acquire);
 
-void Tracer::printTraces() {
-  std::lock_guard<std::mutex> lock(m_mutex);
+      // the owning thread may have overwritten the slot while it was copied, it starts doing so as soon as it has
+      // published the event before
+      if(buffer->writeCount.load(std::memory_order_relaxed) >= i + EventsPerThread) {
+        continue;
+      }
+      events.emplace_back(buffer->threadIndex, event);
+    }
 
-  size_t unfinishEvents = 0;
-  for(auto& p : m_startedEvents) {
-    unfinishEvents += p.second.size();
+    std::sort(events.begin() + static_cast<std::ptrdiff_t>(threadStart), events.end(), [](const auto& a, const auto& b) {
+      return a.second.startTime < b.second.startTime ||
+          (a.second.startTime == b.second.startTime && a.second.depth < b.second.depth);
+    });
   }
+  return events;
+}
 
-  if(unfinishEvents > 0) {
-    std::cout << "TRACING: Trace events are still running." << std::endl;
-    return;
-  } else if(m_events.empty()) {
+void Tracer::printTraces() const {
+  const std::vector<std::pair<size_t, TraceEvent>> events = getEvents();
+  if(events.empty()) {
     std::cout << "TRACING: No trace events collected." << std::endl;
     return;
   }
 
-
   std::cout << "TRACING\n--------------------------\n" << std::endl;
 
   std::cout << "HISTORY:\n\n";
@@ -59,24 +90,24 @@ void Tracer::printTraces() {
   std::cout << "-----------------------------------------------------------------";
   std::cout << "------------------------------------------------------------\n";
 
-  for(auto& p : m_events) {
-    std::cout << "thread: " << p.first << std::endl;
-
-    for(const std::shared_ptr<TraceEvent>& event : p.second) {
-      std::cout.width(static_cast<long>(8 + 2 * event->depth));
-      std::cout << std::right << std::setprecision(3) << std::fixed << event->time;
+  size_t threadIndex = events.front().first + 1;
+  for(const auto& [eventThreadIndex, event] : events) {
+    if(eventThreadIndex != threadIndex) {
+      threadIndex = eventThreadIndex;
+      std::cout << "\nthread: " << threadIndex << std::endl;
+    }
 
-      std::cout.width(static_cast<long>(17 - 2 * event->depth));
-      std::cout << " ";
+    std::cout.width(static_cast<long>(8 + 2 * event.depth));
+    std::cout << std::right << std::setprecision(3) << std::fixed << static_cast<double>(event.duration) / 1e9;
 
-      std::cout.width(25);
-      std::cout << std::left << event->eventName;
+    std::cout.width(static_cast<long>(17 - 2 * std::min<uint32_t>(event.depth, 8)));
+    std::cout << " ";
 
-      std::cout.width(50);
-      std::cout << (event->functionName + "()") << event->locationName << std::endl;
-    }
+    std::cout.width(25);
+    std::cout << std::left << event.eventName;
 
-    std::cout << std::endl;
+    std::cout.width(50);
+    std::cout << (std::string(event.functionName) + "()") << getLocationName(event) << std::endl;
   }
 
   std::cout << "\nREPORT:\n\n";
@@ -86,29 +117,18 @@ void Tracer::printTraces() {
   std::cout << "------------------------------------------------------------\n";
 
   struct AccumulatedTraceEvent {
-    TraceEvent* event;
+    const TraceEvent* event;
     size_t count;
-    float time;
+    double time;
   };
 
   std::map<std::string, AccumulatedTraceEvent> accumulatedEvents;
+  for(const auto& [eventThreadIndex, event] : events) {
+    const std::string name = std::string(event.eventName) + event.functionName + getLocationName(event);
 
-  for(auto& p : m_events) {
-    for(const std::shared_ptr<TraceEvent>& event : p.second) {
-      const std::string name = event->eventName + event->functionName + event->locationName;
-
-      const auto& [iterator, flag] = accumulatedEvents.emplace(name, AccumulatedTraceEvent());
-
-      AccumulatedTraceEvent* acc = &iterator->second;
-      if(flag) {
-        acc->event = event.get();
-        acc->time = static_cast<float>(event->time);
-        acc->count = 1;
-      } else {
-        acc->time += static_cast<float>(event->time);
-        acc->count++;
-      }
-    }
+    const auto& [iterator, inserted] = accumulatedEvents.emplace(name, AccumulatedTraceEvent{&event, 0, 0.0});
+    iterator->second.count++;
+    iterator->second.time += static_cast<double>(event.duration) / 1e9;
   }
 
   std::multiset<AccumulatedTraceEvent, std::function<bool(const AccumulatedTraceEvent&, const AccumulatedTraceEvent&)>> sortedEvents(
@@ -129,103 +149,102 @@ void Tracer::printTraces() {
     std::cout << std::left << acc.event->eventName;
 
     std::cout.width(50);
-    std::cout << (acc.event->functionName + "()") << acc.event->locationName << std::endl;
+    std::cout << (std::string(acc.event->functionName) + "()") << getLocationName(*acc.event) << std::endl;
   }
 
   std::cout << std::endl;
-
-  m_events.clear();
 }
 
-Tracer::Tracer() {}
-
-
-std::shared_ptr<AccumulatingTracer> AccumulatingTracer::s_instance;
-Id AccumulatingTracer::s_nextTraceId = 0;
-
-AccumulatingTracer* AccumulatingTracer::getInstance() {
-  if(!s_instance) {
-    s_instance = std::shared_ptr<AccumulatingTracer>(new AccumulatingTracer());
+void Tracer::writeChromeTrace(std::ostream& stream) const {
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  bool first = true;
+  for(const auto& [threadIndex, event] : getEvents()) {
+    stream << (first ? "\n" : ",\n");
+    first = false;
+
+    // complete events, timestamps are in microseconds
+    stream << "{\"ph\":\"X\",\"cat\":\"sourcetrail\",\"pid\":1,\"tid\":" << threadIndex << ",\"name\":";
+    utility::writeJsonString(stream, event.eventName != nullptr ? event.eventName : "");
+    stream << std::fixed << std::setprecision(3) << ",\"ts\":" << static_cast<double>(event.startTime) / 1000.0
+           << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0 << ",\"args\":{\"function\":";
+    utility::writeJsonString(stream, event.functionName != nullptr ? event.functionName : "");
+    stream << ",\"location\":";
+    utility::writeJsonString(stream, getLocationName(event));
+    stream << "}}";
   }
 
-  return s_instance.get();
+  stream << "\n]}\n";
 }
 
-std::shared_ptr<TraceEvent> AccumulatingTracer::startEvent(const std::string& eventName) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  const std::thread::id id = std::this_thread::get_id();
-
-  std::shared_ptr<TraceEvent> event = std::make_shared<TraceEvent>(eventName, s_nextTraceId++, m_startedEvents[id].size());
-
-  m_startedEvents[id].push(event.get());
+bool Tracer::exportChromeTrace(const FilePath& filePath) const {
+  std::ofstream stream(filePath.str());
+  if(!stream) {
+    std::cout << "TRACING: Unable to write " << filePath.str() << std::endl;
+    return false;
+  }
 
-  return event;
+  writeChromeTrace(stream);
+  std::cout << "TRACING: Chrome trace written to " << filePath.str() << std::endl;
+  return static_cast<bool>(stream);
 }
 
-void AccumulatingTracer::finishEvent(std::shared_ptr<TraceEvent> event) {
-  std::lock_guard<std::mutex> lock(m_mutex);
-
-  const std::thread::id id = std::this_thread::get_id();
-
-  m_startedEvents[id].pop();
-
-  const std::string name = event->eventName + event->functionName + event->locationName;
-
-  std::pair<std::map<std::string, AccumulatedTraceEvent>::iterator, bool> p = m_accumulatedEvents.emplace(
-      name, AccumulatedTraceEvent());
-
-  AccumulatedTraceEvent* acc = &p.first->second;
-  if(p.second) {
-    acc->event = TraceEvent(*(event.get()));
-    acc->time = event->time;
-    acc->count = 1;
-  } else {
-    acc->time += event->time;
-    acc->count++;
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+  for(const std::unique_ptr<ThreadBuffer>& buffer : m_buffers) {
+    buffer->readStart = buffer->writeCount.load(std::memory_order_acquire);
   }
 }
 
-void AccumulatingTracer::printTraces() {
-  std::lock_guard<std::mutex> lock(m_mutex);
+Tracer::Tracer() : m_startTime(std::chrono::steady_clock::now()) {}
 
-  for(auto& p : m_startedEvents) {
-    if(!p.second.empty()) {
-      std::cout << "TRACING: Trace events are still running." << std::endl;
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+  // hands the buffer back when the thread exits, the tracer is a singleton so one buffer per thread is enough
+  struct ThreadBufferLease {
+    ~ThreadBufferLease() {
+      if(buffer != nullptr) {
+        Tracer::getInstance()->releaseThreadBuffer(buffer);
+      }
     }
-  }
-
-  std::cout << "\nREPORT:\n\n";
-  std::cout << "    time      count      name                     function";
-  std::cout << "                                          location\n";
-  std::cout << "-----------------------------------------------------------------";
-  std::cout << "------------------------------------------------------------\n";
 
-  using func = std::function<bool(const AccumulatedTraceEvent&, const AccumulatedTraceEvent&)>;
-  std::multiset<AccumulatedTraceEvent, func> sortedEvents(
-      [](const AccumulatedTraceEvent& a, const AccumulatedTraceEvent& b) { return a.time > b.time; });
+    ThreadBuffer* buffer = nullptr;
+  };
 
-  for(const auto& [text, event] : m_accumulatedEvents) {
-    sortedEvents.insert(event);
+  thread_local ThreadBufferLease t_lease;
+  if(t_lease.buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    if(m_freeBuffers.empty()) {
+      m_buffers.push_back(std::make_unique<ThreadBuffer>(m_buffers.size()));
+      t_lease.buffer = m_buffers.back().get();
+    } else {
+      t_lease.buffer = m_freeBuffers.back();
+      m_freeBuffers.pop_back();
+    }
   }
+  return *t_lease.buffer;
+}
 
-  for(const AccumulatedTraceEvent& acc : sortedEvents) {
-    std::cout.width(8);
-    std::cout << std::right << std::setprecision(3) << std::fixed << acc.time;
-
-    std::cout.width(10);
-    std::cout << acc.count << "       ";
-
-    std::cout.width(25);
-    std::cout << std::left << acc.event.eventName;
+void Tracer::releaseThreadBuffer(ThreadBuffer* buffer) {
+  // the recorded events stay readable until the next thread using the buffer overwrites them
+  std::lock_guard<std::mutex> lock(m_buffersMutex);
+  buffer->depth = 0;
+  m_freeBuffers.push_back(buffer);
+}
 
-    std::cout.width(50);
-    std::cout << (acc.event.functionName + "()") << acc.event.locationName << std::endl;
-  }
 
-  std::cout << std::endl;
+ScopedTrace::ScopedTrace(const char* eventName, const char* fileName, int lineNumber, const char* functionName) {
+  Tracer* tracer = Tracer::getInstance();
 
-  m_accumulatedEvents.clear();
+  m_event.eventName = eventName;
+  m_event.functionName = functionName;
+  m_event.fileName = fileName;
+  m_event.lineNumber = lineNumber;
+  m_event.depth = tracer->startEvent();
+  m_event.startTime = tracer->getTime();
 }
 
-AccumulatingTracer::AccumulatingTracer() = default;
\ No newline at end of file
+ScopedTrace::~ScopedTrace() {
+  Tracer* tracer = Tracer::getInstance();
+  m_event.duration = tracer->getTime() - m_event.startTime;
+  tracer->finishEvent(m_event);
+}
@@ -1,128 +1,106 @@
 #pragma once
 // STL
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <stack>
-#include <thread>
+#include <ostream>
+#include <vector>
 // internal
 #include "FilePath.h"
-#include "TimeStamp.h"
-#include "types.h"
-#include "utilityString.h"
 
 struct TraceEvent {
-public:
-  TraceEvent() = default;
-
-  TraceEvent(const std::string& eventName_, Id id_, size_t depth_) : eventName(eventName_), id(id_), depth(depth_), time(0.0) {}
-
-  std::string eventName = {};
-  Id id = 0;
-  size_t depth = 0;
-
-  std::string functionName;
-  std::string locationName;
-
-  double time = 0;
+  // names are string literals of the TRACE macro and outlive the tracer
+  const char* eventName = nullptr;
+  const char* functionName = nullptr;
+  const char* fileName = nullptr;
+  int lineNumber = 0;
+  uint32_t depth = 0;
+
+  // nanoseconds since the tracer was created
+  int64_t startTime = 0;
+  int64_t duration = 0;
 };
 
-
+/**
+ * Records finished trace events into a fixed size ring buffer per thread. Recording takes no lock: each thread only
+ * writes its own buffer and publishes the write position atomically, the oldest events are overwritten when the buffer
+ * is full. The mutex is only taken when a thread records its first event, when it exits and when traces are read. The
+ * buffer of an exited thread is reused by the next thread, so memory is bounded by the number of concurrent threads.
+ */
 class Tracer {
 public:
-  static Tracer* getInstance();
+  static constexpr size_t EventsPerThread = 16384;
 
-  std::shared_ptr<TraceEvent> startEvent(const std::string& eventName);
-  void finishEvent(std::shared_ptr<TraceEvent> event);
+  static Tracer* getInstance();
 
-  void printTraces();
+  // returns the nesting depth of the started event on the calling thread
+  uint32_t startEvent();
+  void finishEvent(const TraceEvent& event);
 
-private:
-  static std::shared_ptr<Tracer> s_instance;
-  static Id s_nextTraceId;
+  [[nodiscard]] int64_t getTime() const;
 
-  Tracer();
-  Tracer(const Tracer&) = delete;
-  void operator=(const Tracer&) = delete;
-
-  std::map<std::thread::id, std::vector<std::shared_ptr<TraceEvent>>> m_events;
-  std::map<std::thread::id, std::stack<TraceEvent*>> m_startedEvents;
+  // the recorded events of all threads, ordered by thread and start time
+  [[nodiscard]] std::vector<std::pair<size_t, TraceEvent>> getEvents() const;
 
-  std::mutex m_mutex;
-};
+  void printTraces() const;
 
+  // Chrome trace event format, opens in chrome://tracing and ui.perfetto.dev
+  void writeChromeTrace(std::ostream& stream) const;
+  bool exportChromeTrace(const FilePath& filePath) const;
 
-class AccumulatingTracer {
-public:
-  static AccumulatingTracer* getInstance();
+  // events recorded before are not read anymore
+  void clear();
 
-  std::shared_ptr<TraceEvent> startEvent(const std::string& eventName);
-  void finishEvent(std::shared_ptr<TraceEvent> event);
+private:
+  struct ThreadBuffer {
+    explicit ThreadBuffer(size_t threadIndex_) : threadIndex(threadIndex_), events(EventsPerThread) {}
 
-  void printTraces();
+    const size_t threadIndex;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> writeCount = 0;
+    uint32_t depth = 0;
 
-private:
-  struct AccumulatedTraceEvent {
-    TraceEvent event;
-    size_t count;
-    double time;
+    // guarded by m_buffersMutex
+    uint64_t readStart = 0;
   };
 
-  static std::shared_ptr<AccumulatingTracer> s_instance;
-  static Id s_nextTraceId;
+  Tracer();
+  Tracer(const Tracer&) = delete;
+  void operator=(const Tracer&) = delete;
 
-  AccumulatingTracer();
-  AccumulatingTracer(const AccumulatingTracer&) = delete;
-  void operator=(const AccumulatingTracer&) = delete;
+  ThreadBuffer& getThreadBuffer();
+  void releaseThreadBuffer(ThreadBuffer* buffer);
 
-  std::map<std::string, AccumulatedTraceEvent> m_accumulatedEvents;
-  std::map<std::thread::id, std::stack<TraceEvent*>> m_startedEvents;
+  const std::chrono::steady_clock::time_point m_startTime;
 
-  std::mutex m_mutex;
+  mutable std::mutex m_buffersMutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+  // buffers of exited threads
+  std::vector<ThreadBuffer*> m_freeBuffers;
 };
 
-
-template <typename TracerType>
 class ScopedTrace {
 public:
-  ScopedTrace(const std::string& eventName, const std::string& fileName, int lineNumber, const std::string& functionName);
+  ScopedTrace(const char* eventName, const char* fileName, int lineNumber, const char* functionName);
   ~ScopedTrace();
 
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
 private:
-  std::shared_ptr<TraceEvent> m_event;
-  TimeStamp m_timeStamp;
+  TraceEvent m_event;
 };
 
-template <typename TracerType>
-ScopedTrace<TracerType>::ScopedTrace(const std::string& eventName,
-                                     const std::string& fileName,
-                                     int lineNumber,
-                                     const std::string& functionName) {
-  m_event = TracerType::getInstance()->startEvent(eventName);
-  m_event->functionName = functionName;
-  m_event->locationName = utility::encodeToUtf8(FilePath(fileName).fileName()) + ":" + std::to_string(lineNumber);
-
-  m_timeStamp = TimeStamp::now();
-}
-
-template <typename TracerType>
-ScopedTrace<TracerType>::~ScopedTrace() {
-  m_event->time = TimeStamp::durationSeconds(m_timeStamp);
-  TracerType::getInstance()->finishEvent(m_event);
-}
-
 
 #ifdef TRACING_ENABLED
-#  ifdef USE_ACCUMULATED_TRACING
-#    define TRACE(__name__) ScopedTrace<AccumulatingTracer> __trace__(std::string(__name__), __FILE__, __LINE__, __FUNCTION__)
-
-#    define PRINT_TRACES() AccumulatingTracer::getInstance()->printTraces()
-#  else
-#    define TRACE(__name__) ScopedTrace<Tracer> __trace__(std::string(__name__), __FILE__, __LINE__, __FUNCTION__)
-
-#    define PRINT_TRACES() Tracer::getInstance()->printTraces()
-#  endif
-
+#  define TRACE(__name__) ScopedTrace __trace__(__name__, __FILE__, __LINE__, __FUNCTION__)
 
+#  define PRINT_TRACES() Tracer::getInstance()->printTraces()
+#  define EXPORT_TRACES(__filePath__) Tracer::getInstance()->exportChromeTrace(__filePath__)
 #else
 #  define TRACE(__name__)
 #  define PRINT_TRACES()
-#endif
\ No newline at end of file
+#  define EXPORT_TRACES(__filePath__)
+#endif
@@ -6,20 +6,13 @@
 CxxIndexerCommandProvider::CxxIndexerCommandProvider() : m_nextId(1) {}
 
 void CxxIndexerCommandProvider::addCommand(const std::shared_ptr<IndexerCommandCxx>& command) {
+  FilePathPool* pathPool = FilePathPool::getInstance();
   std::shared_ptr<CommandRepresentation> representation = std::make_shared<CommandRepresentation>();
 
-  {
-    for(const FilePath& indexedPath : command->getIndexedPaths()) {
-      std::map<FilePath, Id>::const_iterator it = m_indexedPathsToIds.find(indexedPath);
-      if(it != m_indexedPathsToIds.end()) {
-        representation->m_indexedPathIds.emplace(it->second);
-      } else {
-        const Id id = getId();
-        m_indexedPathsToIds[indexedPath] = id;
-        m_idsToIndexedPaths[id] = indexedPath;
-        representation->m_indexedPathIds.emplace(id);
-      }
-    }
+  for(const FilePath& indexedPath : command->getIndexedPaths()) {
+    const PathId id = pathPool->getId(indexedPath);
+    m_indexedPathIds.emplace(id);
+    representation->m_indexedPathIds.emplace(id);
   }
 
   {
@@ -50,18 +43,8 @@ void CxxIndexerCommandProvider::addCommand(const std::shared_ptr<IndexerCommandC
     }
   }
 
-  {
-    const FilePath workingDirectory = command->getWorkingDirectory();
-    std::map<FilePath, Id>::const_iterator it = m_workingDirectoriesToIds.find(workingDirectory);
-    if(it != m_workingDirectoriesToIds.end()) {
-      representation->m_workingDirectoryId = it->second;
-    } else {
-      const Id id = getId();
-      m_workingDirectoriesToIds[workingDirectory] = id;
-      m_idsToWorkingDirectories[id] = workingDirectory;
-      representation->m_workingDirectoryId = id;
-    }
-  }
+  representation->m_workingDirectoryId = pathPool->getId(command->getWorkingDirectory());
+  m_workingDirectoryIds.emplace(representation->m_workingDirectoryId);
 
   {
     const std::vector<std::wstring>& compilerFlags = command->getCompilerFlags();
@@ -79,16 +62,17 @@ void CxxIndexerCommandProvider::addCommand(const std::shared_ptr<IndexerCommandC
     }
   }
 
-  m_commands.emplace(command->getSourceFilePath(), representation);
+  m_commands.emplace(pathPool->getId(command->getSourceFilePath()), representation);
 }
 
 std::vector<FilePath> CxxIndexerCommandProvider::getAllSourceFilePaths() const {
+  const FilePathPool* pathPool = FilePathPool::getInstance();
+
   std::vector<FilePath> paths;
   paths.reserve(m_commands.size());
 
-  for(std::map<FilePath, std::shared_ptr<CommandRepresentation>>::const_iterator it = m_commands.begin(); it != m_commands.end();
-      it++) {
-    paths.emplace_back(it->first);
+  for(const auto& [sourceFilePathId, representation] : m_commands) {
+    paths.emplace_back(pathPool->getFilePath(sourceFilePathId));
   }
 
   return paths;
@@ -96,7 +80,7 @@ std::vector<FilePath> CxxIndexerCommandProvider::getAllSourceFilePaths() const {
 
 std::shared_ptr<IndexerCommand> CxxIndexerCommandProvider::consumeCommand() {
   if(!m_commands.empty()) {
-    std::map<FilePath, std::shared_ptr<CommandRepresentation>>::const_iterator it = m_commands.begin();
+    auto it = m_commands.begin();
     if(it->second) {
       std::shared_ptr<IndexerCommand> command = representationToCommand(it->first, it->second);
       m_commands.erase(it);
@@ -107,7 +91,7 @@ std::shared_ptr<IndexerCommand> CxxIndexerCommandProvider::consumeCommand() {
 }
 
 std::shared_ptr<IndexerCommand> CxxIndexerCommandProvider::consumeCommandForSourceFilePath(const FilePath& filePath) {
-  std::map<FilePath, std::shared_ptr<CommandRepresentation>>::const_iterator it = m_commands.find(filePath);
+  auto it = m_commands.find(FilePathPool::getInstance()->getId(filePath));
   if(it != m_commands.end() && it->second) {
     std::shared_ptr<IndexerCommand> command = representationToCommand(it->first, it->second);
     m_commands.erase(it);
@@ -119,9 +103,8 @@ std::shared_ptr<IndexerCommand> CxxIndexerCommandProvider::consumeCommandForSour
 std::vector<std::shared_ptr<IndexerCommand>> CxxIndexerCommandProvider::consumeAllCommands() {
   std::vector<std::shared_ptr<IndexerCommand>> commands;
   commands.reserve(m_commands.size());
-  for(std::map<FilePath, std::shared_ptr<CommandRepresentation>>::const_iterator it = m_commands.begin(); it != m_commands.end();
-      it++) {
-    commands.emplace_back(representationToCommand(it->first, it->second));
+  for(const auto& [sourceFilePathId, representation] : m_commands) {
+    commands.emplace_back(representationToCommand(sourceFilePathId, representation));
   }
   m_commands.clear();
   return commands;
@@ -137,10 +120,10 @@ size_t CxxIndexerCommandProvider::size() const {
 
 void CxxIndexerCommandProvider::logStats() const {
   LOG_INFO("CxxIndexerCommandProvider stats:");
-  LOG_INFO("\tindexed path count: " + std::to_string(m_idsToIndexedPaths.size()));
+  LOG_INFO("\tindexed path count: " + std::to_string(m_indexedPathIds.size()));
   LOG_INFO("\texclude filter count: " + std::to_string(m_idsToExcludeFilters.size()));
   LOG_INFO("\tinclude filter count: " + std::to_string(m_idsToIncludeFilters.size()));
-  LOG_INFO("\tworking directory count: " + std::to_string(m_idsToWorkingDirectories.size()));
+  LOG_INFO("\tworking directory count: " + std::to_string(m_workingDirectoryIds.size()));
   LOG_INFO("\tcompiler flag count: " + std::to_string(m_idsToCompilerFlags.size()));
 }
 
@@ -149,10 +132,12 @@ Id CxxIndexerCommandProvider::getId() {
 }
 
 std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::representationToCommand(
-    const FilePath& sourceFilePath, std::shared_ptr<CommandRepresentation> representation) {
+    PathId sourceFilePathId, std::shared_ptr<CommandRepresentation> representation) {
+  const FilePathPool* pathPool = FilePathPool::getInstance();
+
   std::set<FilePath> indexedPaths;
-  for(const Id id : representation->m_indexedPathIds) {
-    indexedPaths.insert(m_idsToIndexedPaths[id]);
+  for(const PathId id : representation->m_indexedPathIds) {
+    indexedPaths.insert(pathPool->getFilePath(id));
   }
 
   std::set<FilePathFilter> excludeFilters;
@@ -165,7 +150,7 @@ std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::representationToCo
     includeFilters.insert(FilePathFilter(m_idsToIncludeFilters[id]));
   }
 
-  FilePath workingDirectory = m_idsToWorkingDirectories[representation->m_workingDirectoryId];
+  FilePath workingDirectory = pathPool->getFilePath(representation->m_workingDirectoryId);
 
   std::vector<std::wstring> compilerFlags;
   for(const Id id : representation->m_compilerFlagIds) {
@@ -173,5 +158,5 @@ std::shared_ptr<IndexerCommandCxx> CxxIndexerCommandProvider::representationToCo
   }
 
   return std::make_shared<IndexerCommandCxx>(
-      sourceFilePath, indexedPaths, excludeFilters, includeFilters, workingDirectory, compilerFlags);
+      pathPool->getFilePath(sourceFilePathId), indexedPaths, excludeFilters, includeFilters, workingDirectory, compilerFlags);
 }
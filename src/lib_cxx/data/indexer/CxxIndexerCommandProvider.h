@@ -7,6 +7,7 @@
 
 #include <unordered_map>
 
+#include "FilePathPool.h"
 #include "IndexerCommandProvider.h"
 #include "types.h"
 
@@ -25,30 +26,30 @@ public:
   void logStats() const;
 
 private:
+  // paths are stored as ids of the FilePathPool, filters and flags as ids of this provider
   struct CommandRepresentation {
-    std::set<Id> m_indexedPathIds;
+    std::set<PathId> m_indexedPathIds;
     std::set<Id> m_excludeFilterIds;
     std::set<Id> m_includeFilterIds;
-    Id m_workingDirectoryId;
+    PathId m_workingDirectoryId;
     std::vector<Id> m_compilerFlagIds;
   };
 
   Id getId();
-  std::shared_ptr<IndexerCommandCxx> representationToCommand(const FilePath& sourceFilePath,
+  std::shared_ptr<IndexerCommandCxx> representationToCommand(PathId sourceFilePathId,
                                                              std::shared_ptr<CommandRepresentation> representation);
 
   Id m_nextId;
 
-  std::multimap<FilePath, std::shared_ptr<CommandRepresentation>> m_commands;
+  // ordered by path id, so commands are consumed in the order their source files were first seen
+  std::multimap<PathId, std::shared_ptr<CommandRepresentation>> m_commands;
 
-  std::map<Id, FilePath> m_idsToIndexedPaths;
-  std::map<FilePath, Id> m_indexedPathsToIds;
+  std::set<PathId> m_indexedPathIds;
   std::map<Id, std::wstring> m_idsToExcludeFilters;
   std::map<std::wstring, Id> m_excludeFiltersToIds;
   std::map<Id, std::wstring> m_idsToIncludeFilters;
   std::map<std::wstring, Id> m_includeFiltersToIds;
-  std::map<Id, FilePath> m_idsToWorkingDirectories;
-  std::map<FilePath, Id> m_workingDirectoriesToIds;
+  std::set<PathId> m_workingDirectoryIds;
   std::map<Id, std::wstring> m_idsToCompilerFlags;
   std::unordered_map<std::wstring, Id> m_compilerFlagsToIds;
 };
@@ -76,7 +76,7 @@ QtCodeField::QtCodeField(size_t startLineNumber,
   createAnnotations(locationFile);
 
   m_highlighter = std::make_shared<QtHighlighter>(document(), locationFile->getLanguage());
-  m_highlighter->highlightDocument();
+  m_highlighter->prepareDocument();
 
   IApplicationSettings* appSettings = IApplicationSettings::getInstanceRaw();
   QFont font(appSettings->getFontName().c_str());
@@ -171,6 +171,11 @@ void QtCodeField::paintEvent(QPaintEvent* event) {
     bottom = top + static_cast<int>(blockBoundingRect(block).height());
   }
 
+  if(!m_isHighlighted) {
+    m_highlighter->highlightDocument();
+    m_isHighlighted = true;
+  }
+
   m_highlighter->rehighlightLines(m_linesToRehighlight);
   m_linesToRehighlight.clear();
 
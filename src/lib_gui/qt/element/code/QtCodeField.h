@@ -135,6 +135,8 @@ private:
   std::shared_ptr<SourceLocationFile> m_locationFile;
 
   std::shared_ptr<QtHighlighter> m_highlighter;
+  // the document is highlighted on first paint, snippets that are never scrolled into view skip it
+  bool m_isHighlighted = false;
 
   std::vector<int> m_lineLengths;
   std::vector<std::vector<std::pair<int, int>>> m_multibyteCharacterLocations;
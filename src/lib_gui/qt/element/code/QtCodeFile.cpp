@@ -8,6 +8,7 @@
 #include "QtCodeSnippet.h"
 #include "SourceLocationFile.h"
 #include "type/code/MessageChangeFileView.h"
+#include "type/code/MessageLoadCodeSnippets.h"
 
 QtCodeFile::QtCodeFile(const FilePath& filePath, QtCodeNavigator* navigator, bool isFirst)
     : QFrame(), m_navigator(navigator), m_filePath(filePath), m_isWholeFile(false) {
@@ -209,6 +210,23 @@ bool QtCodeFile::hasSnippets() const {
   return m_snippets.size() > 0;
 }
 
+void QtCodeFile::setUnloadedSnippetCount(size_t unloadedSnippetCount) {
+  m_unloadedSnippetCount = unloadedSnippetCount;
+  m_requestedUnloadedSnippets = false;
+}
+
+void QtCodeFile::requestUnloadedSnippets() {
+  if(!m_unloadedSnippetCount || m_requestedUnloadedSnippets || isCollapsed()) {
+    return;
+  }
+
+  m_requestedUnloadedSnippets = true;
+
+  MessageLoadCodeSnippets msg(m_filePath);
+  msg.setSchedulerId(m_navigator->getSchedulerId());
+  msg.dispatch();
+}
+
 void QtCodeFile::clearSnippets() {
   for(QtCodeSnippet* snippet : m_snippets) {
     m_snippetLayout->removeWidget(snippet);
@@ -56,6 +56,9 @@ public:
   void setSnippets();
 
   bool hasSnippets() const;
+  // snippets of the file that are not loaded yet are requested once the end of the loaded ones comes into view
+  void setUnloadedSnippetCount(size_t unloadedSnippetCount);
+  void requestUnloadedSnippets();
   void clearSnippets();
   void updateSnippets();
   void updateTitleBar();
@@ -87,6 +90,9 @@ private:
 
   const FilePath m_filePath;
   bool m_isWholeFile;
+
+  size_t m_unloadedSnippetCount = 0;
+  bool m_requestedUnloadedSnippets = false;
 };
 
 #endif    // QT_CODE_FILE_H
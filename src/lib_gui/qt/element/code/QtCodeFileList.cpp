@@ -122,40 +122,38 @@ void QtCodeFileList::addFile(const CodeFileParams& params) {
 
   if(params.isMinimized) {
     file->setMinimized();
+    file->setUnloadedSnippetCount(0);
   } else {
-    bool same = true;
+    // the shown snippets are kept when only further ones of the file were loaded
     const std::vector<QtCodeSnippet*> snippets = file->getSnippets();
-    if(params.snippetParams.size() != snippets.size()) {
-      same = false;
-    } else {
-      for(size_t i = 0; i < snippets.size(); i++) {
-        if(params.snippetParams[i].startLineNumber != snippets[i]->getStartLineNumber() ||
-           params.snippetParams[i].endLineNumber != snippets[i]->getEndLineNumber()) {
-          same = false;
-          break;
-        }
-      }
+    size_t keptSnippetCount = 0;
+    while(keptSnippetCount < snippets.size() && keptSnippetCount < params.snippetParams.size() &&
+          params.snippetParams[keptSnippetCount].startLineNumber == snippets[keptSnippetCount]->getStartLineNumber() &&
+          params.snippetParams[keptSnippetCount].endLineNumber == snippets[keptSnippetCount]->getEndLineNumber()) {
+      keptSnippetCount++;
     }
 
-    if(!same) {
-      Id focusedLocationId = 0;
+    Id focusedLocationId = 0;
+    if(keptSnippetCount < snippets.size()) {
       const CodeFocusHandler::Focus& currentFocus = m_navigator->getCurrentFocus();
       if(currentFocus.area && file->getFilePath() == currentFocus.area->getSourceLocationFile()->getFilePath()) {
         focusedLocationId = currentFocus.locationId;
       }
 
       file->clearSnippets();
+      keptSnippetCount = 0;
+    }
 
-      for(const CodeSnippetParams& snippetParams : params.snippetParams) {
-        file->addCodeSnippet(snippetParams);
-      }
+    for(size_t i = keptSnippetCount; i < params.snippetParams.size(); i++) {
+      file->addCodeSnippet(params.snippetParams[i]);
+    }
 
-      if(focusedLocationId) {
-        file->setFocus(focusedLocationId);
-      }
+    if(focusedLocationId) {
+      file->setFocus(focusedLocationId);
     }
 
     file->setSnippets();
+    file->setUnloadedSnippetCount(params.unloadedSnippetCount);
   }
 }
 
@@ -355,6 +353,12 @@ void QtCodeFileList::updateSnippetTitleAndScrollBar(int /*value*/) {
       fileTitleBarOffset = std::min(0, fileRect.bottom() + 1 - (visibleRect.top() + m_firstSnippetTitleBar->height()));
     }
 
+    // load further snippets before the end of the loaded ones is scrolled into view
+    if(file->isVisible() && fileRect.bottom() > visibleRect.top() &&
+       fileRect.bottom() < visibleRect.bottom() + visibleRect.height()) {
+      file->requestUnloadedSnippets();
+    }
+
     if(visibleRect.bottom() > fileRect.top() && fileRect.bottom() > visibleRect.bottom()) {
       for(QtCodeSnippet* snippet : file->getVisibleSnippets()) {
         QScrollBar* scrollbar = snippet->getArea()->horizontalScrollBar();
@@ -3,11 +3,14 @@
 #include <QApplication>
 #include <QClipboard>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QMouseEvent>
+#include <QPainter>
 #include <QParallelAnimationGroup>
 #include <QPropertyAnimation>
 #include <QScrollBar>
 #include <QSvgGenerator>
+#include <QThread>
 #include <QTimer>
 
 #include "GraphFocusHandler.h"
@@ -159,7 +162,6 @@ void QtGraphicsView::setAppZoomFactor(float appZoomFactor) {
 void QtGraphicsView::setSceneRect(const QRectF& rect) {
   QGraphicsView::setSceneRect(rect);
   scene()->setSceneRect(rect);
-  m_imageCached = toQImage();
   m_tabId = TabId::currentTab();
 }
 
@@ -468,6 +470,14 @@ void QtGraphicsView::keyPressEvent(QKeyEvent* event) {
     setZoomFactor(1.0F);
     updateTransform();
     break;
+  case Qt::Key_F:
+    if(!ctrl || !shift || alt) {
+      QGraphicsView::keyPressEvent(event);
+      return;
+    }
+    m_showsFrameTime = !m_showsFrameTime;
+    viewport()->update();
+    break;
   case Qt::Key_Shift:
     m_shift = true;
     break;
@@ -529,6 +539,39 @@ void QtGraphicsView::focusOutEvent(QFocusEvent* /*event*/) {
   emit focusOut();
 }
 
+void QtGraphicsView::paintEvent(QPaintEvent* event) {
+  if(!m_showsFrameTime) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QGraphicsView::paintEvent(event);
+
+  m_frameTimeMs = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
+  m_averageFrameTimeMs = 0.9 * m_averageFrameTimeMs + 0.1 * m_frameTimeMs;
+}
+
+void QtGraphicsView::drawForeground(QPainter* painter, const QRectF& /*rect*/) {
+  if(!m_showsFrameTime) {
+    return;
+  }
+
+  const QString text = QStringLiteral("frame %1 ms, average %2 ms, %3 items, zoom %4%")
+                           .arg(m_frameTimeMs, 0, 'f', 1)
+                           .arg(m_averageFrameTimeMs, 0, 'f', 1)
+                           .arg(scene()->items().size())
+                           .arg(static_cast<int>(getZoomFactor() * 100));
+
+  painter->save();
+  painter->resetTransform();
+  painter->setPen(Qt::gray);
+  painter->drawText(QPointF(8, 20), text);
+  painter->restore();
+}
+
 void QtGraphicsView::updateTimer() {
   const int ds = 30;
   const float dz = 50.0f;
@@ -724,7 +767,25 @@ void QtGraphicsView::updateTransform() {
 }
 
 void QtGraphicsView::handleMessage(MessageSaveAsImage* pMessage) {
-  if((pMessage->getSchedulerId() == getSchedulerId()) && !m_imageCached.isNull()) {
-    m_imageCached.save(pMessage->path);
+  if(pMessage->getSchedulerId() != getSchedulerId()) {
+    return;
+  }
+
+  // rendering the whole scene is expensive for large graphs, so it only happens when an image is requested
+  QImage image;
+  auto render = [this, &image]() {
+    if(!scene()->items().isEmpty()) {
+      image = toQImage();
+    }
+  };
+
+  if(QThread::currentThread() == thread()) {
+    render();
+  } else {
+    QMetaObject::invokeMethod(this, render, Qt::BlockingQueuedConnection);
+  }
+
+  if(!image.isNull()) {
+    image.save(pMessage->path);
   }
 }
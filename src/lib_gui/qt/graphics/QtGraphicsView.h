@@ -69,6 +69,13 @@ protected:
   void focusInEvent(QFocusEvent* event) override;
   void focusOutEvent(QFocusEvent* event) override;
 
+  /**
+   * @name frame time overlay, toggled with Ctrl + Shift + F
+   * @{ */
+  void paintEvent(QPaintEvent* event) override;
+  void drawForeground(QPainter* painter, const QRectF& rect) override;
+  /**  @} */
+
 signals:
   void emptySpaceClicked();
   void resized();
@@ -166,6 +173,9 @@ private:
   float m_zoomInButtonSpeed = 20.0F;
   float m_zoomOutButtonSpeed = -20.0F;
 
-  QImage m_imageCached;
+  bool m_showsFrameTime = false;
+  double m_frameTimeMs = 0.0;
+  double m_averageFrameTimeMs = 0.0;
+
   Id m_tabId;
 };
@@ -0,0 +1,20 @@
+#include "QtDetailTextItem.h"
+
+#include "utilityQt.h"
+
+namespace {
+// text of the default font size is a few pixels high at this scale
+constexpr double MIN_LEVEL_OF_DETAIL_FOR_TEXT = 0.4;
+}    // namespace
+
+QtDetailTextItem::QtDetailTextItem(QGraphicsItem* parent) : QGraphicsSimpleTextItem(parent) {}
+
+QtDetailTextItem::~QtDetailTextItem() {}
+
+void QtDetailTextItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget) {
+  if(utility::getLevelOfDetail(painter) < MIN_LEVEL_OF_DETAIL_FOR_TEXT) {
+    return;
+  }
+
+  QGraphicsSimpleTextItem::paint(painter, options, widget);
+}
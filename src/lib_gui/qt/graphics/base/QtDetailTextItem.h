@@ -0,0 +1,17 @@
+#ifndef QT_DETAIL_TEXT_ITEM_H
+#define QT_DETAIL_TEXT_ITEM_H
+
+#include <QGraphicsSimpleTextItem>
+
+/**
+ * Text that is only drawn while it is large enough to be read, zoomed out graphs show their nodes as plain boxes.
+ */
+class QtDetailTextItem : public QGraphicsSimpleTextItem {
+public:
+  QtDetailTextItem(QGraphicsItem* parent);
+  virtual ~QtDetailTextItem();
+
+  virtual void paint(QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* widget);
+};
+
+#endif    // QT_DETAIL_TEXT_ITEM_H
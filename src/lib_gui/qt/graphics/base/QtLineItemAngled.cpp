@@ -12,27 +12,35 @@ QtLineItemAngled::QtLineItemAngled(QGraphicsItem* parent) : QtLineItemBase(paren
 QtLineItemAngled::~QtLineItemAngled() {}
 
 QPainterPath QtLineItemAngled::shape() const {
-  QPainterPath path;
-  path.setFillRule(Qt::WindingFill);
+  if(!m_shape.isEmpty()) {
+    return m_shape;
+  }
+
+  m_shape.setFillRule(Qt::WindingFill);
 
   QPolygon poly = getPath();
 
   for(int i = 0; i < poly.size() - 1; i++) {
-    path.addRect(QRectF(poly.at(i), poly.at(i + 1)).normalized().adjusted(-5, -5, 5, 5));
+    m_shape.addRect(QRectF(poly.at(i), poly.at(i + 1)).normalized().adjusted(-5, -5, 5, 5));
   }
 
-  path.addRect(getArrowBoundingRect(poly).adjusted(-3, -3, 3, 3));
+  m_shape.addRect(getArrowBoundingRect(poly).adjusted(-3, -3, 3, 3));
 
-  return path;
+  return m_shape;
 }
 
 void QtLineItemAngled::paint(QPainter* painter, const QStyleOptionGraphicsItem* options, QWidget* /*widget*/) {
   QPen p = pen();
   painter->setPen(p);
 
-  QPainterPath path;
-
   QPolygon poly = getPath();
+
+  if(isDrawnSimplified(painter)) {
+    painter->drawPolyline(poly);
+    return;
+  }
+
+  QPainterPath path;
   int i = poly.length() - 1;
 
   path.moveTo(poly.at(i));
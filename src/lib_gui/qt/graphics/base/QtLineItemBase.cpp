@@ -4,6 +4,12 @@
 #include <QCursor>
 #include <QPen>
 
+#include "utilityQt.h"
+
+namespace {
+constexpr double MIN_LEVEL_OF_DETAIL_FOR_EDGES = 0.3;
+}    // namespace
+
 QtLineItemBase::QtLineItemBase(QGraphicsItem* parent)
     : QGraphicsLineItem(parent), m_showArrow(true), m_onFront(false), m_onBack(false), m_earlyBend(false), m_route(ROUTE_ANY) {
   this->setAcceptHoverEvents(true);
@@ -21,6 +27,8 @@ void QtLineItemBase::updateLine(const Vec4i& ownerRect,
                                 bool showArrow) {
   prepareGeometryChange();
   m_polygon.clear();
+  m_shape = QPainterPath();
+  m_curve = QPainterPath();
 
   m_ownerRect = ownerRect;
   m_targetRect = targetRect;
@@ -57,6 +65,10 @@ void QtLineItemBase::setEarlyBend(bool earlyBend) {
   m_earlyBend = earlyBend;
 }
 
+bool QtLineItemBase::isDrawnSimplified(const QPainter* painter) {
+  return utility::getLevelOfDetail(painter) < MIN_LEVEL_OF_DETAIL_FOR_EDGES;
+}
+
 QPolygon QtLineItemBase::getPath() const {
   if(m_polygon.size() > 0) {
     return m_polygon;
@@ -2,6 +2,7 @@
 #define QT_LINE_ITEM_BASE_H
 
 #include <QGraphicsItem>
+#include <QPainterPath>
 
 #include "GraphViewStyle.h"
 #include "Vector4.h"
@@ -36,6 +37,9 @@ protected:
 
   void getPivotPoints(Vec2f* p, const Vec4i& in, const Vec4i& out, int offset, bool target) const;
 
+  // zoomed out far, edges are drawn without rounded corners and arrows
+  static bool isDrawnSimplified(const QPainter* painter);
+
   GraphViewStyle::EdgeStyle m_style;
   bool m_showArrow;
 
@@ -45,6 +49,10 @@ protected:
 
   Route m_route;
 
+  // hit test shape and drawn curve of the line, computed on first use and cleared by updateLine()
+  mutable QPainterPath m_shape;
+  mutable QPainterPath m_curve;
+
 private:
   Vec4i m_ownerRect;
   Vec4i m_targetRect;
@@ -7,25 +7,35 @@ QtLineItemBezier::QtLineItemBezier(QGraphicsItem* parent) : QtLineItemBase(paren
 QtLineItemBezier::~QtLineItemBezier() {}
 
 QPainterPath QtLineItemBezier::shape() const {
+  if(!m_shape.isEmpty()) {
+    return m_shape;
+  }
+
   QPainterPathStroker stroker;
   stroker.setWidth(10);
   stroker.setJoinStyle(Qt::MiterJoin);
 
-  QPainterPath path = stroker.createStroke(getCurve());
+  m_shape = stroker.createStroke(getCurve());
   if(m_showArrow) {
-    path.addRect(getArrowBoundingRect(QtLineItemBase::getPath()).adjusted(-3, -3, 3, 3));
+    m_shape.addRect(getArrowBoundingRect(QtLineItemBase::getPath()).adjusted(-3, -3, 3, 3));
   }
-  return path;
+  return m_shape;
 }
 
 void QtLineItemBezier::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*options*/, QWidget* /*widget*/) {
+  painter->setPen(pen());
+
+  if(isDrawnSimplified(painter)) {
+    painter->drawPath(getCurve());
+    return;
+  }
+
   QPainterPath path = getCurve();
 
   if(m_showArrow) {
     drawArrow(QtLineItemBase::getPath(), &path);
   }
 
-  painter->setPen(pen());
   painter->drawPath(path);
 }
 
@@ -95,6 +105,10 @@ QPolygon QtLineItemBezier::getPath() const {
 }
 
 QPainterPath QtLineItemBezier::getCurve() const {
+  if(!m_curve.isEmpty()) {
+    return m_curve;
+  }
+
   QPolygon poly = getPath();
 
   QPainterPath path;
@@ -107,5 +121,6 @@ QPainterPath QtLineItemBezier::getCurve() const {
   // path.lineTo(poly.at(1));
   // path.lineTo(poly.at(0));
 
-  return path;
+  m_curve = path;
+  return m_curve;
 }
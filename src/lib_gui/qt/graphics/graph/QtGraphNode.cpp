@@ -8,6 +8,7 @@
 #include <QPen>
 
 #include "GraphFocusHandler.h"
+#include "QtDetailTextItem.h"
 #include "QtDeviceScaledPixmap.h"
 #include "QtGraphEdge.h"
 #include "QtGraphNodeComponent.h"
@@ -55,7 +56,7 @@ QtGraphNode::QtGraphNode(GraphFocusHandler* focusHandler) : m_focusHandler(focus
   this->setPen(QPen(Qt::transparent));
   this->setCursor(Qt::PointingHandCursor);
 
-  m_text = new QGraphicsSimpleTextItem(this);
+  m_text = new QtDetailTextItem(this);
   m_rect = new QtRoundedRectItem(this);
   m_undefinedRect = new QtRoundedRectItem(this);
   m_undefinedRect->hide();
@@ -0,0 +1,126 @@
+#include "QtDaemonController.h"
+// Qt5
+#include <QLocalServer>
+#include <QLocalSocket>
+// internal
+#include "logging.h"
+
+namespace {
+// a client sending more than this without a line break is disconnected
+constexpr int MaxRequestSize = 1024 * 1024;
+constexpr int ProbeTimeoutMs = 100;
+}    // namespace
+
+QtDaemonController::QtDaemonController(StorageAccess* storageAccess) : DaemonController(storageAccess) {}
+
+QtDaemonController::~QtDaemonController() {
+  stopListening();
+}
+
+bool QtDaemonController::startListening(const FilePath& socketPath) {
+  const QString serverName = QString::fromStdWString(socketPath.wstr());
+
+  {
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if(probe.waitForConnected(ProbeTimeoutMs)) {
+      LOG_ERROR("Another daemon is already listening on " + socketPath.str());
+      return false;
+    }
+  }
+
+  // the socket file of a daemon that did not shut down cleanly
+  QLocalServer::removeServer(serverName);
+
+  m_server = std::make_unique<QLocalServer>();
+  m_server->setSocketOptions(QLocalServer::UserAccessOption);
+  if(!m_server->listen(serverName)) {
+    LOG_ERROR("Unable to listen on " + socketPath.str() + ": " + m_server->errorString().toStdString());
+    m_server.reset();
+    return false;
+  }
+
+  QObject::connect(m_server.get(), &QLocalServer::newConnection, [this]() { acceptConnections(); });
+
+  LOG_INFO("Listening for requests on " + socketPath.str());
+  return true;
+}
+
+void QtDaemonController::stopListening() {
+  for(auto& [clientId, client] : m_clients) {
+    QObject::disconnect(client.socket, nullptr, nullptr, nullptr);
+    client.socket->flush();
+    client.socket->disconnectFromServer();
+  }
+  m_clients.clear();
+
+  if(m_server) {
+    m_server->close();
+    m_server.reset();
+  }
+}
+
+bool QtDaemonController::isListening() const {
+  return m_server && m_server->isListening();
+}
+
+void QtDaemonController::sendResponse(ClientId clientId, const std::string& response) {
+  m_onQtThread([this, clientId, response]() {
+    auto it = m_clients.find(clientId);
+    if(it != m_clients.end()) {
+      it->second.socket->write(response.data(), static_cast<qint64>(response.size()));
+      it->second.socket->flush();
+    }
+  });
+}
+
+void QtDaemonController::sendEvent(const std::string& event) {
+  m_onQtThread([this, event]() {
+    for(auto& [clientId, client] : m_clients) {
+      client.socket->write(event.data(), static_cast<qint64>(event.size()));
+    }
+  });
+}
+
+void QtDaemonController::acceptConnections() {
+  while(QLocalSocket* socket = m_server->nextPendingConnection()) {
+    const ClientId clientId = m_nextClientId++;
+    m_clients[clientId].socket = socket;
+
+    QObject::connect(socket, &QLocalSocket::readyRead, [this, clientId]() { readRequests(clientId); });
+    QObject::connect(socket, &QLocalSocket::disconnected, [this, clientId, socket]() {
+      m_clients.erase(clientId);
+      socket->deleteLater();
+    });
+  }
+}
+
+void QtDaemonController::readRequests(ClientId clientId) {
+  auto it = m_clients.find(clientId);
+  if(it == m_clients.end()) {
+    return;
+  }
+
+  Client& client = it->second;
+  client.receivedData += client.socket->readAll();
+
+  int lineEnd = 0;
+  while((lineEnd = client.receivedData.indexOf('\n')) >= 0) {
+    const QByteArray request = client.receivedData.left(lineEnd).trimmed();
+    client.receivedData.remove(0, lineEnd + 1);
+
+    if(!request.isEmpty()) {
+      handleRequest(clientId, request.toStdString());
+    }
+
+    if(m_clients.find(clientId) == m_clients.end()) {
+      // the request disconnected the client, e.g. by shutting down
+      return;
+    }
+  }
+
+  if(client.receivedData.size() > MaxRequestSize) {
+    LOG_WARNING("Disconnecting daemon client that sent a request without line break");
+    client.socket->disconnectFromServer();
+  }
+}
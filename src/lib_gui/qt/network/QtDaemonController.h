@@ -0,0 +1,44 @@
+#pragma once
+// STL
+#include <map>
+#include <memory>
+// Qt5
+#include <QByteArray>
+// internal
+#include "DaemonController.h"
+#include "QtThreadedFunctor.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+// Listens on a Unix domain socket, or a named pipe on Windows, and splits the received data into request lines.
+class QtDaemonController final : public DaemonController {
+public:
+  explicit QtDaemonController(StorageAccess* storageAccess);
+  ~QtDaemonController() override;
+
+  QtDaemonController(const QtDaemonController&) = delete;
+  QtDaemonController& operator=(const QtDaemonController&) = delete;
+
+  bool startListening(const FilePath& socketPath) override;
+  void stopListening() override;
+  [[nodiscard]] bool isListening() const override;
+
+private:
+  struct Client {
+    QLocalSocket* socket = nullptr;
+    QByteArray receivedData;
+  };
+
+  void sendResponse(ClientId clientId, const std::string& response) override;
+  void sendEvent(const std::string& event) override;
+
+  void acceptConnections();
+  void readRequests(ClientId clientId);
+
+  std::unique_ptr<QLocalServer> m_server;
+  std::map<ClientId, Client> m_clients;
+  ClientId m_nextClientId = 1;
+
+  QtThreadedLambdaFunctor m_onQtThread;
+};
@@ -1,5 +1,6 @@
 #include "QtNetworkFactory.h"
 
+#include "QtDaemonController.h"
 #include "QtIDECommunicationController.h"
 
 QtNetworkFactory::~QtNetworkFactory() = default;
@@ -7,3 +8,7 @@ QtNetworkFactory::~QtNetworkFactory() = default;
 std::shared_ptr<IDECommunicationController> QtNetworkFactory::createIDECommunicationController(StorageAccess* storageAccess) const {
   return std::make_shared<QtIDECommunicationController>(nullptr, storageAccess);
 }
+
+std::shared_ptr<DaemonController> QtNetworkFactory::createDaemonController(StorageAccess* storageAccess) const {
+  return std::make_shared<QtDaemonController>(storageAccess);
+}
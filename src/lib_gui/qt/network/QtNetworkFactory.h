@@ -7,4 +7,6 @@ public:
   ~QtNetworkFactory() override;
 
   std::shared_ptr<IDECommunicationController> createIDECommunicationController(StorageAccess* storageAccess) const override;
+
+  std::shared_ptr<DaemonController> createDaemonController(StorageAccess* storageAccess) const override;
 };
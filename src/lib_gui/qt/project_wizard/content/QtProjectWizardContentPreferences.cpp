@@ -274,6 +274,16 @@ void QtProjectWizardContentPreferences::populate(QGridLayout* layout, int& row)
       layout,
       row);
 
+  // file watching
+  m_watchSourceFiles = addCheckBox(
+      QStringLiteral("Watch Source Files"),
+      QStringLiteral("Re-index changed files in the background"),
+      QStringLiteral("<p>Watch the directories of the indexed files while a project is open and re-index the files that "
+                     "changed on disk, together with the files that include them, without a manual refresh.</p>"
+                     "<p>Only available on Linux.</p>"),
+      layout,
+      row);
+
   addGap(layout, row);
 
   addTitle(QStringLiteral("C/C++"), layout, row);
@@ -332,6 +342,7 @@ void QtProjectWizardContentPreferences::load() {
   m_threads->setCurrentIndex(appSettings->getIndexerThreadCount());    // index and value are the same
   indexerThreadsChanges(m_threads->currentIndex());
   m_multiProcessIndexing->setChecked(appSettings->getMultiProcessIndexingEnabled());
+  m_watchSourceFiles->setChecked(appSettings->getWatchSourceFilesEnabled());
 }
 
 void QtProjectWizardContentPreferences::save() {
@@ -393,6 +404,7 @@ void QtProjectWizardContentPreferences::save() {
 
   appSettings->setIndexerThreadCount(m_threads->currentIndex());    // index and value are the same
   appSettings->setMultiProcessIndexingEnabled(m_multiProcessIndexing->isChecked());
+  appSettings->setWatchSourceFilesEnabled(m_watchSourceFiles->isChecked());
 
   appSettings->save();
 }
@@ -1,5 +1,8 @@
 #include "QtHighlighter.h"
 
+#include <algorithm>
+#include <condition_variable>
+
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -11,6 +14,8 @@
 #include "FileSystem.h"
 #include "logging.h"
 #include "ResourcePaths.h"
+#include "TabId.h"
+#include "TaskLambda.h"
 #include "TextAccess.h"
 #include "tracing.h"
 #include "utility.h"
@@ -18,6 +23,57 @@
 std::map<std::wstring, std::vector<QtHighlighter::HighlightingRule>> QtHighlighter::s_highlightingRules;
 std::map<QtHighlighter::HighlightType, QTextCharFormat> QtHighlighter::s_charFormats;
 
+namespace {
+// summed size of the cached texts and ranges in bytes
+constexpr size_t MAX_RANGES_CACHE_COST = 32 * 1024 * 1024;
+}    // namespace
+
+std::mutex QtHighlighter::s_rangesCacheMutex;
+LruCache<std::pair<std::wstring, uint>, QtHighlighter::CachedRanges> QtHighlighter::s_rangesCache(MAX_RANGES_CACHE_COST);
+
+struct QtHighlighter::PendingRanges {
+  PendingRanges(std::wstring language_, QString text_, std::vector<HighlightingRule> rules_)
+      : language(std::move(language_)), text(std::move(text_)), rules(std::move(rules_)) {}
+
+  // returns false if another thread already creates the ranges
+  bool claim() {
+    std::scoped_lock<std::mutex> lock(mutex);
+    if(isClaimed) {
+      return false;
+    }
+    isClaimed = true;
+    return true;
+  }
+
+  void resolve() {
+    std::shared_ptr<const HighlightingRanges> createdRanges = getRanges(language, text, rules);
+    {
+      std::scoped_lock<std::mutex> lock(mutex);
+      ranges = createdRanges;
+    }
+    resolved.notify_all();
+  }
+
+  std::shared_ptr<const HighlightingRanges> get() {
+    if(claim()) {
+      resolve();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    resolved.wait(lock, [this]() { return ranges != nullptr; });
+    return ranges;
+  }
+
+  const std::wstring language;
+  const QString text;
+  const std::vector<HighlightingRule> rules;
+
+  std::mutex mutex;
+  std::condition_variable resolved;
+  bool isClaimed = false;
+  std::shared_ptr<const HighlightingRanges> ranges;
+};
+
 std::string QtHighlighter::highlightTypeToString(QtHighlighter::HighlightType type) {
   switch(type) {
   case HighlightType::COMMENT:
@@ -127,9 +183,13 @@ void QtHighlighter::loadHighlightingRules() {
 
 void QtHighlighter::clearHighlightingRules() {
   s_highlightingRules.clear();
+
+  std::scoped_lock<std::mutex> lock(s_rangesCacheMutex);
+  s_rangesCache.clear();
 }
 
-QtHighlighter::QtHighlighter(QTextDocument* document, const std::wstring& language) : m_document(document) {
+QtHighlighter::QtHighlighter(QTextDocument* document, const std::wstring& language)
+    : m_document(document), m_language(language) {
   if(!s_highlightingRules.size()) {
     loadHighlightingRules();
   }
@@ -140,20 +200,24 @@ QtHighlighter::QtHighlighter(QTextDocument* document, const std::wstring& langua
   }
 }
 
-void QtHighlighter::highlightDocument() {
-  QTextDocument* doc = document();
-
-  int docStart = 0;
-  int docEnd = 0;
-  for(int i = 0; i < doc->blockCount(); i++) {
-    docEnd += doc->findBlockByLineNumber(i).length();
+void QtHighlighter::prepareDocument() {
+  if(m_highlightingRules.empty() || m_pendingRanges) {
+    return;
   }
 
-  if(docEnd > 0) {
-    docEnd -= 1;
-  }
+  m_pendingRanges = std::make_shared<PendingRanges>(m_language, document()->toPlainText(), m_highlightingRules);
 
-  applyFormat(docStart, docEnd, s_charFormats[HighlightType::TEXT]);
+  Task::dispatch(TabId::prefetch(), std::make_shared<TaskLambda>([pendingRanges = m_pendingRanges]() {
+    if(pendingRanges->claim()) {
+      pendingRanges->resolve();
+    }
+  }));
+}
+
+void QtHighlighter::highlightDocument() {
+  QTextDocument* doc = document();
+
+  applyFormat(0, std::max(doc->characterCount() - 1, 0), s_charFormats[HighlightType::TEXT]);
 
   m_highlightedLines.clear();
   m_highlightedLines.resize(document()->blockCount(), false);
@@ -162,13 +226,12 @@ void QtHighlighter::highlightDocument() {
     return;
   }
 
-  std::vector<HighlightingRule> singleLineRules;
-  for(const HighlightingRule& rule : m_highlightingRules) {
-    if(rule.priority && !rule.multiLine) {
-      singleLineRules.emplace_back(rule);
-    }
-  }
-  createRanges(doc, singleLineRules);
+  prepareDocument();
+
+  std::shared_ptr<const HighlightingRanges> ranges = m_pendingRanges->get();
+  m_singleLineRanges = ranges->singleLineRanges;
+  m_multiLineRanges = ranges->multiLineRanges;
+  m_pendingRanges.reset();
 }
 
 void QtHighlighter::highlightRange(int startLine, int endLine) {
@@ -253,21 +316,60 @@ QTextCharFormat QtHighlighter::getFormat(int /*startPosition*/, int endPosition)
   return cursor.charFormat();
 }
 
-void QtHighlighter::createRanges(QTextDocument* doc, const std::vector<HighlightingRule>& singleLineRules) {
-  m_singleLineRanges.clear();
-  m_multiLineRanges.clear();
+std::shared_ptr<const QtHighlighter::HighlightingRanges> QtHighlighter::getRanges(const std::wstring& language,
+                                                                                   const QString& text,
+                                                                                   const std::vector<HighlightingRule>& rules) {
+  const std::pair<std::wstring, uint> key(language, qHash(text));
+
+  {
+    std::scoped_lock<std::mutex> lock(s_rangesCacheMutex);
+    CachedRanges cachedRanges;
+    if(s_rangesCache.getValue(key, cachedRanges) && cachedRanges.text == text) {
+      return cachedRanges.ranges;
+    }
+  }
+
+  std::shared_ptr<const HighlightingRanges> ranges = createRanges(text, rules);
+
+  const size_t cost = static_cast<size_t>(text.size()) * sizeof(QChar) +
+      (ranges->singleLineRanges.size() + ranges->multiLineRanges.size()) * sizeof(std::tuple<HighlightType, int, int>);
+
+  std::scoped_lock<std::mutex> lock(s_rangesCacheMutex);
+  s_rangesCache.insert(key, {text, ranges}, cost);
+  return ranges;
+}
+
+std::shared_ptr<const QtHighlighter::HighlightingRanges> QtHighlighter::createRanges(const QString& text,
+                                                                                     const std::vector<HighlightingRule>& rules) {
+  std::vector<QString> lines;
+  std::vector<int> lineStarts;
+  for(int lineStart = 0; lineStart <= text.size();) {
+    int lineEnd = text.indexOf(QChar('\n'), lineStart);
+    if(lineEnd < 0) {
+      lineEnd = text.size();
+    }
+
+    lines.push_back(text.mid(lineStart, lineEnd - lineStart));
+    lineStarts.push_back(lineStart);
+    lineStart = lineEnd + 1;
+  }
+
+  auto ranges = std::make_shared<HighlightingRanges>();
+  std::vector<std::tuple<HighlightType, int, int>>& singleLineRanges = ranges->singleLineRanges;
 
-  for(QTextBlock it = doc->begin(); it != doc->end(); it = it.next()) {
-    for(const HighlightingRule& rule : singleLineRules) {
-      utility::append(m_singleLineRanges, getRangesForRule(it, rule));
+  for(size_t i = 0; i < lines.size(); i++) {
+    for(const HighlightingRule& rule : rules) {
+      if(rule.priority && !rule.multiLine) {
+        utility::append(singleLineRanges, getRangesForRule(lines[i], lineStarts[i], rule));
+      }
     }
   }
 
   // remove ranges starting inside others
   {
     std::map<std::pair<int, int>, size_t> sortedRangesToIndex;
-    for(size_t i = 0; i < m_singleLineRanges.size(); i++) {
-      const std::tuple<HighlightType, int, int>& range = m_singleLineRanges[i];
+    for(size_t i = 0; i < singleLineRanges.size(); i++) {
+      const std::tuple<HighlightType, int, int>& range = singleLineRanges[i];
       sortedRangesToIndex.emplace(std::make_pair(std::get<1>(range), std::get<2>(range)), i);
     }
 
@@ -282,25 +384,30 @@ void QtHighlighter::createRanges(QTextDocument* doc, const std::vector<Highlight
     }
 
     for(std::set<size_t>::const_reverse_iterator it = indicesToErase.rbegin(); it != indicesToErase.rend(); it++) {
-      m_singleLineRanges.erase(m_singleLineRanges.begin() + *it);
+      singleLineRanges.erase(singleLineRanges.begin() + *it);
     }
   }
 
-  m_multiLineRanges = createMultiLineRanges(doc, &m_singleLineRanges);
+  ranges->multiLineRanges = createMultiLineRanges(lines, lineStarts, rules, singleLineRanges);
+
+  return ranges;
 }
 
 std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::createMultiLineRanges(
-    QTextDocument* doc, std::vector<std::tuple<HighlightType, int, int>>* ranges) {
+    const std::vector<QString>& lines,
+    const std::vector<int>& lineStarts,
+    const std::vector<HighlightingRule>& rules,
+    const std::vector<std::tuple<HighlightType, int, int>>& ranges) {
   std::vector<std::tuple<HighlightType, int, int>> multiLineRanges;
 
   const HighlightingRule* startRule = nullptr;
 
-  for(const HighlightingRule& rule : m_highlightingRules) {
+  for(const HighlightingRule& rule : rules) {
     if(rule.priority && rule.multiLine) {
       if(!startRule) {
         startRule = &rule;
       } else if(rule.type == startRule->type) {
-        utility::append(multiLineRanges, createMultiLineRangesForRules(doc, ranges, startRule, &rule));
+        utility::append(multiLineRanges, createMultiLineRangesForRules(lines, lineStarts, ranges, *startRule, rule));
         startRule = nullptr;
       }
     }
@@ -310,52 +417,72 @@ std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::c
 }
 
 std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::createMultiLineRangesForRules(
-    QTextDocument* doc,
-    std::vector<std::tuple<HighlightType, int, int>>* ranges,
-    const HighlightingRule* startRule,
-    const HighlightingRule* endRule) {
+    const std::vector<QString>& lines,
+    const std::vector<int>& lineStarts,
+    const std::vector<std::tuple<HighlightType, int, int>>& ranges,
+    const HighlightingRule& startRule,
+    const HighlightingRule& endRule) {
   std::vector<std::tuple<HighlightType, int, int>> multiLineRanges;
 
-  QTextCursor cursorStart(doc);
-  QTextCursor cursorEnd(doc);
+  int position = 0;
 
   while(true) {
+    std::pair<int, int> start;
     while(true) {
-      cursorStart = document()->find(startRule->pattern, cursorStart);
-      if(cursorStart.isNull()) {
+      start = findInLines(lines, lineStarts, startRule.pattern, position);
+      if(start.first < 0 || !isInRange(start.second - 1, ranges)) {
         break;
       }
 
-      if(!isInRange(cursorStart.selectionEnd() - 1, *ranges)) {
-        break;
-      } else {
-        cursorStart.setPosition(cursorStart.selectionEnd() + 1);
-      }
+      position = start.second + 1;
     }
 
-    if(cursorStart.isNull()) {
+    if(start.first < 0) {
       break;
     }
 
-    cursorEnd = document()->find(endRule->pattern, cursorStart);
-    if(cursorEnd.isNull()) {
+    const std::pair<int, int> end = findInLines(lines, lineStarts, endRule.pattern, start.second);
+    if(end.first < 0) {
       break;
     }
 
-    multiLineRanges.emplace_back(std::make_tuple(startRule->type, cursorStart.selectionStart(), cursorEnd.position()));
+    multiLineRanges.emplace_back(std::make_tuple(startRule.type, start.first, end.second));
 
-    cursorStart = cursorEnd;
+    position = end.second;
   }
 
   return multiLineRanges;
 }
 
+std::pair<int, int> QtHighlighter::findInLines(const std::vector<QString>& lines,
+                                               const std::vector<int>& lineStarts,
+                                               const QRegExp& pattern,
+                                               int position) {
+  // matches never span multiple lines, like QTextDocument::find() does not match across blocks
+  QRegExp expression(pattern);
+
+  const auto lineIt = std::upper_bound(lineStarts.begin(), lineStarts.end(), position);
+  for(size_t i = static_cast<size_t>(std::max<std::ptrdiff_t>(lineIt - lineStarts.begin() - 1, 0)); i < lines.size(); i++) {
+    const int offset = std::max(position - lineStarts[i], 0);
+    if(offset > lines[i].size()) {
+      continue;
+    }
+
+    const int index = expression.indexIn(lines[i], offset);
+    if(index >= 0) {
+      return {lineStarts[i] + index, lineStarts[i] + index + expression.matchedLength()};
+    }
+  }
+
+  return {-1, -1};
+}
+
 QtHighlighter::HighlightingRule::HighlightingRule() {}
 
 QtHighlighter::HighlightingRule::HighlightingRule(HighlightType type_, const QRegExp& regExp, bool priority_, bool multiLine_)
     : type(type_), pattern(regExp), priority(priority_), multiLine(multiLine_) {}
 
-bool QtHighlighter::isInRange(int pos, const std::vector<std::tuple<HighlightType, int, int>>& ranges) const {
+bool QtHighlighter::isInRange(int pos, const std::vector<std::tuple<HighlightType, int, int>>& ranges) {
   for(const std::tuple<HighlightType, int, int>& range : ranges) {
     if(pos >= std::get<1>(range) && pos <= std::get<2>(range)) {
       return true;
@@ -365,12 +492,11 @@ bool QtHighlighter::isInRange(int pos, const std::vector<std::tuple<HighlightTyp
   return false;
 }
 
-std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::getRangesForRule(const QTextBlock& block,
-                                                                                                const HighlightingRule& rule) const {
-  const int pos = block.position();
-  const QString text = block.text();
+std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::getRangesForRule(const QString& line,
+                                                                                                int position,
+                                                                                                const HighlightingRule& rule) {
   QRegExp expression(rule.pattern);
-  int index = expression.indexIn(text);
+  int index = expression.indexIn(line);
 
   std::vector<std::tuple<HighlightType, int, int>> ranges;
 
@@ -378,12 +504,12 @@ std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> QtHighlighter::g
     const int length = expression.matchedLength();
     if(expression.capturedTexts().size() > 1) {
       const QString cap = expression.capturedTexts()[1];
-      const int start = text.indexOf(cap, index);
-      ranges.push_back(std::make_tuple(rule.type, pos + start, pos + start + cap.length()));
+      const int start = line.indexOf(cap, index);
+      ranges.push_back(std::make_tuple(rule.type, position + start, position + start + cap.length()));
     } else {
-      ranges.push_back(std::make_tuple(rule.type, pos + index, pos + index + length));
+      ranges.push_back(std::make_tuple(rule.type, position + index, position + index + length));
     }
-    index = expression.indexIn(block.text(), index + length);
+    index = expression.indexIn(line, index + length);
   }
 
   return ranges;
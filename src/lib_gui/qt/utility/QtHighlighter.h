@@ -1,8 +1,13 @@
 #ifndef QT_HIGHLIGHTER_H
 #define QT_HIGHLIGHTER_H
 
+#include <memory>
+#include <mutex>
+
 #include <QTextCharFormat>
 
+#include "LruCache.h"
+
 class QTextBlock;
 class QTextDocument;
 
@@ -19,6 +24,9 @@ public:
   QtHighlighter(QTextDocument* parent, const std::wstring& language);
   ~QtHighlighter() = default;
 
+  // starts creating the highlighting ranges of the document text on the prefetch scheduler, highlightDocument() picks
+  // them up or creates them itself if that did not happen yet
+  void prepareDocument();
   void highlightDocument();
   void highlightRange(int startLine, int endLine);
 
@@ -39,17 +47,45 @@ private:
     bool multiLine = false;
   };
 
-  void createRanges(QTextDocument* doc, const std::vector<HighlightingRule>& quotationRules);
-  std::vector<std::tuple<HighlightType, int, int>> createMultiLineRanges(QTextDocument* doc,
-                                                                         std::vector<std::tuple<HighlightType, int, int>>* ranges);
-  std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> createMultiLineRangesForRules(
-      QTextDocument* doc,
-      std::vector<std::tuple<HighlightType, int, int>>* ranges,
-      const HighlightingRule* startRule,
-      const HighlightingRule* endRule);
+  struct HighlightingRanges {
+    std::vector<std::tuple<HighlightType, int, int>> singleLineRanges;
+    std::vector<std::tuple<HighlightType, int, int>> multiLineRanges;
+  };
+
+  struct CachedRanges {
+    QString text;
+    std::shared_ptr<const HighlightingRanges> ranges;
+  };
 
-  bool isInRange(int index, const std::vector<std::tuple<HighlightType, int, int>>& ranges) const;
-  std::vector<std::tuple<HighlightType, int, int>> getRangesForRule(const QTextBlock& block, const HighlightingRule& rule) const;
+  struct PendingRanges;
+
+  // ranges only depend on the language and the text, so they are cached for documents showing the same code
+  static std::shared_ptr<const HighlightingRanges> getRanges(const std::wstring& language,
+                                                            const QString& text,
+                                                            const std::vector<HighlightingRule>& rules);
+
+  static std::shared_ptr<const HighlightingRanges> createRanges(const QString& text,
+                                                               const std::vector<HighlightingRule>& rules);
+  static std::vector<std::tuple<HighlightType, int, int>> createMultiLineRanges(
+      const std::vector<QString>& lines,
+      const std::vector<int>& lineStarts,
+      const std::vector<HighlightingRule>& rules,
+      const std::vector<std::tuple<HighlightType, int, int>>& ranges);
+  static std::vector<std::tuple<QtHighlighter::HighlightType, int, int>> createMultiLineRangesForRules(
+      const std::vector<QString>& lines,
+      const std::vector<int>& lineStarts,
+      const std::vector<std::tuple<HighlightType, int, int>>& ranges,
+      const HighlightingRule& startRule,
+      const HighlightingRule& endRule);
+  static std::pair<int, int> findInLines(const std::vector<QString>& lines,
+                                         const std::vector<int>& lineStarts,
+                                         const QRegExp& pattern,
+                                         int position);
+
+  static bool isInRange(int index, const std::vector<std::tuple<HighlightType, int, int>>& ranges);
+  static std::vector<std::tuple<HighlightType, int, int>> getRangesForRule(const QString& line,
+                                                                           int position,
+                                                                           const HighlightingRule& rule);
 
   void formatBlockForRule(const QTextBlock& block,
                           const HighlightingRule& rule,
@@ -61,13 +97,17 @@ private:
 
   static std::map<std::wstring, std::vector<HighlightingRule>> s_highlightingRules;
   static std::map<HighlightType, QTextCharFormat> s_charFormats;
+  static std::mutex s_rangesCacheMutex;
+  static LruCache<std::pair<std::wstring, uint>, CachedRanges> s_rangesCache;
 
   QTextDocument* m_document;
+  std::wstring m_language;
 
   std::vector<HighlightingRule> m_highlightingRules;
   std::vector<std::tuple<HighlightType, int, int>> m_singleLineRanges;
   std::vector<std::tuple<HighlightType, int, int>> m_multiLineRanges;
   std::vector<bool> m_highlightedLines;
+  std::shared_ptr<PendingRanges> m_pendingRanges;
 };
 
 #endif    // QT_HIGHLIGHTER_H
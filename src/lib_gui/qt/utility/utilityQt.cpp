@@ -7,6 +7,7 @@
 #include <QFontDatabase>
 #include <QIcon>
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QWidget>
 // Internal
 #include "ColorScheme.h"
@@ -323,6 +324,10 @@ QtMainWindow* getMainWindowforMainView(ViewLayout* viewLayout) {
   return nullptr;
 }
 
+double getLevelOfDetail(const QPainter* painter) {
+  return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+
 void copyNewFilesFromDirectory(const QString& src, const QString& dst) {
   QDir dir(src);
   if(!dir.exists()) {
@@ -5,6 +5,7 @@
 class FilePath;
 class QColor;
 class QIcon;
+class QPainter;
 class QPixmap;
 class QString;
 class QWidget;
@@ -31,6 +32,9 @@ QIcon createButtonIcon(const FilePath& iconPath, const std::string& colorId);
 
 QtMainWindow* getMainWindowforMainView(ViewLayout* viewLayout);
 
+// scale at which the painter draws, graph items leave out details when zoomed out far
+double getLevelOfDetail(const QPainter* painter);
+
 void copyNewFilesFromDirectory(const QString& src, const QString& dst);
 
 }    // namespace utility
\ No newline at end of file
@@ -147,7 +147,11 @@ void QtIndexingStartDialog::updateRefreshInfo(const RefreshInfo& info) {
   size_t clearCount = info.filesToClear.size();
   size_t indexCount = info.filesToIndex.size();
 
-  m_clearLabel->setText("Files to clear: " + QString::number(clearCount));
+  QString clearText = "Files to clear: " + QString::number(clearCount);
+  if(info.changedFileCount != 0U && info.changedFileCount < clearCount) {
+    clearText += " (" + QString::number(info.changedFileCount) + " changed)";
+  }
+  m_clearLabel->setText(clearText);
   m_indexLabel->setText("Source files to index: " + QString::number(indexCount));
 
   m_clearLabel->setVisible((clearCount != 0U) && info.mode != REFRESH_ALL_FILES);
@@ -399,6 +399,7 @@ void QtMainWindow::keyPressEvent(QKeyEvent* event) {
 
   case Qt::Key_Space:
     PRINT_TRACES();
+    EXPORT_TRACES(UserPaths::getLogDirectoryPath().getConcatenated(L"sourcetrail_trace.json"));
     break;
 
   case Qt::Key_Tab:
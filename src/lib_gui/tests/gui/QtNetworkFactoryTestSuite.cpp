@@ -15,6 +15,7 @@ void QtNetworkFactoryTestSuite::init() {
 void QtNetworkFactoryTestSuite::goodCase() {
   const QtNetworkFactory mFactory;
   QVERIFY(mFactory.createIDECommunicationController(nullptr) != nullptr);
+  QVERIFY(mFactory.createDaemonController(nullptr) != nullptr);
 }
 
 void QtNetworkFactoryTestSuite::cleanup() {
@@ -15,6 +15,13 @@
 
 #include <QThread>
 
+#if defined(_WIN32)
+#  include <windows.h>
+#  include <psapi.h>
+#else
+#  include <sys/resource.h>
+#endif
+
 #include "logging.h"
 #include "ScopedFunctor.h"
 #include "utilityString.h"
@@ -197,6 +204,27 @@ int getIdealThreadCount() {
   return std::max(1, threadCount);
 }
 
+size_t getPeakMemoryUsage() {
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#  if defined(__APPLE__)
+  return static_cast<size_t>(usage.ru_maxrss);
+#  else
+  // reported in kilobytes on linux
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#  endif
+#endif
+}
+
 std::string getAppArchTypeString() {
   return "64";
 }
@@ -30,6 +30,9 @@ void killRunningProcesses();
 
 int getIdealThreadCount();
 
+// high-water mark of the resident memory of the calling process in bytes, 0 if unknown
+size_t getPeakMemoryUsage();
+
 constexpr OsType getOsType() {
 #if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
   return OS_WINDOWS;
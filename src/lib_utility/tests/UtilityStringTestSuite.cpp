@@ -1,3 +1,4 @@
+#include <sstream>
 #include <string>
 
 #include <gmock/gmock.h>
@@ -312,3 +313,9 @@ TEST(GenerateRandomString, goodCase) {
   ASSERT_EQ(StringLength1, result1.size());
   EXPECT_THAT(result1, MatchesRegex("([A-z]|[0-9]){32}"s));
 }
+
+TEST(WriteJsonString, escapesQuotesBackslashesAndControlCharacters) {
+  std::stringstream stream;
+  utility::writeJsonString(stream, "a\"b\\c\nd");
+  EXPECT_EQ("\"a\\\"b\\\\c\\u000ad\"", stream.str());
+}
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <iomanip>
 #include <random>
 #include <string>
 
@@ -491,6 +492,20 @@ bool caseInsensitiveLess(const std::wstring& s1, const std::wstring& s2) {
   return res_cmp;
 }
 
+void writeJsonString(std::ostream& stream, std::string_view text) {
+  stream << '"';
+  for(const char c : text) {
+    if(c == '"' || c == '\\') {
+      stream << '\\' << c;
+    } else if(static_cast<unsigned char>(c) < 0x20) {
+      stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+    } else {
+      stream << c;
+    }
+  }
+  stream << '"';
+}
+
 std::string createRandomString(size_t stringLength) {
   static constexpr std::string_view Template = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
@@ -1,8 +1,10 @@
 #pragma once
 #include <algorithm>
 #include <deque>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace utility {
@@ -108,6 +110,9 @@ std::wstring convertWhiteSpacesToSingleSpaces(const std::wstring& str);
 
 bool caseInsensitiveLess(const std::wstring& str1, const std::wstring& str2);
 
+// writes the text as quoted json string, escaping quotes, backslashes and control characters
+void writeJsonString(std::ostream& stream, std::string_view text);
+
 template <typename ContainerType>
 ContainerType split(const std::string& str, const std::string& delimiter) {
   size_t pos = 0;
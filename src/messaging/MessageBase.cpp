@@ -3,6 +3,7 @@
 MessageBase::MessageBase()
     : m_id(s_nextId++)
     , m_schedulerId(0)
+    , m_lane(Lane::Interactive)
     , m_isParallel(false)
     , m_isReplayed(false)
     , m_sendAsTask(true)
@@ -1,5 +1,6 @@
 #pragma once
 // STL
+#include <cstddef>
 #include <ostream>
 #include <sstream>
 // internal
@@ -8,6 +9,10 @@
 
 class MessageBase {
 public:
+  // queued messages of a lane are handled before the ones of the following lanes, the order within a lane is kept
+  enum class Lane { Interactive = 0, Status, Background };
+  static constexpr size_t LaneCount = 3;
+
   MessageBase();
 
   virtual ~MessageBase();
@@ -68,6 +73,14 @@ public:
     m_isLogged = isLogged;
   }
 
+  Lane getLane() const {
+    return m_lane;
+  }
+
+  void setLane(Lane lane) {
+    m_lane = lane;
+  }
+
   void setKeepContent(bool keepContent) {
     m_keepContent = keepContent;
   }
@@ -91,6 +104,8 @@ private:
   Id m_id;
   Id m_schedulerId;
 
+  Lane m_lane;
+
   bool m_isParallel;
   bool m_isReplayed;
 
@@ -1,12 +1,13 @@
 #include "MessageQueue.h"
 
-#include <chrono>
 #include <mutex>
 #include <thread>
 
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/find.hpp>
 #include <range/v3/algorithm/find_if.hpp>
 #include <range/v3/algorithm/for_each.hpp>
+#include <range/v3/algorithm/remove_if.hpp>
 
 #include "../../../scheduling/TaskGroupParallel.h"
 #include "../../../scheduling/TaskGroupSequence.h"
@@ -34,27 +35,30 @@ void MessageQueue::registerListener(MessageListenerBase* listener) noexcept {
     return;
   }
   mListeners.push_back(listener);
+  mUnindexedListeners.push_back(listener);
 }
 
 void MessageQueue::unregisterListener(MessageListenerBase* listener) noexcept {
   std::scoped_lock<std::mutex> lock(mListenersMutex);
-  if(auto found = ranges::find(mListeners, listener); found != mListeners.end()) {
-    mListeners.erase(found);
-
-    // TODO(Hussein): That sound fishy for me. It need `mListenersMutex`
-    const auto index = static_cast<size_t>(std::distance(mListeners.begin(), found));
-    // mCurrentListenerIndex and mListenersLength need to be updated in case this happens
-    // while a message is handled.
-    if(index <= mCurrentListenerIndex) {
-      mCurrentListenerIndex--;
-    }
+  auto found = ranges::find(mListeners, listener);
+  if(found == mListeners.end()) {
+    LOG_ERROR("Listener was not found");
+    return;
+  }
+  mListeners.erase(found);
 
-    if(index < mListenersLength) {
-      mListenersLength--;
-    }
+  if(auto unindexed = ranges::find(mUnindexedListeners, listener); unindexed != mUnindexedListeners.end()) {
+    mUnindexedListeners.erase(unindexed);
+    return;
   }
 
-  LOG_ERROR("Listener was not found");
+  // the listener is already partly destroyed, so its type is taken from the index
+  if(auto type = mListenerTypes.find(listener->getId()); type != mListenerTypes.end()) {
+    std::vector<ListenerEntry>& entries = mListenersByType[type->second];
+    entries.erase(ranges::remove_if(entries, [listener](const auto& entry) { return entry.second == listener; }),
+                  entries.end());
+    mListenerTypes.erase(type);
+  }
 }
 
 MessageListenerBase* MessageQueue::getListenerById(Id listenerId) const noexcept {
@@ -71,11 +75,15 @@ void MessageQueue::addMessageFilter(std::shared_ptr<MessageFilter> filter) noexc
 }
 
 void MessageQueue::pushMessage(std::shared_ptr<MessageBase> message) noexcept {
-  std::scoped_lock<std::mutex> lock(mMessageBufferMutex);
-  if(ranges::find(mMessageBuffer, message) != mMessageBuffer.end()) {
-    return;
+  {
+    std::scoped_lock<std::mutex> lock(mMessageBufferMutex);
+    MessageBufferType& messageBuffer = mMessageBuffers[static_cast<size_t>(message->getLane())];
+    if(ranges::find(messageBuffer, message) != messageBuffer.end()) {
+      return;
+    }
+    messageBuffer.push_back(std::move(message));
   }
-  mMessageBuffer.push_back(std::move(message));
+  mMessageBufferCondition.notify_one();
 }
 
 void MessageQueue::processMessage(const std::shared_ptr<MessageBase>& message, bool asNextTask) noexcept {
@@ -92,9 +100,9 @@ void MessageQueue::processMessage(const std::shared_ptr<MessageBase>& message, b
 }
 
 void MessageQueue::startMessageLoopThreaded() noexcept {
+  mThreadIsRunning = true;
   // TODO(Hussein): Remove `detach()`
   std::thread(&MessageQueue::startMessageLoop, this).detach();
-  mThreadIsRunning = true;
 }
 
 void MessageQueue::startMessageLoop() noexcept {
@@ -107,17 +115,18 @@ void MessageQueue::startMessageLoop() noexcept {
   while(true) {
     processMessages();
 
+    std::unique_lock<std::mutex> lock(mMessageBufferMutex);
+    mMessageBufferCondition.wait(lock, [this]() { return hasMessagesQueuedUnlocked() || !mLoopIsRunning; });
+
     if(!mLoopIsRunning) {
       break;
     }
-
-    using namespace std::chrono_literals;
-    std::this_thread::sleep_for(25ms);
   }
 
-  if(mThreadIsRunning) {
-    mThreadIsRunning = false;
-  }
+  // notified under the lock, the queue may get destroyed as soon as stopMessageLoop returns
+  std::scoped_lock<std::mutex> lock(mThreadMutex);
+  mThreadIsRunning = false;
+  mThreadCondition.notify_all();
 }
 
 void MessageQueue::stopMessageLoop() noexcept {
@@ -127,14 +136,14 @@ void MessageQueue::stopMessageLoop() noexcept {
 
   mLoopIsRunning = false;
 
-  while(true) {
-    if(!mThreadIsRunning) {
-      break;
-    }
-
-    using namespace std::chrono_literals;
-    std::this_thread::sleep_for(25ms);
+  {
+    // taking the lock makes sure the loop either sees the flag or is already waiting for the notification
+    std::scoped_lock<std::mutex> lock(mMessageBufferMutex);
   }
+  mMessageBufferCondition.notify_all();
+
+  std::unique_lock<std::mutex> lock(mThreadMutex);
+  mThreadCondition.wait(lock, [this]() { return !mThreadIsRunning; });
 }
 
 bool MessageQueue::loopIsRunning() const noexcept {
@@ -143,7 +152,7 @@ bool MessageQueue::loopIsRunning() const noexcept {
 
 bool MessageQueue::hasMessagesQueued() const noexcept {
   std::scoped_lock<std::mutex> lock(mMessageBufferMutex);
-  return !mMessageBuffer.empty();
+  return hasMessagesQueuedUnlocked();
 }
 
 void MessageQueue::setSendMessagesAsTasks(bool sendMessagesAsTasks) noexcept {
@@ -156,20 +165,26 @@ void MessageQueue::processMessages() {
     {
       std::scoped_lock<std::mutex> lock(mMessageBufferMutex);
 
-      ranges::for_each(mFilters, [this](const auto& filter) {
-        if(mMessageBuffer.empty()) {
-          return;
-        }
+      // lanes are handled in order, so only the lanes up to the first one with messages need filtering
+      for(MessageBufferType& messageBuffer : mMessageBuffers) {
+        ranges::for_each(mFilters, [&messageBuffer](const auto& filter) {
+          if(messageBuffer.empty()) {
+            return;
+          }
 
-        filter->filter(&mMessageBuffer);
-      });
+          filter->filter(&messageBuffer);
+        });
 
-      if(mMessageBuffer.empty()) {
-        break;
+        if(!messageBuffer.empty()) {
+          message = messageBuffer.front();
+          messageBuffer.pop_front();
+          break;
+        }
       }
 
-      message = mMessageBuffer.front();
-      mMessageBuffer.pop_front();
+      if(!message) {
+        break;
+      }
     }
 
     processMessage(message, false);
@@ -177,24 +192,25 @@ void MessageQueue::processMessages() {
 }
 
 void MessageQueue::sendMessage(const std::shared_ptr<MessageBase>& message) {
-  std::scoped_lock<std::mutex> lock(mListenersMutex);
+  std::unique_lock<std::mutex> lock(mListenersMutex);
 
-  // mListenersLength is saved, so that new listeners registered within message handling don't
-  // get the current message and the length can be reduced when a listener gets unregistered.
-  mListenersLength = mListeners.size();
+  // The listeners are copied, so that new listeners registered within message handling don't get the current message.
+  // Each listener is looked up again before it is called, in case it got unregistered in the meantime.
+  const std::string type = message->getType();
+  const std::vector<ListenerEntry> listeners = getListenersForType(type);
 
-  // The currentListenerIndex holds the index of the current listener being handled, so it can be
-  // changed when a listener gets removed while message handling.
-  for(mCurrentListenerIndex = 0; mCurrentListenerIndex < mListenersLength; ++mCurrentListenerIndex) {
-    MessageListenerBase* listener = mListeners[mCurrentListenerIndex];
+  for(const auto& entry : listeners) {
+    MessageListenerBase* listener = getListenerForType(type, entry.first);
+    if(listener == nullptr) {
+      continue;
+    }
 
-    if(listener->getType() == message->getType() &&
-       (message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
-        listener->getSchedulerId() == message->getSchedulerId())) {
+    if(message->getSchedulerId() == 0 || listener->getSchedulerId() == 0 ||
+       listener->getSchedulerId() == message->getSchedulerId()) {
       // The listenersMutex gets unlocked so changes to listeners are possible while message handling.
-      mListenersMutex.unlock();
+      lock.unlock();
       listener->handleMessageBase(message.get());
-      mListenersMutex.lock();
+      lock.lock();
     }
   }
 }
@@ -209,11 +225,9 @@ void MessageQueue::sendMessageAsTask(const std::shared_ptr<MessageBase>& message
 
   {
     std::scoped_lock<std::mutex> lock(mListenersMutex);
-    for(auto* pListener : mListeners) {
-      if(pListener->getType() == message->getType() &&
-         (message->getSchedulerId() == 0 || pListener->getSchedulerId() == 0 ||
-          pListener->getSchedulerId() == message->getSchedulerId())) {
-        Id listenerId = pListener->getId();
+    for(const auto& [listenerId, pListener] : getListenersForType(message->getType())) {
+      if(message->getSchedulerId() == 0 || pListener->getSchedulerId() == 0 ||
+         pListener->getSchedulerId() == message->getSchedulerId()) {
         taskGroup->addTask(std::make_shared<TaskLambda>([listenerId, message]() {
           auto* pInnerListener = MessageQueue::getInstance()->getListenerById(listenerId);
           if(pInnerListener != nullptr) {
@@ -235,4 +249,27 @@ void MessageQueue::sendMessageAsTask(const std::shared_ptr<MessageBase>& message
     Task::dispatch(schedulerId, taskGroup);
   }
 }
+
+const std::vector<MessageQueue::ListenerEntry>& MessageQueue::getListenersForType(const std::string& type) const {
+  for(MessageListenerBase* listener : mUnindexedListeners) {
+    std::string listenerType = listener->getType();
+    mListenersByType[listenerType].emplace_back(listener->getId(), listener);
+    mListenerTypes.emplace(listener->getId(), std::move(listenerType));
+  }
+  mUnindexedListeners.clear();
+
+  static const std::vector<ListenerEntry> NoListeners;
+  auto found = mListenersByType.find(type);
+  return found == mListenersByType.end() ? NoListeners : found->second;
+}
+
+MessageListenerBase* MessageQueue::getListenerForType(const std::string& type, Id listenerId) const {
+  const std::vector<ListenerEntry>& listeners = getListenersForType(type);
+  auto found = ranges::find_if(listeners, [listenerId](const auto& entry) { return entry.first == listenerId; });
+  return found == listeners.end() ? nullptr : found->second;
+}
+
+bool MessageQueue::hasMessagesQueuedUnlocked() const {
+  return ranges::any_of(mMessageBuffers, [](const auto& messageBuffer) { return !messageBuffer.empty(); });
+}
 }    // namespace details
\ No newline at end of file
@@ -1,14 +1,19 @@
 #pragma once
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "MessageBase.h"
 #include "types.h"
 
-class MessageBase;
 class MessageFilter;
 class MessageListenerBase;
 
@@ -94,22 +99,37 @@ public:
   void setSendMessagesAsTasks(bool sendMessagesAsTasks) noexcept override;
 
 private:
+  using ListenerEntry = std::pair<Id, MessageListenerBase*>;
+
   void processMessages();
   void sendMessage(const std::shared_ptr<MessageBase>& message);
   void sendMessageAsTask(const std::shared_ptr<MessageBase>& message, bool asNextTask) const;
 
-  MessageBufferType mMessageBuffer;
+  // requires mListenersMutex, listeners ordered by registration
+  const std::vector<ListenerEntry>& getListenersForType(const std::string& type) const;
+  MessageListenerBase* getListenerForType(const std::string& type, Id listenerId) const;
+  [[nodiscard]] bool hasMessagesQueuedUnlocked() const;
+
+  // one buffer per MessageBase::Lane
+  std::array<MessageBufferType, MessageBase::LaneCount> mMessageBuffers;
   std::vector<MessageListenerBase*> mListeners;
   std::vector<std::shared_ptr<MessageFilter>> mFilters;
 
-  size_t mCurrentListenerIndex = 0;
-  size_t mListenersLength = 0;
+  // listeners by message type, filled on dispatch because the type is not known yet while a listener gets constructed
+  mutable std::unordered_map<std::string, std::vector<ListenerEntry>> mListenersByType;
+  mutable std::unordered_map<Id, std::string> mListenerTypes;
+  mutable std::vector<MessageListenerBase*> mUnindexedListeners;
 
   std::atomic_bool mLoopIsRunning = false;
   std::atomic_bool mThreadIsRunning = false;
 
   mutable std::mutex mMessageBufferMutex;
   mutable std::mutex mListenersMutex;
+  std::mutex mThreadMutex;
+
+  // wakes the idle loop when messages are pushed or the loop is stopped
+  std::condition_variable mMessageBufferCondition;
+  std::condition_variable mThreadCondition;
 
   bool mSendMessagesAsTasks = false;
 };
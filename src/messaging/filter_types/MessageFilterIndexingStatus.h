@@ -0,0 +1,24 @@
+#pragma once
+// STL
+#include <algorithm>
+// internal
+#include "MessageFilter.h"
+#include "type/indexing/MessageIndexingStatus.h"
+
+/**
+ * Only the latest queued indexing progress is shown, older progress messages of the burst are dropped.
+ */
+class MessageFilterIndexingStatus : public MessageFilter {
+  void filter(IMessageQueue::MessageBufferType* messageBuffer) override {
+    while(messageBuffer->size() >= 2 && isIndexingStatus(messageBuffer->front().get()) &&
+          std::any_of(messageBuffer->begin() + 1, messageBuffer->end(), [](const auto& message) {
+            return isIndexingStatus(message.get());
+          })) {
+      messageBuffer->pop_front();
+    }
+  }
+
+  static bool isIndexingStatus(const MessageBase* message) {
+    return message->getType() == MessageIndexingStatus::getStaticType();
+  }
+};
@@ -0,0 +1,58 @@
+#ifndef MESSAGE_FILTER_LATEST_ACTIVATION_H
+#define MESSAGE_FILTER_LATEST_ACTIVATION_H
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include "MessageFilter.h"
+#include "type/activation/MessageActivateBase.h"
+#include "type/activation/MessageActivateTokens.h"
+
+/**
+ * Remembers the id of the latest activation that replaces the content of a tab, as soon as it enters the message
+ * buffer. Long running activation handlers compare it with the id of the message they are working on and stop early
+ * once a newer activation is waiting for the same scheduler.
+ */
+class MessageFilterLatestActivation : public MessageFilter {
+public:
+  static bool isOutdated(const MessageBase* message) {
+    if(message->isReplayed()) {
+      return false;
+    }
+
+    std::scoped_lock<std::mutex> lock(s_mutex);
+    for(Id schedulerId : {message->getSchedulerId(), Id(0)}) {
+      auto it = s_latestActivationIds.find(schedulerId);
+      if(it != s_latestActivationIds.end() && it->second > message->getId()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void filter(IMessageQueue::MessageBufferType* messageBuffer) override {
+    std::scoped_lock<std::mutex> lock(s_mutex);
+    for(const std::shared_ptr<MessageBase>& message : *messageBuffer) {
+      if(message->isReplayed() || !dynamic_cast<MessageActivateBase*>(message.get())) {
+        continue;
+      }
+
+      if(message->getType() == MessageActivateTokens::getStaticType()) {
+        const auto* activateTokens = dynamic_cast<MessageActivateTokens*>(message.get());
+        if(activateTokens->isEdge || activateTokens->keepContent()) {
+          continue;
+        }
+      }
+
+      Id& latestId = s_latestActivationIds[message->getSchedulerId()];
+      latestId = std::max(latestId, message->getId());
+    }
+  }
+
+private:
+  static inline std::mutex s_mutex;
+  static inline std::map<Id, Id> s_latestActivationIds;
+};
+
+#endif    // MESSAGE_FILTER_LATEST_ACTIVATION_H
@@ -0,0 +1,30 @@
+#pragma once
+// internal
+#include "MessageFilter.h"
+#include "type/code/MessageScrollCode.h"
+#include "type/graph/MessageScrollGraph.h"
+
+/**
+ * Drops scroll messages that are directly followed by another scroll of the same view, only the final position of a
+ * burst is handled. The undo history merges consecutive scrolls anyway.
+ */
+class MessageFilterScroll : public MessageFilter {
+  void filter(IMessageQueue::MessageBufferType* messageBuffer) override {
+    while(messageBuffer->size() >= 2 && isSupersededBy(messageBuffer->front().get(), (*messageBuffer)[1].get())) {
+      messageBuffer->pop_front();
+    }
+  }
+
+  static bool isSupersededBy(const MessageBase* message, const MessageBase* nextMessage) {
+    if(message->getType() != nextMessage->getType() || message->getSchedulerId() != nextMessage->getSchedulerId()) {
+      return false;
+    }
+
+    if(message->getType() == MessageScrollCode::getStaticType()) {
+      return dynamic_cast<const MessageScrollCode*>(message)->inListMode ==
+          dynamic_cast<const MessageScrollCode*>(nextMessage)->inListMode;
+    }
+
+    return message->getType() == MessageScrollGraph::getStaticType();
+  }
+};
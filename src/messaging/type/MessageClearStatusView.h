@@ -5,7 +5,9 @@
 
 class MessageClearStatusView : public Message<MessageClearStatusView> {
 public:
-  MessageClearStatusView() {}
+  MessageClearStatusView() {
+    setLane(Lane::Status);
+  }
 
   static const std::string getStaticType() {
     return "MessageClearStatusView";
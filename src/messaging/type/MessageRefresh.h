@@ -9,20 +9,38 @@ public:
     return "MessageRefresh";
   }
 
-  MessageRefresh() : all(false) {}
+  MessageRefresh() : all(false), incompleteFiles(false), changedFiles(false) {}
 
   MessageRefresh& refreshAll() {
     all = true;
     return *this;
   }
 
+  // the updated files and the files that had errors
+  MessageRefresh& refreshIncompleteFiles() {
+    incompleteFiles = true;
+    return *this;
+  }
+
+  // only the files reported by the file watcher of the project
+  MessageRefresh& refreshChangedFiles() {
+    changedFiles = true;
+    return *this;
+  }
+
   void print(std::wostream& os) const override {
     if(all) {
       os << "all";
+    } else if(incompleteFiles) {
+      os << "incomplete files";
+    } else if(changedFiles) {
+      os << "changed files";
     }
   }
 
   bool all;
+  bool incompleteFiles;
+  bool changedFiles;
 };
 
 #endif    // MESSAGE_REFRESH_H
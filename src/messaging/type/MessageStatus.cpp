@@ -7,11 +7,13 @@ MessageStatus::MessageStatus(const std::wstring& status_, bool isError_, bool sh
   m_stati.push_back(utility::replace(status_, L"\n", L" "));
 
   setSendAsTask(false);
+  setLane(Lane::Status);
 }
 
 MessageStatus::MessageStatus(const std::vector<std::wstring>& stati_, bool isError_, bool showLoader_, bool showInStatusBar_)
     : isError(isError_), showLoader(showLoader_), showInStatusBar(showInStatusBar_), m_stati(stati_) {
   setSendAsTask(false);
+  setLane(Lane::Status);
 }
 
 const std::string MessageStatus::getStaticType() {
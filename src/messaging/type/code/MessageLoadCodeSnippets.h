@@ -0,0 +1,22 @@
+#pragma once
+// internal
+#include "FilePath.h"
+#include "Message.h"
+#include "TabId.h"
+
+class MessageLoadCodeSnippets final : public Message<MessageLoadCodeSnippets> {
+public:
+  explicit MessageLoadCodeSnippets(const FilePath& filePath_) : filePath(filePath_) {
+    setSchedulerId(TabId::currentTab());
+  }
+
+  static const std::string getStaticType() {
+    return "MessageLoadCodeSnippets";
+  }
+
+  void print(std::wostream& ostream) const override {
+    ostream << filePath.wstr();
+  }
+
+  const FilePath filePath;
+};
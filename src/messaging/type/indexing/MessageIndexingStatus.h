@@ -11,6 +11,7 @@ public:
   MessageIndexingStatus(bool showProgress_, size_t progressPercent_ = 0)
       : showProgress(showProgress_), progressPercent(progressPercent_) {
     setSendAsTask(false);
+    setLane(Lane::Background);
   }
 
   const bool showProgress;
@@ -4,7 +4,9 @@
 
 class MessagePingReceived final : public Message<MessagePingReceived> {
 public:
-  MessagePingReceived() = default;
+  MessagePingReceived() {
+    setLane(Lane::Background);
+  }
 
   static const std::string getStaticType() {
     return "MessagePingReceived";
@@ -5,6 +5,10 @@
 
 #include "ScopedFunctor.h"
 
+namespace {
+constexpr auto MaxUpdateWaitTime = std::chrono::milliseconds(25);
+}    // namespace
+
 TaskGroupParallel::TaskGroupParallel() : m_needsToStartThreads(true), m_activeTaskCountMutex(std::make_shared<std::mutex>()) {}
 
 void TaskGroupParallel::addTask(std::shared_ptr<Task> task) {
@@ -26,7 +30,11 @@ void TaskGroupParallel::doEnter(std::shared_ptr<Blackboard> blackboard) {
 }
 
 Task::TaskState TaskGroupParallel::doUpdate(std::shared_ptr<Blackboard> /*blackboard*/) {
-  std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  {
+    // the wait is bounded, so the scheduler still gets the chance to terminate this group
+    std::unique_lock<std::mutex> lock(*m_activeTaskCountMutex.get());
+    m_activeTaskCountCondition.wait_for(lock, MaxUpdateWaitTime, [this]() { return m_activeTaskCount <= 0; });
+  }
 
   if(m_tasks.size() != 0 && getActiveTaskCount() > 0) {
     return STATE_RUNNING;
@@ -77,6 +85,7 @@ void TaskGroupParallel::processTaskThreaded(std::shared_ptr<TaskInfo> taskInfo,
   ScopedFunctor functor([&]() {
     std::lock_guard<std::mutex> lock(*activeTaskCountMutex.get());
     m_activeTaskCount--;
+    m_activeTaskCountCondition.notify_all();
   });
 
   while(true) {
@@ -1,5 +1,6 @@
 #pragma once
 // STL
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -38,4 +39,6 @@ private:
   volatile bool m_taskFailed;
   volatile int m_activeTaskCount;
   mutable std::shared_ptr<std::mutex> m_activeTaskCountMutex;
+  // notified whenever a child task finishes, so doUpdate returns without waiting for the next poll
+  std::condition_variable m_activeTaskCountCondition;
 };
\ No newline at end of file
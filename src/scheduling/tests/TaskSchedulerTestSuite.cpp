@@ -5,6 +5,7 @@
 
 #include "../Blackboard.h"
 #include "../Task.h"
+#include "../TaskGroupParallel.h"
 #include "../TaskGroupSelector.h"
 #include "../TaskGroupSequence.h"
 #include "../TaskScheduler.h"
@@ -103,6 +104,25 @@ TEST(TaskScheduler, loopStartsAndStops) {
   EXPECT_TRUE(!scheduler.loopIsRunning());
 }
 
+TEST(TaskScheduler, idleLoopProcessesTasksPushedLater) {
+  TaskScheduler scheduler(0);
+  scheduler.startSchedulerLoopThreaded();
+
+  waitForThread(scheduler);
+
+  int order = 0;
+  std::shared_ptr<TestTask> task = std::make_shared<TestTask>(&order, 1);
+
+  scheduler.pushTask(task);
+
+  waitForThread(scheduler);
+
+  scheduler.stopSchedulerLoop();
+
+  EXPECT_TRUE(3 == order);
+  EXPECT_TRUE(!scheduler.loopIsRunning());
+}
+
 TEST(TaskScheduler, tasksGetExecutedWithoutSchedulingInCorrectOrder) {
   int order = 0;
   TestTask task(&order, 1);
@@ -225,6 +245,29 @@ TEST(TaskScheduler, sequentialTaskGroupDoesNotEvaluateTasksAfterSuccess) {
   EXPECT_TRUE(0 == task3->exitCallOrder);
 }
 
+TEST(TaskScheduler, parallelTaskGroupProcessesAllTasks) {
+  TaskScheduler scheduler(0);
+  scheduler.startSchedulerLoopThreaded();
+
+  int order1 = 0;
+  int order2 = 0;
+  std::shared_ptr<TestTask> task1 = std::make_shared<TestTask>(&order1, 3);
+  std::shared_ptr<TestTask> task2 = std::make_shared<TestTask>(&order2, 1);
+
+  std::shared_ptr<TaskGroupParallel> taskGroup = std::make_shared<TaskGroupParallel>();
+  taskGroup->addTask(task1);
+  taskGroup->addTask(task2);
+
+  scheduler.pushTask(taskGroup);
+
+  waitForThread(scheduler);
+
+  scheduler.stopSchedulerLoop();
+
+  EXPECT_TRUE(5 == order1);
+  EXPECT_TRUE(3 == order2);
+}
+
 TEST(TaskScheduler, taskSchedulingWithinTaskProcessing) {
   TaskScheduler scheduler(0);
   scheduler.startSchedulerLoopThreaded();
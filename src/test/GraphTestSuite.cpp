@@ -285,3 +285,35 @@ TEST(Graph, graphRemovesNodes) {
 
   EXPECT_TRUE(1 == graph.getNodeCount());
 }
+
+TEST(Graph, graphRemovesEdgesOfRemovedNodes) {
+  Graph graph;
+
+  Node* a = graph.createNode(1, NodeType(NODE_FUNCTION), NameHierarchy(L"A", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+  Node* b = graph.createNode(2, NodeType(NODE_FUNCTION), NameHierarchy(L"B", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+  graph.createEdge(3, Edge::EDGE_CALL, a, b);
+
+  graph.removeNode(a);
+
+  EXPECT_TRUE(1 == graph.getNodeCount());
+  EXPECT_TRUE(0 == graph.getEdgeCount());
+  EXPECT_TRUE(0 == b->getEdgeCount());
+}
+
+TEST(Graph, graphVisitsTokensOrderedById) {
+  Graph graph;
+
+  Node* c = graph.createNode(3, NodeType(NODE_FUNCTION), NameHierarchy(L"C", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+  Node* a = graph.createNode(1, NodeType(NODE_FUNCTION), NameHierarchy(L"A", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+  Node* b = graph.createNode(2, NodeType(NODE_FUNCTION), NameHierarchy(L"B", NAME_DELIMITER_CXX), DEFINITION_EXPLICIT);
+  Edge* e = graph.createEdge(5, Edge::EDGE_CALL, a, b);
+  Edge* d = graph.createEdge(4, Edge::EDGE_CALL, a, c);
+
+  std::vector<Node*> nodes;
+  graph.forEachNode([&nodes](Node* node) { nodes.push_back(node); });
+  EXPECT_TRUE(std::vector<Node*>({a, b, c}) == nodes);
+
+  std::vector<Edge*> edges;
+  a->forEachEdge([&edges](Edge* edge) { edges.push_back(edge); });
+  EXPECT_TRUE(std::vector<Edge*>({d, e}) == edges);
+}
@@ -0,0 +1,47 @@
+// STL
+#include <memory>
+#include <set>
+#include <string>
+// benchmark
+#include <benchmark/benchmark.h>
+// internal
+#include "CxxParser.h"
+#include "FilePath.h"
+#include "FilePathFilter.h"
+#include "FileRegister.h"
+#include "IndexerStateInfo.h"
+#include "IntermediateStorage.h"
+#include "ParserClientImpl.h"
+#include "SyntheticCodebase.h"
+#include "TextAccess.h"
+
+namespace {
+// indexes every file the parser sees, the source only exists in memory
+class BenchmarkFileRegister final : public FileRegister {
+public:
+  BenchmarkFileRegister() : FileRegister(FilePath(), std::set<FilePath>(), std::set<FilePathFilter>()) {}
+
+  bool hasFilePath(const FilePath& /*filePath*/) const override {
+    return true;
+  }
+};
+}    // namespace
+
+// parsing and visiting one translation unit of growing size, the same work an indexer process does per source file
+void CxxParserBuildIndex(benchmark::State& state) {
+  const SyntheticCodebase codebase(2, static_cast<size_t>(state.range(0)), 8, 4);
+  const std::string source = codebase.createCxxSource(0);
+
+  const std::shared_ptr<FileRegister> fileRegister = std::make_shared<BenchmarkFileRegister>();
+  CxxParser::initializeLLVM();
+
+  for(auto _ : state) {
+    std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+    CxxParser parser(std::make_shared<ParserClientImpl>(storage.get()), fileRegister, std::make_shared<IndexerStateInfo>());
+    parser.buildIndex(L"synthetic.cpp", TextAccess::createFromString(source));
+    benchmark::DoNotOptimize(storage->getSourceLocationCount());
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+BENCHMARK(CxxParserBuildIndex)->ArgName("classes")->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,116 @@
+// STL
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+// benchmark
+#include <benchmark/benchmark.h>
+// internal
+#include "DummyEdge.h"
+#include "DummyNode.h"
+#include "Graph.h"
+#include "LayeredGraphLayouter.h"
+#include "TrailLayouter.h"
+#include "Vector2.h"
+
+namespace {
+struct Trail {
+  std::vector<Vec2i> nodeSizes;
+  std::vector<std::pair<size_t, size_t>> edges;
+};
+
+// call trail from node 0: every node is called from one of the nodes added shortly before it, some calls skip levels
+// and a few point back and close cycles
+Trail generateTrail(size_t nodeCount) {
+  constexpr size_t TrailWidth = 12;
+
+  std::mt19937 random(42);
+  Trail trail;
+  for(size_t node = 0; node < nodeCount; node++) {
+    trail.nodeSizes.emplace_back(80 + static_cast<int>(random() % 120), 20 + static_cast<int>(random() % 3) * 20);
+    if(node == 0) {
+      continue;
+    }
+
+    const size_t first = node > TrailWidth ? node - TrailWidth : 0;
+    trail.edges.emplace_back(first + random() % (node - first), node);
+
+    if(random() % 4 == 0) {
+      trail.edges.emplace_back(random() % node, node);
+    }
+    if(random() % 20 == 0) {
+      trail.edges.emplace_back(node, random() % node);
+    }
+  }
+  return trail;
+}
+}    // namespace
+
+void LayeredGraphLayouterLayout(benchmark::State& state) {
+  const Trail trail = generateTrail(static_cast<size_t>(state.range(0)));
+
+  for(auto _ : state) {
+    LayeredGraphLayouter layouter(150, 30, 20, false);
+    for(const Vec2i& size : trail.nodeSizes) {
+      layouter.addNode(size.x, size.y);
+    }
+    for(const auto& [origin, target] : trail.edges) {
+      layouter.addEdge(origin, target);
+    }
+    layouter.layout(0);
+    benchmark::DoNotOptimize(layouter.getY(trail.nodeSizes.size() - 1));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(LayeredGraphLayouterLayout)->ArgName("nodes")->Arg(100)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+// up to 100 nodes the trail layouter uses its own pipeline, larger trails go to the LayeredGraphLayouter
+void TrailLayouterLayoutGraph(benchmark::State& state) {
+  const Trail trail = generateTrail(static_cast<size_t>(state.range(0)));
+
+  Graph graph;
+  std::vector<Node*> nodes;
+  std::map<Id, Id> topLevelAncestorIds;
+  for(size_t i = 0; i < trail.nodeSizes.size(); i++) {
+    const Id id = static_cast<Id>(i + 1);
+    nodes.push_back(graph.createNode(
+        id, NodeType(NODE_METHOD), NameHierarchy(L"method" + std::to_wstring(i), NAME_DELIMITER_CXX), DEFINITION_EXPLICIT));
+    topLevelAncestorIds.emplace(id, id);
+  }
+
+  std::vector<Edge*> edges;
+  for(const auto& [origin, target] : trail.edges) {
+    const Id id = static_cast<Id>(trail.nodeSizes.size() + edges.size() + 1);
+    edges.push_back(graph.createEdge(id, Edge::EDGE_CALL, nodes[origin], nodes[target]));
+  }
+
+  for(auto _ : state) {
+    state.PauseTiming();
+    std::vector<std::shared_ptr<DummyNode>> dummyNodes;
+    for(size_t i = 0; i < trail.nodeSizes.size(); i++) {
+      std::shared_ptr<DummyNode> dummyNode = std::make_shared<DummyNode>(DummyNode::DUMMY_DATA);
+      dummyNode->visible = true;
+      dummyNode->active = i == 0;
+      dummyNode->tokenId = nodes[i]->getId();
+      dummyNode->name = L"method" + std::to_wstring(i);
+      dummyNode->size = trail.nodeSizes[i];
+      dummyNodes.push_back(dummyNode);
+    }
+
+    std::vector<std::shared_ptr<DummyEdge>> dummyEdges;
+    for(const Edge* edge : edges) {
+      std::shared_ptr<DummyEdge> dummyEdge = std::make_shared<DummyEdge>(edge->getFrom()->getId(), edge->getTo()->getId(), edge);
+      dummyEdge->visible = true;
+      dummyEdges.push_back(dummyEdge);
+    }
+    state.ResumeTiming();
+
+    TrailLayouter layouter(TrailLayouter::LAYOUT_LEFT_RIGHT);
+    layouter.layoutGraph(dummyNodes, dummyEdges, topLevelAncestorIds);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(TrailLayouterLayoutGraph)->ArgName("nodes")->Arg(50)->Arg(100)->Arg(1000)->Arg(5000)->Unit(benchmark::kMillisecond);
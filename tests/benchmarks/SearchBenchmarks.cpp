@@ -0,0 +1,101 @@
+// STL
+#include <string>
+#include <vector>
+// benchmark
+#include <benchmark/benchmark.h>
+// internal
+#include "FullTextSearchIndex.h"
+#include "SearchIndex.h"
+#include "SyntheticCodebase.h"
+#include "utilityString.h"
+
+namespace {
+constexpr size_t MethodsPerClass = 8;
+constexpr size_t CallsPerMethod = 4;
+
+SyntheticCodebase createCodebase(size_t classCount) {
+  constexpr size_t ClassesPerFile = 20;
+  return SyntheticCodebase((classCount + ClassesPerFile - 1) / ClassesPerFile, ClassesPerFile, MethodsPerClass, CallsPerMethod);
+}
+}    // namespace
+
+void SearchIndexFinishSetup(benchmark::State& state) {
+  const std::vector<std::wstring> names = createCodebase(static_cast<size_t>(state.range(0))).getSymbolNames();
+
+  for(auto _ : state) {
+    SearchIndex index;
+    for(size_t i = 0; i < names.size(); i++) {
+      index.addNode(static_cast<Id>(i + 1), names[i]);
+    }
+    index.finishSetup();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+}
+BENCHMARK(SearchIndexFinishSetup)->ArgName("classes")->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// fuzzy queries of growing length, short ones match almost every symbol
+void SearchIndexSearch(benchmark::State& state) {
+  const std::vector<std::wstring> names = createCodebase(static_cast<size_t>(state.range(0))).getSymbolNames();
+
+  SearchIndex index;
+  for(size_t i = 0; i < names.size(); i++) {
+    index.addNode(static_cast<Id>(i + 1), names[i]);
+  }
+  index.finishSetup();
+
+  const std::wstring query = std::wstring(L"synthetic::C12::m3").substr(0, static_cast<size_t>(state.range(1)));
+
+  size_t resultCount = 0;
+  for(auto _ : state) {
+    resultCount = index.search(query, NodeTypeSet::all(), 100).size();
+  }
+
+  state.counters["results"] = static_cast<double>(resultCount);
+}
+BENCHMARK(SearchIndexSearch)
+    ->ArgNames({"classes", "query"})
+    ->ArgsProduct({{1000, 10000}, {2, 6, 18}})
+    ->Unit(benchmark::kMicrosecond);
+
+void FullTextSearchIndexAddFile(benchmark::State& state) {
+  const SyntheticCodebase codebase = createCodebase(static_cast<size_t>(state.range(0)));
+
+  std::vector<std::wstring> contents;
+  int64_t byteCount = 0;
+  for(size_t fileIndex = 0; fileIndex < codebase.getFileCount(); fileIndex++) {
+    contents.push_back(utility::decodeFromUtf8(codebase.createCxxSource(fileIndex)));
+    byteCount += static_cast<int64_t>(contents.back().size());
+  }
+
+  for(auto _ : state) {
+    FullTextSearchIndex index;
+    for(size_t fileIndex = 0; fileIndex < contents.size(); fileIndex++) {
+      index.addFile(static_cast<Id>(fileIndex + 1), contents[fileIndex]);
+    }
+    benchmark::DoNotOptimize(index.fileCount());
+  }
+
+  state.SetBytesProcessed(state.iterations() * byteCount);
+}
+BENCHMARK(FullTextSearchIndexAddFile)->ArgName("classes")->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+void FullTextSearchIndexSearchForTerm(benchmark::State& state) {
+  const SyntheticCodebase codebase = createCodebase(static_cast<size_t>(state.range(0)));
+
+  FullTextSearchIndex index;
+  for(size_t fileIndex = 0; fileIndex < codebase.getFileCount(); fileIndex++) {
+    index.addFile(static_cast<Id>(fileIndex + 1), utility::decodeFromUtf8(codebase.createCxxSource(fileIndex)));
+  }
+
+  size_t positionCount = 0;
+  for(auto _ : state) {
+    positionCount = 0;
+    for(const FullTextSearchResult& result : index.searchForTerm(L"().m3();")) {
+      positionCount += result.positions.size();
+    }
+  }
+
+  state.counters["matches"] = static_cast<double>(positionCount);
+}
+BENCHMARK(FullTextSearchIndexSearchForTerm)->ArgName("classes")->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
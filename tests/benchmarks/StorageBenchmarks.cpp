@@ -0,0 +1,170 @@
+// STL
+#include <filesystem>
+#include <memory>
+#include <vector>
+// benchmark
+#include <benchmark/benchmark.h>
+// internal
+#include "Graph.h"
+#include "IntermediateStorage.h"
+#include "PersistentStorage.h"
+#include "SyntheticCodebase.h"
+
+namespace {
+constexpr size_t ClassesPerFile = 20;
+constexpr size_t MethodsPerClass = 8;
+constexpr size_t CallsPerMethod = 4;
+
+std::vector<std::shared_ptr<IntermediateStorage>> createTranslationUnits(const SyntheticCodebase& codebase) {
+  std::vector<std::shared_ptr<IntermediateStorage>> translationUnits;
+  for(size_t fileIndex = 0; fileIndex < codebase.getFileCount(); fileIndex++) {
+    translationUnits.push_back(codebase.createIntermediateStorage(fileIndex));
+  }
+  return translationUnits;
+}
+
+// database files in the temp directory, removed again when going out of scope
+class TemporaryDatabase {
+public:
+  TemporaryDatabase() : m_directory(std::filesystem::temp_directory_path() / "sourcetrail_benchmarks") {
+    std::filesystem::remove_all(m_directory);
+    std::filesystem::create_directories(m_directory);
+  }
+
+  ~TemporaryDatabase() {
+    std::error_code error;
+    std::filesystem::remove_all(m_directory, error);
+  }
+
+  TemporaryDatabase(const TemporaryDatabase&) = delete;
+  TemporaryDatabase& operator=(const TemporaryDatabase&) = delete;
+
+  [[nodiscard]] FilePath getIndexDbFilePath() const {
+    return FilePath((m_directory / "benchmark.srctrldb").wstring());
+  }
+
+  [[nodiscard]] FilePath getBookmarkDbFilePath() const {
+    return FilePath((m_directory / "benchmark.srctrlbm").wstring());
+  }
+
+private:
+  const std::filesystem::path m_directory;
+};
+
+std::shared_ptr<PersistentStorage> createStorage(const TemporaryDatabase& database, SqliteStorage::StorageProfileType profile) {
+  std::shared_ptr<PersistentStorage> storage = std::make_shared<PersistentStorage>(database.getIndexDbFilePath(),
+                                                                                   database.getBookmarkDbFilePath());
+  storage->setup();
+  storage->setMode(SqliteIndexStorage::STORAGE_MODE_WRITE);
+  storage->setProfile(profile);
+  return storage;
+}
+
+// same steps as TaskFinishParsing before the storage is browsed
+void finishStorage(PersistentStorage& storage) {
+  storage.setMode(SqliteIndexStorage::STORAGE_MODE_READ);
+  storage.setProfile(SqliteStorage::STORAGE_PROFILE_DEFAULT);
+}
+
+std::shared_ptr<PersistentStorage> createIndexedStorage(const TemporaryDatabase& database, const SyntheticCodebase& codebase) {
+  std::shared_ptr<PersistentStorage> storage = createStorage(database, SqliteStorage::STORAGE_PROFILE_BULK_WAL);
+  for(const std::shared_ptr<IntermediateStorage>& translationUnit : createTranslationUnits(codebase)) {
+    storage->inject(translationUnit.get());
+  }
+  finishStorage(*storage);
+  storage->buildCaches();
+  return storage;
+}
+
+const char* getProfileName(SqliteStorage::StorageProfileType profile) {
+  switch(profile) {
+  case SqliteStorage::STORAGE_PROFILE_DEFAULT:
+    return "default";
+  case SqliteStorage::STORAGE_PROFILE_BULK_WAL:
+    return "bulk_wal";
+  case SqliteStorage::STORAGE_PROFILE_BULK_UNSAFE:
+    return "bulk_unsafe";
+  }
+  return "";
+}
+}    // namespace
+
+// merging the storages of translation units like TaskMergeStorages does
+void IntermediateStorageInject(benchmark::State& state) {
+  const SyntheticCodebase codebase(static_cast<size_t>(state.range(0)), ClassesPerFile, MethodsPerClass, CallsPerMethod);
+  const std::vector<std::shared_ptr<IntermediateStorage>> translationUnits = createTranslationUnits(codebase);
+
+  for(auto _ : state) {
+    IntermediateStorage target;
+    for(const std::shared_ptr<IntermediateStorage>& translationUnit : translationUnits) {
+      target.inject(translationUnit.get());
+    }
+    benchmark::DoNotOptimize(target.getSourceLocationCount());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(IntermediateStorageInject)->ArgName("files")->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+// batch inserts into the index database under each storage profile, including switching back to the default profile
+void PersistentStorageInject(benchmark::State& state) {
+  const auto profile = static_cast<SqliteStorage::StorageProfileType>(state.range(0));
+  const SyntheticCodebase codebase(static_cast<size_t>(state.range(1)), ClassesPerFile, MethodsPerClass, CallsPerMethod);
+  const std::vector<std::shared_ptr<IntermediateStorage>> translationUnits = createTranslationUnits(codebase);
+
+  for(auto _ : state) {
+    state.PauseTiming();
+    auto database = std::make_unique<TemporaryDatabase>();
+    std::shared_ptr<PersistentStorage> storage = createStorage(*database, profile);
+    state.ResumeTiming();
+
+    for(const std::shared_ptr<IntermediateStorage>& translationUnit : translationUnits) {
+      storage->inject(translationUnit.get());
+    }
+    finishStorage(*storage);
+
+    state.PauseTiming();
+    storage.reset();
+    database.reset();
+    state.ResumeTiming();
+  }
+
+  state.SetLabel(getProfileName(profile));
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(PersistentStorageInject)
+    ->ArgNames({"profile", "files"})
+    ->ArgsProduct({{SqliteStorage::STORAGE_PROFILE_DEFAULT,
+                    SqliteStorage::STORAGE_PROFILE_BULK_WAL,
+                    SqliteStorage::STORAGE_PROFILE_BULK_UNSAFE},
+                   {10, 50}})
+    ->Unit(benchmark::kMillisecond);
+
+void PersistentStorageBuildCaches(benchmark::State& state) {
+  const SyntheticCodebase codebase(static_cast<size_t>(state.range(0)), ClassesPerFile, MethodsPerClass, CallsPerMethod);
+  const TemporaryDatabase database;
+  const std::shared_ptr<PersistentStorage> storage = createIndexedStorage(database, codebase);
+
+  for(auto _ : state) {
+    storage->buildCaches();
+  }
+}
+BENCHMARK(PersistentStorageBuildCaches)->ArgName("files")->Arg(10)->Arg(100)->Unit(benchmark::kMillisecond);
+
+// call trail of the first method, depth 0 follows the calls through the whole code base
+void PersistentStorageGraphForTrail(benchmark::State& state) {
+  const SyntheticCodebase codebase(20, ClassesPerFile, MethodsPerClass, CallsPerMethod);
+  const TemporaryDatabase database;
+  const std::shared_ptr<PersistentStorage> storage = createIndexedStorage(database, codebase);
+  const Id originId = storage->getNodeIdForNameHierarchy(codebase.getMethodName(0, 0));
+
+  size_t nodeCount = 0;
+  for(auto _ : state) {
+    const std::shared_ptr<Graph> graph = storage->getGraphForTrail(
+        originId, 0, NODE_METHOD | NODE_FUNCTION, Edge::EDGE_CALL, true, static_cast<size_t>(state.range(0)), true);
+    nodeCount = graph->getNodeCount();
+  }
+
+  state.counters["nodes"] = static_cast<double>(nodeCount);
+}
+BENCHMARK(PersistentStorageGraphForTrail)->ArgName("depth")->Arg(2)->Arg(5)->Arg(0)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,166 @@
+#include "SyntheticCodebase.h"
+// STL
+#include <algorithm>
+#include <sstream>
+// internal
+#include "IntermediateStorage.h"
+#include "ParseLocation.h"
+#include "ParserClientImpl.h"
+
+namespace {
+std::string getClassIdentifier(size_t classIndex) {
+  return "C" + std::to_string(classIndex);
+}
+
+std::string getMethodIdentifier(size_t methodIndex) {
+  return "m" + std::to_string(methodIndex);
+}
+}    // namespace
+
+SyntheticCodebase::SyntheticCodebase(size_t fileCount, size_t classesPerFile, size_t methodsPerClass, size_t callsPerMethod)
+    : m_fileCount(std::max<size_t>(fileCount, 1))
+    , m_classesPerFile(std::max<size_t>(classesPerFile, 1))
+    , m_methodsPerClass(std::max<size_t>(methodsPerClass, 1))
+    , m_callsPerMethod(callsPerMethod) {}
+
+size_t SyntheticCodebase::getFileCount() const {
+  return m_fileCount;
+}
+
+size_t SyntheticCodebase::getClassCount() const {
+  return m_fileCount * m_classesPerFile;
+}
+
+size_t SyntheticCodebase::getMethodCount() const {
+  return getClassCount() * m_methodsPerClass;
+}
+
+FilePath SyntheticCodebase::getFilePath(size_t fileIndex) const {
+  return FilePath(L"/synthetic/file" + std::to_wstring(fileIndex) + L".cpp");
+}
+
+NameHierarchy SyntheticCodebase::getClassName(size_t classIndex) const {
+  NameHierarchy name(NAME_DELIMITER_CXX);
+  name.push(L"synthetic");
+  name.push(L"C" + std::to_wstring(classIndex));
+  return name;
+}
+
+NameHierarchy SyntheticCodebase::getMethodName(size_t classIndex, size_t methodIndex) const {
+  NameHierarchy name = getClassName(classIndex);
+  name.push(NameElement(L"m" + std::to_wstring(methodIndex), L"void", L"()"));
+  return name;
+}
+
+std::vector<std::wstring> SyntheticCodebase::getSymbolNames() const {
+  std::vector<std::wstring> names;
+  names.reserve(getClassCount() + getMethodCount());
+  for(size_t classIndex = 0; classIndex < getClassCount(); classIndex++) {
+    names.push_back(getClassName(classIndex).getQualifiedName());
+    for(size_t methodIndex = 0; methodIndex < m_methodsPerClass; methodIndex++) {
+      names.push_back(getMethodName(classIndex, methodIndex).getQualifiedName());
+    }
+  }
+  return names;
+}
+
+std::shared_ptr<IntermediateStorage> SyntheticCodebase::createIntermediateStorage(size_t fileIndex) const {
+  std::shared_ptr<IntermediateStorage> storage = std::make_shared<IntermediateStorage>();
+  ParserClientImpl client(storage.get());
+
+  const Id fileId = client.recordFile(getFilePath(fileIndex), true);
+  client.recordFileLanguage(fileId, L"cpp");
+
+  // locations follow the layout of createCxxSource roughly, one line per declaration and call
+  size_t line = 1;
+  const size_t firstClassIndex = fileIndex * m_classesPerFile;
+  for(size_t classIndex = firstClassIndex; classIndex < firstClassIndex + m_classesPerFile; classIndex++) {
+    const Id classId = client.recordSymbol(getClassName(classIndex));
+    client.recordSymbolKind(classId, SYMBOL_CLASS);
+    client.recordDefinitionKind(classId, DEFINITION_EXPLICIT);
+    client.recordLocation(classId, ParseLocation(fileId, line, 7, line, 10), ParseLocationType::TOKEN);
+
+    const size_t classStartLine = line;
+    for(size_t methodIndex = 0; methodIndex < m_methodsPerClass; methodIndex++) {
+      line++;
+
+      const Id methodId = client.recordSymbol(getMethodName(classIndex, methodIndex));
+      client.recordSymbolKind(methodId, SYMBOL_METHOD);
+      client.recordDefinitionKind(methodId, DEFINITION_EXPLICIT);
+      client.recordLocation(methodId, ParseLocation(fileId, line, 8, line, 10), ParseLocationType::TOKEN);
+
+      const size_t methodStartLine = line;
+      size_t column = 5;
+      for(const Call& call : getCalls(classIndex, methodIndex)) {
+        line++;
+
+        const Id calleeId = client.recordSymbol(getMethodName(call.classIndex, call.methodIndex));
+        client.recordSymbolKind(calleeId, SYMBOL_METHOD);
+        client.recordReference(REFERENCE_CALL, calleeId, methodId, ParseLocation(fileId, line, column, line, column + 2));
+        column++;
+      }
+      client.recordLocation(methodId, ParseLocation(fileId, methodStartLine, 1, line + 1, 1), ParseLocationType::SCOPE);
+      line++;
+    }
+    client.recordLocation(classId, ParseLocation(fileId, classStartLine, 1, line + 1, 2), ParseLocationType::SCOPE);
+    line += 2;
+  }
+
+  return storage;
+}
+
+std::string SyntheticCodebase::createCxxSource(size_t fileIndex) const {
+  std::stringstream source;
+  source << "namespace synthetic {\n";
+
+  const size_t firstClassIndex = fileIndex * m_classesPerFile;
+  const size_t firstCalledClassIndex = ((fileIndex + 1) % m_fileCount) * m_classesPerFile;
+
+  std::vector<size_t> declaredClassIndices;
+  for(size_t i = 0; i < m_classesPerFile; i++) {
+    declaredClassIndices.push_back(firstClassIndex + i);
+  }
+  if(firstCalledClassIndex != firstClassIndex) {
+    for(size_t i = 0; i < m_classesPerFile; i++) {
+      declaredClassIndices.push_back(firstCalledClassIndex + i);
+    }
+  }
+
+  for(const size_t classIndex : declaredClassIndices) {
+    source << "class " << getClassIdentifier(classIndex) << " {\npublic:\n";
+    for(size_t methodIndex = 0; methodIndex < m_methodsPerClass; methodIndex++) {
+      source << "  void " << getMethodIdentifier(methodIndex) << "();\n";
+    }
+    source << "};\n";
+  }
+
+  for(size_t classIndex = firstClassIndex; classIndex < firstClassIndex + m_classesPerFile; classIndex++) {
+    for(size_t methodIndex = 0; methodIndex < m_methodsPerClass; methodIndex++) {
+      source << "void " << getClassIdentifier(classIndex) << "::" << getMethodIdentifier(methodIndex) << "() {\n";
+      for(const Call& call : getCalls(classIndex, methodIndex)) {
+        source << "  " << getClassIdentifier(call.classIndex) << "()." << getMethodIdentifier(call.methodIndex) << "();\n";
+      }
+      source << "}\n";
+    }
+  }
+
+  source << "}    // namespace synthetic\n";
+  return source.str();
+}
+
+std::vector<SyntheticCodebase::Call> SyntheticCodebase::getCalls(size_t classIndex, size_t methodIndex) const {
+  const size_t fileIndex = classIndex / m_classesPerFile;
+  const size_t localClassIndex = classIndex % m_classesPerFile;
+
+  std::vector<Call> calls;
+  for(size_t callIndex = 0; callIndex < m_callsPerMethod; callIndex++) {
+    if(callIndex == 0) {
+      const size_t nextFileIndex = (fileIndex + 1) % m_fileCount;
+      calls.push_back({nextFileIndex * m_classesPerFile + (localClassIndex + methodIndex) % m_classesPerFile, methodIndex});
+    } else {
+      const size_t calleeClassIndex = (localClassIndex + callIndex * 7 + methodIndex * 3 + 1) % m_classesPerFile;
+      calls.push_back({fileIndex * m_classesPerFile + calleeClassIndex, (methodIndex + callIndex) % m_methodsPerClass});
+    }
+  }
+  return calls;
+}
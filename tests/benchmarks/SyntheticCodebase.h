@@ -0,0 +1,50 @@
+#pragma once
+// STL
+#include <memory>
+#include <string>
+#include <vector>
+// internal
+#include "FilePath.h"
+#include "NameHierarchy.h"
+
+class IntermediateStorage;
+
+/**
+ * Deterministic code base of classes with methods calling each other, so benchmark runs stay comparable. Every file
+ * defines its own classes, the first call of every method goes to a class of the next file and all others stay within
+ * the file, which keeps the call graph connected across files.
+ */
+class SyntheticCodebase {
+public:
+  SyntheticCodebase(size_t fileCount, size_t classesPerFile, size_t methodsPerClass, size_t callsPerMethod);
+
+  [[nodiscard]] size_t getFileCount() const;
+  [[nodiscard]] size_t getClassCount() const;
+  [[nodiscard]] size_t getMethodCount() const;
+
+  [[nodiscard]] FilePath getFilePath(size_t fileIndex) const;
+  [[nodiscard]] NameHierarchy getClassName(size_t classIndex) const;
+  [[nodiscard]] NameHierarchy getMethodName(size_t classIndex, size_t methodIndex) const;
+
+  // qualified names of all classes and methods
+  [[nodiscard]] std::vector<std::wstring> getSymbolNames() const;
+
+  // the symbols of one file as an indexer would record them for its translation unit
+  [[nodiscard]] std::shared_ptr<IntermediateStorage> createIntermediateStorage(size_t fileIndex) const;
+
+  // compilable source of the file, declares the classes of the next file that it calls
+  [[nodiscard]] std::string createCxxSource(size_t fileIndex) const;
+
+private:
+  struct Call {
+    size_t classIndex;
+    size_t methodIndex;
+  };
+
+  [[nodiscard]] std::vector<Call> getCalls(size_t classIndex, size_t methodIndex) const;
+
+  const size_t m_fileCount;
+  const size_t m_classesPerFile;
+  const size_t m_methodsPerClass;
+  const size_t m_callsPerMethod;
+};
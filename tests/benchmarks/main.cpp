@@ -0,0 +1,26 @@
+// STL
+#include <memory>
+// benchmark
+#include <benchmark/benchmark.h>
+// spdlog
+#include <spdlog/spdlog.h>
+// internal
+#include "ApplicationSettings.h"
+#include "IApplicationSettings.hpp"
+
+int main(int argc, char* argv[]) {
+  spdlog::default_logger_raw()->set_level(spdlog::level::off);
+
+  // the storages read the text encoding and tab width from the application settings
+  IApplicationSettings::setInstance(std::make_shared<ApplicationSettings>());
+
+  benchmark::Initialize(&argc, argv);
+  if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  IApplicationSettings::setInstance(nullptr);
+  return 0;
+}